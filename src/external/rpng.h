@@ -10,7 +10,7 @@
 *       - Add custom chunks
 *
 *   LIMITATIONS:
-*       - No indexed color type supported (PLTE)
+*       - Indexed color type (PLTE) only supported for saving, not loading
 *       - No grayscale color type with 1/2/4 bits (1 channel), only 8/16 bits
 *
 *   POSSIBLE IMPROVEMENTS:
@@ -29,6 +29,10 @@
 *       #define RPNG_NO_STDIO
 *           Do not include FILE I/O API, only read/write from memory buffers
 *
+*       #define RPNG_NO_SIMD
+*           Do not use SIMD instructions (SSE2, NEON) for scanlines filtering on image saving,
+*           SIMD is used by default if available on target architecture, scalar code otherwise
+*
 *
 *   DEPENDENCIES: libc (C standard library)
 *       stdlib.h        Required for: malloc(), calloc(), free()
@@ -89,6 +93,16 @@
 *       Comment          Miscellaneous comment; conversion from GIF comment
 *
 *   VERSIONS HISTORY:
+*       1.2 (14-Oct-2026) ADDED: SSE2 and NEON scanlines filtering on rpng_save_image_to_memory()
+*                         REVIEWED: Filter heuristic sums reset for every scanline
+*                         ADDED: rpng_save_image_to_memory_ex(), filter type and compression level
+*                         ADDED: rpng_chunk_find_from_memory(), no chunk data copy
+*                         ADDED: rpng_encoder, reusable encoding work buffers
+*                         ADDED: rpng_save_image_to_memory_chunks(), extra chunks written on encoding
+*                         ADDED: rpng_save_image_indexed_to_memory_chunks(), indexed color (PLTE + tRNS)
+*                         REVIEWED: rpng_save_image_indexed(), implemented, bit depth from palette size
+*                         ADDED: RPNG_FILTER_BRUTE, filter per scanline from trial compression
+*                         ADDED: RPNG_COMPRESSION_OPTIMAL, sdefl iterative optimal parsing
 *       1.1 (29-May-2023) UPDATED: sdefl and sinfl, fixed issue
 *       1.0 (24-Dec-2021) ADDED: rpng_load_image()
 *                         ADDED: RPNG_LOG() macro
@@ -123,7 +137,7 @@
 #ifndef RPNG_H
 #define RPNG_H
 
-#define RPNG_VERSION    "1.1"
+#define RPNG_VERSION    "1.2"
 
 // Function specifiers in case library is build/used as a shared library (Windows)
 // NOTE: Microsoft specifiers to tell compiler that symbols are imported/exported from a .dll
@@ -175,6 +189,26 @@
     // buffer is scaled to required output file size before being returned
     #define RPNG_MAX_OUTPUT_SIZE    (32*1024*1024)
 #endif
+#ifndef RPNG_FILTER_BRUTE_WINDOW
+    // Previous filtered data size compressed with every scanline candidate on brute force filter selection
+    #define RPNG_FILTER_BRUTE_WINDOW    (4*1024)
+#endif
+
+// Scanlines filter type for image saving (rpng_save_image_to_memory_ex())
+// REF: https://www.w3.org/TR/PNG/#9Filters
+#define RPNG_FILTER_NONE            0   // No filter
+#define RPNG_FILTER_SUB             1   // Difference with left pixel
+#define RPNG_FILTER_UP              2   // Difference with above pixel
+#define RPNG_FILTER_AVERAGE         3   // Difference with left and above pixels average
+#define RPNG_FILTER_PAETH           4   // Difference with Paeth predictor (left, above, upper left)
+#define RPNG_FILTER_ADAPTIVE        5   // Best filter per scanline (minimum sum of absolute differences)
+#define RPNG_FILTER_BRUTE           6   // Best filter per scanline (smallest deflate size with previous scanlines), slowest
+
+// Compression levels for image saving (deflate)
+#define RPNG_COMPRESSION_MIN        0   // Fastest compression
+#define RPNG_COMPRESSION_DEFAULT    8   // Best compression, same as stbiw
+#define RPNG_COMPRESSION_MAX        8
+#define RPNG_COMPRESSION_OPTIMAL    9   // Iterative optimal parsing deflate, smallest output (slowest)
 
 //----------------------------------------------------------------------------------
 // Types and Structures Definition
@@ -191,6 +225,18 @@ typedef struct {
     unsigned int crc;       // 32bit CRC (computed over type and data)
 } rpng_chunk;
 
+// PNG encoder work buffers, reusable between multiple images encoding
+// NOTE: Buffers grow as required, they are only freed by rpng_encoder_unload()
+typedef struct rpng_encoder {
+    unsigned char *data_filtered;   // Filtered image data buffer (filter byte + scanline, per scanline)
+    int data_filtered_size;         // Filtered image data buffer size
+    unsigned char *scanlines;       // Scanlines filtering buffer (five filtered scanlines + zeroed scanline)
+    int scanlines_size;             // Scanlines filtering buffer size
+    unsigned char *comp_data;       // Compressed data buffer
+    int comp_data_size;             // Compressed data buffer size
+    void *deflate_state;            // Deflate compressor state (struct sdefl)
+} rpng_encoder;
+
 // A minimal PNG only requires: png_signature | rpng_chunk(IHDR) | rpng_chunk(IDAT) | rpng_chunk(IEND)
 
 #ifdef __cplusplus
@@ -250,10 +296,16 @@ RPNGAPI void rpng_chunk_split_image_data(const char *filename, int split_size);
 // Load and save png data from memory buffer
 RPNGAPI char *rpng_load_image_from_memory(const char *buffer, int *width, int *height, int *color_channels, int *bit_depth);  // Load png data from memory buffer
 RPNGAPI char *rpng_save_image_to_memory(const char *data, int width, int height, int color_channels, int bit_depth, int *output_size); // Save png data to memory buffer
+RPNGAPI char *rpng_save_image_to_memory_ex(const char *data, int width, int height, int color_channels, int bit_depth, int filter, int comp_level, int *output_size); // Save png data to memory buffer, filter and compression level
+RPNGAPI char *rpng_save_image_to_memory_encoder(rpng_encoder *encoder, const char *data, int width, int height, int color_channels, int bit_depth, int filter, int comp_level, int *output_size); // Save png data to memory buffer, reusing encoder work buffers
+RPNGAPI char *rpng_save_image_to_memory_chunks(rpng_encoder *encoder, const char *data, int width, int height, int color_channels, int bit_depth, int filter, int comp_level, const rpng_chunk *chunks, int chunk_count, int *output_size); // Save png data to memory buffer, writing extra chunks after IHDR
+RPNGAPI char *rpng_save_image_indexed_to_memory_chunks(rpng_encoder *encoder, const char *data, int width, int height, const char *palette, const char *palette_alpha, int palette_size, int filter, int comp_level, const rpng_chunk *chunks, int chunk_count, int *output_size); // Save indexed png data to memory buffer (PLTE + tRNS), writing extra chunks after them
+RPNGAPI void rpng_encoder_unload(rpng_encoder *encoder);   // Unload encoder work buffers
 
 // Read and write chunks from memory buffer
 RPNGAPI int rpng_chunk_count_from_memory(const char *buffer);                                               // Count the chunks in a PNG image from memory
 RPNGAPI rpng_chunk rpng_chunk_read_from_memory(const char *buffer, const char *chunk_type);                 // Read one chunk type from memory
+RPNGAPI rpng_chunk rpng_chunk_find_from_memory(const char *buffer, int buffer_size, const char *chunk_type); // Find one chunk type from memory, chunk data points to buffer (not copied)
 RPNGAPI rpng_chunk *rpng_chunk_read_all_from_memory(const char *buffer, int *count);                        // Read all chunks from memory
 RPNGAPI char *rpng_chunk_remove_from_memory(const char *buffer, const char *chunk_type, int *output_size);  // Remove one chunk type from memory
 RPNGAPI char *rpng_chunk_remove_ancillary_from_memory(const char *buffer, int *output_size);                // Remove all chunks except: IHDR-IDAT-IEND
@@ -288,6 +340,18 @@ RPNGAPI char *rpng_chunk_split_image_data_from_memory(char *buffer, int split_si
     #include <unistd.h>     // Required for: access() (POSIX, not C standard) [file_exists()]
 #endif
 
+// SIMD instructions set detection for scanlines filtering
+// NOTE: SSE2 is always available on x86_64, NEON on arm64
+#if !defined(RPNG_NO_SIMD)
+    #if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+        #define RPNG_SIMD_SSE2
+        #include <emmintrin.h>  // Required for: SSE2 intrinsics
+    #elif defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+        #define RPNG_SIMD_NEON
+        #include <arm_neon.h>   // Required for: NEON intrinsics
+    #endif
+#endif
+
 //----------------------------------------------------------------------------------
 // Types and Structures Definition
 //----------------------------------------------------------------------------------
@@ -423,12 +487,14 @@ typedef struct {
 //----------------------------------------------------------------------------------
 // Global Variables Definition
 //----------------------------------------------------------------------------------
-const unsigned char png_signature[8] = { 0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a }; // PNG Signature
+static const unsigned char png_signature[8] = { 0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a }; // PNG Signature
 
 //----------------------------------------------------------------------------------
 // Module specific Functions Declaration
 //----------------------------------------------------------------------------------
 static unsigned int swap_endian(unsigned int value);                // Swap integer from big<->little endian
+static void *rpng_encoder_reserve(unsigned char **buffer, int *buffer_size, int required_size);  // Reserve encoder work buffer size (contents not kept)
+static char *rpng_save_scanlines_to_memory(rpng_encoder *encoder, const unsigned char *data, int width, int height, int color_type, int bit_depth, int pixel_size, int scanline_size, int filter, int comp_level, const rpng_chunk *chunks, int chunk_count, int *output_size);  // Save png data from packed scanlines
 static unsigned int compute_crc32(unsigned char *buffer, int size); // Compute CRC32
 
 // Load/save png file data from/to memory buffer
@@ -436,6 +502,11 @@ static char *load_file_to_buffer(const char *filename, int *bytes_read);
 static void save_file_from_buffer(const char *filename, void *data, int bytesToWrite);
 static bool file_exists(const char *filename);                      // Check if the file exists
 
+// Scanlines filtering, filtered scanlines for the five filters are computed at once
+static void rpng_filter_scanline(const unsigned char *row, const unsigned char *prev, int size, int pixel_size, unsigned char *filtered, unsigned int *sums);
+static void rpng_filter_scanline_range(const unsigned char *row, const unsigned char *prev, int start, int end, int size, int pixel_size, unsigned char *filtered, unsigned int *sums);
+static void rpng_filter_scanline_fixed(const unsigned char *row, const unsigned char *prev, int size, int pixel_size, int filter, unsigned char *filtered);
+
 // sdelf and sinfl implementations placed at the end of file
 #define SDEFL_IMPLEMENTATION
 #define SINFL_IMPLEMENTATION
@@ -463,6 +534,7 @@ static bool file_exists(const char *filename);                      // Check if
 #define SDEFL_LVL_MIN   0
 #define SDEFL_LVL_DEF   5
 #define SDEFL_LVL_MAX   8
+#define SDEFL_LVL_OPT   9   /* iterative optimal parsing (slowest) */
 
 struct sdefl_freq {
   unsigned lit[SDEFL_SYM_MAX];
@@ -582,9 +654,17 @@ void rpng_save_image(const char *filename, const char *data, int width, int heig
 //  - Palette max number of entries is limited to [1..256] colors
 void rpng_save_image_indexed(const char *filename, const char *data, int width, int height, const char *palette, const char *palette_alpha, int palette_size)
 {
-    // TODO: Support PLTE + tRNS
+    rpng_encoder encoder = { 0 };
+    int file_output_size = 0;
 
     // Indexed color data uses image prefilter 0 by default
+    char *file_output = rpng_save_image_indexed_to_memory_chunks(&encoder, data, width, height, palette, palette_alpha, palette_size, RPNG_FILTER_NONE, RPNG_COMPRESSION_DEFAULT, NULL, 0, &file_output_size);
+
+    if ((file_output != NULL) && (file_output_size > 0)) save_file_from_buffer(filename, file_output, file_output_size);
+    else RPNG_LOG("WARNING: PNG data saving failed");
+
+    RPNG_FREE(file_output);
+    rpng_encoder_unload(&encoder);
 }
 
 // Count number of PNG chunks
@@ -1238,10 +1318,39 @@ char *rpng_load_image_from_memory(const char *buffer, int *width, int *height, i
 // Save png data to memory buffer
 char *rpng_save_image_to_memory(const char *data, int width, int height, int color_channels, int bit_depth, int *output_size)
 {
-    char *output_buffer = NULL;
-    int output_buffer_size = 0;
+    return rpng_save_image_to_memory_ex(data, width, height, color_channels, bit_depth, RPNG_FILTER_ADAPTIVE, RPNG_COMPRESSION_DEFAULT, output_size);
+}
 
-    if ((bit_depth != 8) && (bit_depth != 16)) return output_buffer;  // Bit depth 1/2/4 not supported
+// Save png data to memory buffer, scanlines filter and compression level can be defined
+//  - Filter: RPNG_FILTER_NONE..RPNG_FILTER_PAETH (same filter for all scanlines), RPNG_FILTER_ADAPTIVE or RPNG_FILTER_BRUTE
+//  - Compression level: RPNG_COMPRESSION_MIN (0) to RPNG_COMPRESSION_MAX (8), or RPNG_COMPRESSION_OPTIMAL (9)
+char *rpng_save_image_to_memory_ex(const char *data, int width, int height, int color_channels, int bit_depth, int filter, int comp_level, int *output_size)
+{
+    rpng_encoder encoder = { 0 };
+
+    char *output_buffer = rpng_save_image_to_memory_encoder(&encoder, data, width, height, color_channels, bit_depth, filter, comp_level, output_size);
+
+    rpng_encoder_unload(&encoder);
+
+    return output_buffer;
+}
+
+// Save png data to memory buffer, reusing encoder work buffers
+// NOTE: Work buffers are allocated (or grown) if required, they are kept for next images,
+// only output buffer is allocated on every call (must be freed by user)
+char *rpng_save_image_to_memory_encoder(rpng_encoder *encoder, const char *data, int width, int height, int color_channels, int bit_depth, int filter, int comp_level, int *output_size)
+{
+    return rpng_save_image_to_memory_chunks(encoder, data, width, height, color_channels, bit_depth, filter, comp_level, NULL, 0, output_size);
+}
+
+// Save png data to memory buffer, writing extra chunks (any kind) after IHDR
+// NOTE: Chunks are written while output buffer is assembled, no extra copy of the image is required,
+// chunk length, type and data must be provided, CRC32 is computed internally
+char *rpng_save_image_to_memory_chunks(rpng_encoder *encoder, const char *data, int width, int height, int color_channels, int bit_depth, int filter, int comp_level, const rpng_chunk *chunks, int chunk_count, int *output_size)
+{
+    *output_size = 0;
+
+    if ((bit_depth != 8) && (bit_depth != 16)) return NULL;  // Bit depth 1/2/4 not supported
 
     int color_type = -1;
     if (color_channels == 1) color_type = 0;        // Grayscale
@@ -1249,7 +1358,87 @@ char *rpng_save_image_to_memory(const char *data, int width, int height, int col
     else if (color_channels == 3) color_type = 2;   // RGB
     else if (color_channels == 4) color_type = 6;   // RGBA
 
-    if (color_type == -1) return output_buffer;   // Number of channels not supported
+    if (color_type == -1) return NULL;   // Number of channels not supported
+
+    int pixel_size = color_channels*(bit_depth/8);
+
+    return rpng_save_scanlines_to_memory(encoder, (const unsigned char *)data, width, height, color_type, bit_depth, pixel_size, width*pixel_size, filter, comp_level, chunks, chunk_count, output_size);
+}
+
+// Save indexed png data to memory buffer, writing extra chunks (any kind) after PLTE and tRNS
+//  - Image data must be provided as one palette index per pixel (one byte)
+//  - Palette colours must be provided as R8G8B8, they are saved in PLTE chunk
+//  - Palette alpha should be provided as R8, it is saved in tRNS chunk (if not NULL)
+//  - Palette max number of entries is limited to [1..256] colors
+// NOTE: Bit depth is chosen from palette size (1/2/4/8 bit), indices are packed into scanlines,
+// tRNS chunk only stores alpha values up to last non-opaque entry (place transparent entries first)
+char *rpng_save_image_indexed_to_memory_chunks(rpng_encoder *encoder, const char *data, int width, int height, const char *palette, const char *palette_alpha, int palette_size, int filter, int comp_level, const rpng_chunk *chunks, int chunk_count, int *output_size)
+{
+    *output_size = 0;
+
+    if ((data == NULL) || (palette == NULL) || (palette_size < 1) || (palette_size > 256)) return NULL;
+
+    int bit_depth = 8;
+    if (palette_size <= 2) bit_depth = 1;
+    else if (palette_size <= 4) bit_depth = 2;
+    else if (palette_size <= 16) bit_depth = 4;
+
+    // Pack palette indices into scanlines (MSB first)
+    int scanline_size = (width*bit_depth + 7)/8;
+    unsigned char *packed = (unsigned char *)RPNG_CALLOC(scanline_size*height, 1);
+
+    for (int y = 0; y < height; y++)
+    {
+        const unsigned char *src = (const unsigned char *)data + y*width;
+        unsigned char *dst = packed + y*scanline_size;
+
+        if (bit_depth == 8) memcpy(dst, src, width);
+        else for (int x = 0; x < width; x++) dst[(x*bit_depth)/8] |= (src[x] & ((1 << bit_depth) - 1)) << (8 - bit_depth - (x*bit_depth)%8);
+    }
+
+    // Palette chunks (PLTE + tRNS) are written before provided chunks
+    rpng_chunk *all_chunks = (rpng_chunk *)RPNG_CALLOC(chunk_count + 2, sizeof(rpng_chunk));
+    int all_chunks_count = 0;
+
+    all_chunks[0].length = palette_size*3;
+    memcpy(all_chunks[0].type, "PLTE", 4);
+    all_chunks[0].data = (unsigned char *)palette;
+    all_chunks_count++;
+
+    if (palette_alpha != NULL)
+    {
+        int alpha_count = palette_size;
+        while ((alpha_count > 0) && ((unsigned char)palette_alpha[alpha_count - 1] == 255)) alpha_count--;
+
+        if (alpha_count > 0)
+        {
+            all_chunks[1].length = alpha_count;
+            memcpy(all_chunks[1].type, "tRNS", 4);
+            all_chunks[1].data = (unsigned char *)palette_alpha;
+            all_chunks_count++;
+        }
+    }
+
+    for (int i = 0; i < chunk_count; i++) all_chunks[all_chunks_count + i] = chunks[i];
+
+    char *output_buffer = rpng_save_scanlines_to_memory(encoder, packed, width, height, 3, bit_depth, 1, scanline_size, filter, comp_level, all_chunks, all_chunks_count + chunk_count, output_size);
+
+    RPNG_FREE(all_chunks);
+    RPNG_FREE(packed);
+
+    return output_buffer;
+}
+
+// Save png data to memory buffer from scanlines data (already packed for bit depth)
+// NOTE: Pixel size (bytes) is only used by scanlines filters, 1 for bit depths lower than 8
+static char *rpng_save_scanlines_to_memory(rpng_encoder *encoder, const unsigned char *data, int width, int height, int color_type, int bit_depth, int pixel_size, int scanline_size, int filter, int comp_level, const rpng_chunk *chunks, int chunk_count, int *output_size)
+{
+    char *output_buffer = NULL;
+    int output_buffer_size = 0;
+
+    if ((filter < RPNG_FILTER_NONE) || (filter > RPNG_FILTER_BRUTE)) filter = RPNG_FILTER_ADAPTIVE;
+    if (comp_level < RPNG_COMPRESSION_MIN) comp_level = RPNG_COMPRESSION_MIN;
+    else if (comp_level > RPNG_COMPRESSION_OPTIMAL) comp_level = RPNG_COMPRESSION_OPTIMAL;
 
     rpng_chunk_IHDR image_info = { 0 };
     image_info.width = swap_endian(width);
@@ -1258,102 +1447,97 @@ char *rpng_save_image_to_memory(const char *data, int width, int height, int col
     image_info.color_type = (unsigned char)color_type;
 
     // Image data pre-processing to append filter type byte to every scanline
-    int pixel_size = color_channels*(bit_depth/8);
-    int scanline_size = width*pixel_size;
     unsigned int data_filtered_size = (scanline_size + 1)*height;   // Adding 1 byte per scanline filter
-    unsigned char *data_filtered = (unsigned char *)RPNG_CALLOC(data_filtered_size, 1);
-
-    int out = 0, x = 0, a = 0, b = 0, c = 0;
-    int sum_value[5] = { 0 };
+    unsigned char *data_filtered = (unsigned char *)rpng_encoder_reserve(&encoder->data_filtered, &encoder->data_filtered_size, data_filtered_size);
+
+    // Scanlines filtering required buffers: five filtered scanlines (one per filter) and a zeroed scanline,
+    // used as previous scanline for the first one (filters consider bytes above the image as 0)
+    unsigned char *scanlines_filtered = (unsigned char *)rpng_encoder_reserve(&encoder->scanlines, &encoder->scanlines_size, scanline_size*6);
+    unsigned char *scanline_zero = scanlines_filtered + scanline_size*5;
+    memset(scanline_zero, 0, scanline_size);
+    unsigned int sum_value[5] = { 0 };
     int best_filter = 0;
 
+    // NOTE: Compressor state and compressed data buffer are also used by brute force filter selection
+    if (encoder->deflate_state == NULL) encoder->deflate_state = RPNG_CALLOC(sizeof(struct sdefl), 1);
+    struct sdefl *sde = (struct sdefl *)encoder->deflate_state;
+    int bounds = sdefl_bound(data_filtered_size);
+    unsigned char *comp_data = (unsigned char *)rpng_encoder_reserve(&encoder->comp_data, &encoder->comp_data_size, bounds);
+
     for (int y = 0; y < height; y++)
     {
+        const unsigned char *row = data + scanline_size*y;
+        const unsigned char *prev = (y > 0)? (row - scanline_size) : scanline_zero;
+
+        if (filter < RPNG_FILTER_ADAPTIVE)
+        {
+            // Same filter for all scanlines, no filter selection required
+            data_filtered[(scanline_size + 1)*y] = filter;
+            rpng_filter_scanline_fixed(row, prev, scanline_size, pixel_size, filter, data_filtered + (scanline_size + 1)*y + 1);
+            continue;
+        }
+
         // Choose the best filter type for every scanline
+        // Heuristic: Compute the output scanline using all five filters,
+        // select the filter that gives the smallest sum of absolute values of outputs
+        // NOTE: Considering the output bytes as signed differences for the test
         // REF: https://www.w3.org/TR/PNG-Encoders.html#E.Filter-selection
-        for (int p = 0; p < scanline_size; p++)
+        rpng_filter_scanline(row, prev, scanline_size, pixel_size, scanlines_filtered, sum_value);
+
+        best_filter = 0;
+        unsigned int best_value = sum_value[0];
+
+        if (filter == RPNG_FILTER_BRUTE)
         {
-            // x = current byte
-            // a = left pixel byte (from current)
-            // b = above pixel byte (from current)
-            // c = left pixel byte (from b)
-            x = (int)((unsigned char *)data)[scanline_size*y + p];
-            a = (p >= pixel_size) ? (int)((unsigned char *)data)[scanline_size*y + p - pixel_size] : 0;
-            b = (y > 0) ? (int)((unsigned char *)data)[scanline_size*(y - 1) + p] : 0;
-            c = (y > 0) ? ((p >= pixel_size) ? (int)((unsigned char *)data)[scanline_size*(y - 1) + p - pixel_size] : 0) : 0;
-
-            // Heuristic: Compute the output scanline using all five filters
-            // REF: https://www.w3.org/TR/PNG/#9Filters
+            // Brute force: Compress every filtered scanline candidate after previous filtered data (window),
+            // select the filter that gives the smallest compressed size, matches with previous scanlines are considered
+            unsigned char *line = data_filtered + (scanline_size + 1)*y;
+            int window = ((line - data_filtered) < RPNG_FILTER_BRUTE_WINDOW)? (int)(line - data_filtered) : RPNG_FILTER_BRUTE_WINDOW;
+            int level = (comp_level > RPNG_COMPRESSION_MAX)? RPNG_COMPRESSION_MAX : comp_level;
+
             for (int filter = 0; filter < 5; filter++)
             {
-                switch(filter)
+                line[0] = filter;
+                memcpy(line + 1, scanlines_filtered + scanline_size*filter, scanline_size);
+                unsigned int size = (unsigned int)sdeflate(sde, comp_data, line - window, window + scanline_size + 1, level);
+
+                if ((filter == 0) || (size < best_value))
                 {
-                    case 0: out = x; break;
-                    case 1: out = x - a; break;
-                    case 2: out = x - b; break;
-                    case 3: out = x - ((a + b)>>1); break;
-                    case 4: out = x - rpng_paeth_predictor(a, b, c); break;
-                    default: break;
+                    best_value = size;
+                    best_filter = filter;
                 }
-
-                sum_value[filter] += abs((signed char)out);
             }
         }
-
-        // Select the filter that gives the smallest sum of absolute values of outputs.
-        // NOTE: Considering the output bytes as signed differences for the test.
-        best_filter = 0;
-        int best_value = sum_value[0];
-
-        for (int filter = 1; filter < 5; filter++)
+        else
         {
-            if (sum_value[filter] < best_value)
+            for (int filter = 1; filter < 5; filter++)
             {
-                best_value = sum_value[filter];
-                best_filter = filter;
+                if (sum_value[filter] < best_value)
+                {
+                    best_value = sum_value[filter];
+                    best_filter = filter;
+                }
             }
         }
 
-        // Register scanline filter byte
+        // Register scanline filter byte and best filtered scanline (already computed)
         data_filtered[(scanline_size + 1)*y] = best_filter;
-
-        // Apply the best_filter to scanline
-        for (int p = 0; p < scanline_size; p++)
-        {
-            x = (int)((unsigned char *)data)[scanline_size*y + p];
-            a = (p >= pixel_size)? (int)((unsigned char *)data)[scanline_size*y + p - pixel_size] : 0;
-            b = (y > 0)? (int)((unsigned char *)data)[scanline_size*(y - 1) + p] : 0;
-            c = (y > 0)? ((p >= pixel_size) ? (int)((unsigned char *)data)[scanline_size*(y - 1) + p - pixel_size] : 0) : 0;
-
-            switch (best_filter)
-            {
-                case 0: out = x; break;
-                case 1: out = x - a; break;
-                case 2: out = x - b; break;
-                case 3: out = x - ((a + b)>>1); break;
-                case 4: out = x - rpng_paeth_predictor(a, b, c); break;
-                default: break;
-            }
-
-            // Register scanline filtered values, byte by byte
-            data_filtered[(scanline_size + 1)*y + 1 + p] = (unsigned char)out;
-        }
+        memcpy(data_filtered + (scanline_size + 1)*y + 1, scanlines_filtered + scanline_size*best_filter, scanline_size);
     }
 
     // Compress filtered image data and generate a valid zlib stream
-    struct sdefl *sde = (struct sdefl*)RPNG_CALLOC(sizeof(struct sdefl), 1);
-    int bounds = sdefl_bound(data_filtered_size);
-    unsigned char *comp_data = (unsigned char *)RPNG_CALLOC(bounds, 1);
-    int comp_data_size = zsdeflate(sde, comp_data, data_filtered, data_filtered_size, 8);   // Compression level 8, same as stbiw
-    RPNG_FREE(data_filtered);
-    RPNG_FREE(sde);
+    // NOTE: Compressor state is reset by compressor on every use (hash table, frequencies and sequences)
+    int comp_data_size = zsdeflate(sde, comp_data, data_filtered, data_filtered_size, comp_level);
 
     RPNG_LOG("INFO: rpng_save_image: data size: %i -> Comp data size: %i\n", data_filtered_size, comp_data_size);
 
     // Security check to verify compression worked
     if (comp_data_size > 0)
     {
-        output_buffer = (char *)RPNG_CALLOC(8 + 13 + 12 + (comp_data_size + 12) + 12, 1); // Signature + IHDR + IDAT + IEND
+        int chunks_size = 0;
+        for (int i = 0; i < chunk_count; i++) chunks_size += (4 + 4 + chunks[i].length + 4);  // Length + FOURCC + chunk_size + CRC32
+
+        output_buffer = (char *)RPNG_CALLOC(8 + 13 + 12 + chunks_size + (comp_data_size + 12) + 12, 1); // Signature + IHDR + [chunks] + IDAT + IEND
 
         // Write PNG signature
         memcpy(output_buffer, png_signature, 8);
@@ -1369,6 +1553,19 @@ char *rpng_save_image_to_memory(const char *data, int width, int height, int col
         memcpy(output_buffer + 8 + 8 + 13, &crc, 4);
         output_buffer_size += (8 + 12 + 13);
 
+        // Write extra chunks, if provided
+        for (int i = 0; i < chunk_count; i++)
+        {
+            unsigned int length = swap_endian(chunks[i].length);
+            memcpy(output_buffer + output_buffer_size, &length, 4);
+            memcpy(output_buffer + output_buffer_size + 4, chunks[i].type, 4);
+            if (chunks[i].length > 0) memcpy(output_buffer + output_buffer_size + 8, chunks[i].data, chunks[i].length);
+            crc = compute_crc32((unsigned char *)output_buffer + output_buffer_size + 4, 4 + chunks[i].length);  // Computed over type + data
+            crc = swap_endian(crc);
+            memcpy(output_buffer + output_buffer_size + 8 + chunks[i].length, &crc, 4);
+            output_buffer_size += (4 + 4 + chunks[i].length + 4);
+        }
+
         // Write PNG chunk IDAT
         unsigned int length_IDAT = comp_data_size;
         length_IDAT = swap_endian(length_IDAT);
@@ -1386,12 +1583,21 @@ char *rpng_save_image_to_memory(const char *data, int width, int height, int col
         output_buffer_size += 12;
     }
 
-    RPNG_FREE(comp_data);
-
     *output_size = output_buffer_size;
     return output_buffer;
 }
 
+// Unload encoder work buffers
+void rpng_encoder_unload(rpng_encoder *encoder)
+{
+    RPNG_FREE(encoder->data_filtered);
+    RPNG_FREE(encoder->scanlines);
+    RPNG_FREE(encoder->comp_data);
+    RPNG_FREE(encoder->deflate_state);
+
+    *encoder = (rpng_encoder){ 0 };
+}
+
 // Count the chunks in a PNG image from memory buffer
 int rpng_chunk_count_from_memory(const char *buffer)
 {
@@ -1453,6 +1659,43 @@ rpng_chunk rpng_chunk_read_from_memory(const char *buffer, const char *chunk_typ
     return chunk;
 }
 
+// Find one chunk type from memory buffer
+// NOTE: Chunk data is not copied, it points to provided buffer (do not free it),
+// buffer size is checked to avoid reading out of bounds on truncated data
+rpng_chunk rpng_chunk_find_from_memory(const char *buffer, int buffer_size, const char *chunk_type)
+{
+    rpng_chunk chunk = { 0 };
+
+    if ((buffer != NULL) && (buffer_size >= 8) && (memcmp(buffer, png_signature, 8) == 0))  // Check valid PNG file
+    {
+        const char *buffer_ptr = buffer + 8;   // Move pointer after signature
+        const char *buffer_end = buffer + buffer_size;
+
+        while ((buffer_end - buffer_ptr) >= 12)     // Chunk size + type + crc
+        {
+            unsigned int chunk_size = swap_endian(((int *)buffer_ptr)[0]);
+
+            if (chunk_size > (unsigned int)(buffer_end - buffer_ptr - 12)) break;   // Truncated chunk
+
+            if (memcmp(buffer_ptr + 4, chunk_type, 4) == 0)
+            {
+                chunk.length = chunk_size;
+                memcpy(chunk.type, buffer_ptr + 4, 4);
+                chunk.data = (unsigned char *)(buffer_ptr + 8);
+                chunk.crc = swap_endian(((unsigned int *)(buffer_ptr + 8 + chunk_size))[0]);
+
+                break;
+            }
+
+            if (memcmp(buffer_ptr + 4, "IEND", 4) == 0) break;
+
+            buffer_ptr += (4 + 4 + chunk_size + 4);    // Move pointer to next chunk of input data
+        }
+    }
+
+    return chunk;
+}
+
 // Read all chunks from memory buffer
 rpng_chunk *rpng_chunk_read_all_from_memory(const char *buffer, int *count)
 {
@@ -1807,6 +2050,208 @@ char *rpng_chunk_split_image_data_from_memory(char *buffer, int split_size, int
 // Module specific Functions Definition
 //----------------------------------------------------------------------------------
 
+// Filter scanline bytes [start, end) with the five filters (scalar version), accumulating sums of absolute values
+// NOTE: Filtered scanlines are stored consecutively in filtered buffer, size bytes each one
+// REF: https://www.w3.org/TR/PNG/#9Filters
+static void rpng_filter_scanline_range(const unsigned char *row, const unsigned char *prev, int start, int end, int size, int pixel_size, unsigned char *filtered, unsigned int *sums)
+{
+    for (int p = start; p < end; p++)
+    {
+        // x = current byte
+        // a = left pixel byte (from current)
+        // b = above pixel byte (from current)
+        // c = left pixel byte (from b)
+        int x = row[p];
+        int a = (p >= pixel_size)? row[p - pixel_size] : 0;
+        int b = prev[p];
+        int c = (p >= pixel_size)? prev[p - pixel_size] : 0;
+
+        unsigned char out[5] = { 0 };
+        out[0] = (unsigned char)x;
+        out[1] = (unsigned char)(x - a);
+        out[2] = (unsigned char)(x - b);
+        out[3] = (unsigned char)(x - ((a + b)>>1));
+        out[4] = (unsigned char)(x - rpng_paeth_predictor(a, b, c));
+
+        for (int filter = 0; filter < 5; filter++)
+        {
+            filtered[size*filter + p] = out[filter];
+            sums[filter] += abs((signed char)out[filter]);
+        }
+    }
+}
+
+// Filter scanline with the five filters in one sweep, getting the sum of absolute values for every filter
+// NOTE: SIMD versions process 16 bytes per iteration, first pixel and remaining bytes use scalar version
+static void rpng_filter_scanline(const unsigned char *row, const unsigned char *prev, int size, int pixel_size, unsigned char *filtered, unsigned int *sums)
+{
+    for (int filter = 0; filter < 5; filter++) sums[filter] = 0;
+
+    // First pixel, no left pixel available (a = c = 0)
+    int start = (pixel_size < size)? pixel_size : size;
+    rpng_filter_scanline_range(row, prev, 0, start, size, pixel_size, filtered, sums);
+
+    int p = start;
+
+#if defined(RPNG_SIMD_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i one = _mm_set1_epi8(1);
+    __m128i acc[5] = { zero, zero, zero, zero, zero };
+
+    for (; (p + 16) <= size; p += 16)
+    {
+        __m128i x = _mm_loadu_si128((const __m128i *)(row + p));
+        __m128i a = _mm_loadu_si128((const __m128i *)(row + p - pixel_size));
+        __m128i b = _mm_loadu_si128((const __m128i *)(prev + p));
+        __m128i c = _mm_loadu_si128((const __m128i *)(prev + p - pixel_size));
+
+        // Average: floor((a + b)/2), _mm_avg_epu8() rounds up
+        __m128i avg = _mm_sub_epi8(_mm_avg_epu8(a, b), _mm_and_si128(_mm_xor_si128(a, b), one));
+
+        // Paeth predictor, computed exactly on 16 bit lanes:
+        // pa = |b - c|, pb = |a - c|, pc = |a + b - 2c|
+        __m128i pred[2];
+        for (int h = 0; h < 2; h++)
+        {
+            __m128i a16 = (h == 0)? _mm_unpacklo_epi8(a, zero) : _mm_unpackhi_epi8(a, zero);
+            __m128i b16 = (h == 0)? _mm_unpacklo_epi8(b, zero) : _mm_unpackhi_epi8(b, zero);
+            __m128i c16 = (h == 0)? _mm_unpacklo_epi8(c, zero) : _mm_unpackhi_epi8(c, zero);
+
+            __m128i bc = _mm_sub_epi16(b16, c16);
+            __m128i ac = _mm_sub_epi16(a16, c16);
+            __m128i abc = _mm_add_epi16(bc, ac);
+
+            __m128i pa = _mm_max_epi16(bc, _mm_sub_epi16(zero, bc));
+            __m128i pb = _mm_max_epi16(ac, _mm_sub_epi16(zero, ac));
+            __m128i pc = _mm_max_epi16(abc, _mm_sub_epi16(zero, abc));
+
+            // Select a if (pa <= pb) && (pa <= pc), else b if (pb <= pc), else c
+            __m128i not_a = _mm_or_si128(_mm_cmpgt_epi16(pa, pb), _mm_cmpgt_epi16(pa, pc));
+            __m128i not_b = _mm_cmpgt_epi16(pb, pc);
+
+            __m128i bc_sel = _mm_or_si128(_mm_andnot_si128(not_b, b16), _mm_and_si128(not_b, c16));
+            pred[h] = _mm_or_si128(_mm_andnot_si128(not_a, a16), _mm_and_si128(not_a, bc_sel));
+        }
+        __m128i paeth = _mm_packus_epi16(pred[0], pred[1]);
+
+        __m128i out[5];
+        out[0] = x;
+        out[1] = _mm_sub_epi8(x, a);
+        out[2] = _mm_sub_epi8(x, b);
+        out[3] = _mm_sub_epi8(x, avg);
+        out[4] = _mm_sub_epi8(x, paeth);
+
+        for (int filter = 0; filter < 5; filter++)
+        {
+            _mm_storeu_si128((__m128i *)(filtered + size*filter + p), out[filter]);
+
+            // Absolute value of signed bytes: min(v, -v) considering values as unsigned
+            __m128i abs_value = _mm_min_epu8(out[filter], _mm_sub_epi8(zero, out[filter]));
+            acc[filter] = _mm_add_epi64(acc[filter], _mm_sad_epu8(abs_value, zero));
+        }
+    }
+
+    for (int filter = 0; filter < 5; filter++)
+    {
+        sums[filter] += (unsigned int)_mm_cvtsi128_si32(acc[filter]) + (unsigned int)_mm_cvtsi128_si32(_mm_srli_si128(acc[filter], 8));
+    }
+#elif defined(RPNG_SIMD_NEON)
+    uint32x4_t acc[5] = { vdupq_n_u32(0), vdupq_n_u32(0), vdupq_n_u32(0), vdupq_n_u32(0), vdupq_n_u32(0) };
+    const uint8x16_t zero = vdupq_n_u8(0);
+
+    for (; (p + 16) <= size; p += 16)
+    {
+        uint8x16_t x = vld1q_u8(row + p);
+        uint8x16_t a = vld1q_u8(row + p - pixel_size);
+        uint8x16_t b = vld1q_u8(prev + p);
+        uint8x16_t c = vld1q_u8(prev + p - pixel_size);
+
+        // Paeth predictor: pa = |b - c|, pb = |a - c|, pc = |a + b - 2c| (computed on 16 bit lanes)
+        uint16x8_t pa_lo = vabdl_u8(vget_low_u8(b), vget_low_u8(c));
+        uint16x8_t pa_hi = vabdl_u8(vget_high_u8(b), vget_high_u8(c));
+        uint16x8_t pb_lo = vabdl_u8(vget_low_u8(a), vget_low_u8(c));
+        uint16x8_t pb_hi = vabdl_u8(vget_high_u8(a), vget_high_u8(c));
+        uint16x8_t pc_lo = vabdq_u16(vaddl_u8(vget_low_u8(a), vget_low_u8(b)), vshll_n_u8(vget_low_u8(c), 1));
+        uint16x8_t pc_hi = vabdq_u16(vaddl_u8(vget_high_u8(a), vget_high_u8(b)), vshll_n_u8(vget_high_u8(c), 1));
+
+        // Select a if (pa <= pb) && (pa <= pc), else b if (pb <= pc), else c
+        uint8x16_t sel_a = vcombine_u8(vmovn_u16(vandq_u16(vcleq_u16(pa_lo, pb_lo), vcleq_u16(pa_lo, pc_lo))),
+                                       vmovn_u16(vandq_u16(vcleq_u16(pa_hi, pb_hi), vcleq_u16(pa_hi, pc_hi))));
+        uint8x16_t sel_b = vcombine_u8(vmovn_u16(vcleq_u16(pb_lo, pc_lo)), vmovn_u16(vcleq_u16(pb_hi, pc_hi)));
+        uint8x16_t paeth = vbslq_u8(sel_a, a, vbslq_u8(sel_b, b, c));
+
+        uint8x16_t out[5];
+        out[0] = x;
+        out[1] = vsubq_u8(x, a);
+        out[2] = vsubq_u8(x, b);
+        out[3] = vsubq_u8(x, vhaddq_u8(a, b));  // Halving add: floor((a + b)/2)
+        out[4] = vsubq_u8(x, paeth);
+
+        for (int filter = 0; filter < 5; filter++)
+        {
+            vst1q_u8(filtered + size*filter + p, out[filter]);
+
+            // Absolute value of signed bytes: min(v, -v) considering values as unsigned
+            uint8x16_t abs_value = vminq_u8(out[filter], vsubq_u8(zero, out[filter]));
+            acc[filter] = vpadalq_u16(acc[filter], vpaddlq_u8(abs_value));
+        }
+    }
+
+    for (int filter = 0; filter < 5; filter++)
+    {
+        uint64x2_t sum = vpaddlq_u32(acc[filter]);
+        sums[filter] += (unsigned int)(vgetq_lane_u64(sum, 0) + vgetq_lane_u64(sum, 1));
+    }
+#endif
+
+    // Remaining bytes (or full scanline if no SIMD available)
+    rpng_filter_scanline_range(row, prev, p, size, size, pixel_size, filtered, sums);
+}
+
+// Filter scanline with one specific filter (no filters heuristic)
+static void rpng_filter_scanline_fixed(const unsigned char *row, const unsigned char *prev, int size, int pixel_size, int filter, unsigned char *filtered)
+{
+    switch (filter)
+    {
+        case RPNG_FILTER_NONE: memcpy(filtered, row, size); break;
+        case RPNG_FILTER_SUB:
+        {
+            for (int p = 0; p < size; p++) filtered[p] = (unsigned char)(row[p] - ((p >= pixel_size)? row[p - pixel_size] : 0));
+        } break;
+        case RPNG_FILTER_UP:
+        {
+            for (int p = 0; p < size; p++) filtered[p] = (unsigned char)(row[p] - prev[p]);
+        } break;
+        case RPNG_FILTER_AVERAGE:
+        {
+            for (int p = 0; p < size; p++) filtered[p] = (unsigned char)(row[p] - ((((p >= pixel_size)? row[p - pixel_size] : 0) + prev[p])>>1));
+        } break;
+        case RPNG_FILTER_PAETH:
+        {
+            for (int p = 0; p < size; p++)
+            {
+                int a = (p >= pixel_size)? row[p - pixel_size] : 0;
+                int c = (p >= pixel_size)? prev[p - pixel_size] : 0;
+                filtered[p] = (unsigned char)(row[p] - rpng_paeth_predictor(a, prev[p], c));
+            }
+        } break;
+        default: break;
+    }
+}
+
+// Reserve encoder work buffer size (contents not kept)
+static void *rpng_encoder_reserve(unsigned char **buffer, int *buffer_size, int required_size)
+{
+    if ((*buffer == NULL) || (*buffer_size < required_size))
+    {
+        RPNG_FREE(*buffer);
+        *buffer = (unsigned char *)RPNG_MALLOC(required_size);
+        *buffer_size = (*buffer != NULL)? required_size : 0;
+    }
+
+    return *buffer;
+}
+
 // Swap integer from big<->little endian
 static unsigned int swap_endian(unsigned int value)
 {
@@ -2515,9 +2960,334 @@ sdefl_compr(struct sdefl *s, unsigned char *out, const unsigned char *in,
   assert(s->bitcnt == 0);
   return (int)(q - out);
 }
+/* ------------------------- optimal parsing --------------------------- */
+#define SDEFL_OPT_BLK_MAX       (SDEFL_BLK_MAX*2)
+#define SDEFL_OPT_CHAIN         (1 << 13)
+#define SDEFL_OPT_ITER          (8)
+#define SDEFL_OPT_MATCH_CANDS   (8)
+#define SDEFL_OPT_LEN_ALL       (32)
+#define SDEFL_OPT_NICE          (128)
+#define SDEFL_OPT_SKIP          (16)
+#define SDEFL_OPT_INF           (0xFFFFFFFFu)
+
+#ifndef SDEFL_MALLOC
+  #define SDEFL_MALLOC(sz)      RPNG_MALLOC(sz)
+#endif
+#ifndef SDEFL_REALLOC
+  #define SDEFL_REALLOC(p,sz)   RPNG_REALLOC(p,sz)
+#endif
+#ifndef SDEFL_FREE
+  #define SDEFL_FREE(p)         RPNG_FREE(p)
+#endif
+
+struct sdefl_opt_cand {
+  unsigned short len;
+  unsigned short off;
+};
+struct sdefl_opt_cost {
+  unsigned lit[SDEFL_SYM_MAX];
+  unsigned off[SDEFL_OFF_MAX];
+};
+static const unsigned char sdefl_opt_len_xbits[] = {0,0,0,0,0,0,0,0,1,1,1,1,2,2,2,2,3,3,3,3,4,4,4,4,5,5,5,5,0};
+static const unsigned char sdefl_opt_off_xbits[] = {0,0,0,0,1,1,2,2,3,3,4,4,5,5,6,6,7,7,8,8,9,9,10,10,11,11,12,12,13,13,0,0};
+
+static unsigned
+sdefl_opt_log2(unsigned n) {
+  /* log2(n) in 1/256 bit units, mantissa linearly approximated */
+  int k = sdefl_ilog2((int)n);
+  unsigned frac = (k >= 8) ? ((n >> (k - 8)) & 0xFF) : ((n << (8 - k)) & 0xFF);
+  return (unsigned)k*256u + frac;
+}
+static int
+sdefl_opt_fnd(struct sdefl_opt_cand *c, const struct sdefl *s, int chain_len,
+              int max_match, const unsigned char *in, int p, int e) {
+  /* matches with increasing length (and distance) found in hash chain */
+  int i = s->tbl[sdefl_hash32(in + p)];
+  int limit = ((p - SDEFL_WIN_SIZ) < SDEFL_NIL) ? SDEFL_NIL : (p-SDEFL_WIN_SIZ);
+  int cnt = 0, best = SDEFL_MIN_MATCH - 1;
+
+  assert(p + max_match <= e);
+  while (i > limit) {
+    if (in[i + best] == in[p + best] &&
+      (sdefl_uload32(&in[i]) == sdefl_uload32(&in[p]))) {
+      int n = SDEFL_MIN_MATCH;
+      while (n < max_match && in[i + n] == in[p + n]) n++;
+      if (n > best) {
+        if (cnt == SDEFL_OPT_MATCH_CANDS) cnt--;
+        c[cnt].len = (unsigned short)n;
+        c[cnt].off = (unsigned short)(p - i);
+        cnt++, best = n;
+        if (n == max_match)
+          break;
+      }
+    }
+    if (!(--chain_len)) break;
+    i = s->prv[i & SDEFL_WIN_MSK];
+  }
+  return cnt;
+}
+static int
+sdefl_opt_carry(struct sdefl_opt_cand *c, const struct sdefl_opt_cand *prv,
+                int prv_cnt, int max_match, const unsigned char *in, int p) {
+  /* previous position matches one byte shorter, extended if possible (previous ones could be
+   * limited by max match length), same distances are usually the best ones inside long matches */
+  int k, cnt = 0;
+  for (k = 0; k < prv_cnt; ++k) {
+    int n = prv[k].len - 1;
+    n = (n > max_match) ? max_match : n;
+    while (n < max_match && in[p + n] == in[p + n - prv[k].off]) n++;
+    if (n < SDEFL_MIN_MATCH || (cnt && n <= c[cnt-1].len)) continue;
+    c[cnt].len = (unsigned short)n;
+    c[cnt].off = prv[k].off;
+    cnt++;
+  }
+  return cnt;
+}
+static int
+sdefl_opt_merge(struct sdefl_opt_cand *c, int cnt, const struct sdefl_opt_cand *add,
+                int add_cnt) {
+  /* merge matches lists (increasing distance), keeping closest match for every length */
+  struct sdefl_opt_cand tmp[SDEFL_OPT_MATCH_CANDS*2];
+  int i = 0, j = 0, n = 0, best = SDEFL_MIN_MATCH - 1;
+  while (i < cnt || j < add_cnt) {
+    struct sdefl_opt_cand m;
+    if (j >= add_cnt || (i < cnt && c[i].off <= add[j].off)) m = c[i++];
+    else m = add[j++];
+    if (m.len <= best) continue;
+    tmp[n++] = m, best = m.len;
+  }
+  if (n > SDEFL_OPT_MATCH_CANDS) {
+    /* longest match is always kept */
+    tmp[SDEFL_OPT_MATCH_CANDS - 1] = tmp[n - 1];
+    n = SDEFL_OPT_MATCH_CANDS;
+  }
+  memcpy(c, tmp, sizeof(struct sdefl_opt_cand)*n);
+  return n;
+}
+static void
+sdefl_opt_costs(struct sdefl_opt_cost *cost, const struct sdefl_freq *freq) {
+  /* symbol costs (-log2(p)) from previous parse statistics, unused symbols one bit more than the rarest ones */
+  unsigned lit_total = 0, off_total = 0, lit_log = 0, off_log = 0;
+  int i;
+  for (i = 0; i < SDEFL_SYM_MAX; ++i) lit_total += freq->lit[i];
+  for (i = 0; i < SDEFL_OFF_MAX; ++i) off_total += freq->off[i];
+  lit_log = sdefl_opt_log2(lit_total + 1);
+  off_log = sdefl_opt_log2(off_total + 1);
+  for (i = 0; i < SDEFL_SYM_MAX; ++i)
+    cost->lit[i] = freq->lit[i] ? (lit_log - sdefl_opt_log2(freq->lit[i])) : (lit_log + 256);
+  for (i = 0; i < SDEFL_OFF_MAX; ++i)
+    cost->off[i] = freq->off[i] ? (off_log - sdefl_opt_log2(freq->off[i])) : (off_log + 256);
+  for (i = 0; i < 29; ++i) cost->lit[257 + i] += sdefl_opt_len_xbits[i]*256u;
+  for (i = 0; i < 30; ++i) cost->off[i] += sdefl_opt_off_xbits[i]*256u;
+}
+static void
+sdefl_opt_costs_fixed(struct sdefl_opt_cost *cost) {
+  /* initial symbol costs: fixed huffman codes lengths */
+  int i;
+  for (i = 0; i < SDEFL_SYM_MAX; ++i)
+    cost->lit[i] = (i < 144) ? 8*256u : (i < 256) ? 9*256u : (i < 280) ? 7*256u : 8*256u;
+  for (i = 0; i < SDEFL_OFF_MAX; ++i) cost->off[i] = 5*256u;
+  for (i = 0; i < 29; ++i) cost->lit[257 + i] += sdefl_opt_len_xbits[i]*256u;
+  for (i = 0; i < 30; ++i) cost->off[i] += sdefl_opt_off_xbits[i]*256u;
+}
+static int
+sdefl_opt_parse(struct sdefl_opt_cand *path, unsigned *dist, struct sdefl_opt_cand *step,
+                const struct sdefl_opt_cand *cands, const int *cand_pos,
+                const struct sdefl_opt_cost *cost, const unsigned char *in, int n) {
+  /* shortest path (minimum estimated bits) over block positions, returns path steps count */
+  unsigned len_cost[SDEFL_MAX_MATCH + 1];
+  int p, k, cnt = 0;
+  for (k = SDEFL_MIN_MATCH; k <= SDEFL_MAX_MATCH; ++k) {
+    struct sdefl_match_codest cod;
+    sdefl_match_codes(&cod, 1, k);
+    len_cost[k] = cost->lit[cod.lc];
+  }
+  for (p = 1; p <= n; ++p) dist[p] = SDEFL_OPT_INF;
+  dist[0] = 0;
+  for (p = 0; p < n; ++p) {
+    unsigned base = dist[p];
+    unsigned d = base + cost->lit[in[p]];
+    int len = SDEFL_MIN_MATCH;
+    if (d < dist[p + 1]) {
+      dist[p + 1] = d, step[p + 1].len = 1, step[p + 1].off = 0;
+    }
+    for (k = cand_pos[p]; k < cand_pos[p + 1]; ++k) {
+      /* shorter lengths use the closest match that reaches them,
+       * only some lengths are considered for long matches */
+      const struct sdefl_opt_cand *c = &cands[k];
+      struct sdefl_match_codest cod;
+      unsigned off_cost;
+      sdefl_match_codes(&cod, c->off, c->len);
+      off_cost = base + cost->off[cod.dc];
+      for (; len <= c->len; ++len) {
+        if (len > SDEFL_OPT_LEN_ALL && len < c->len) {
+          len = c->len;
+        }
+        d = off_cost + len_cost[len];
+        if (d < dist[p + len]) {
+          dist[p + len] = d, step[p + len].len = (unsigned short)len, step[p + len].off = c->off;
+        }
+      }
+    }
+  }
+  for (p = n; p > 0; p -= step[p].len) cnt++;
+  for (p = n, k = cnt; p > 0; p -= step[p].len) {
+    path[--k] = step[p];
+  }
+  return cnt;
+}
+static unsigned
+sdefl_opt_path_bits(struct sdefl_freq *freq, const struct sdefl_opt_cand *path,
+                    int cnt, const unsigned char *in) {
+  /* path symbols frequencies and block data size (bits) using its own huffman codes */
+  unsigned codes[SDEFL_SYM_MAX];
+  struct sdefl_lens lens;
+  unsigned bits = 0;
+  int i, p = 0;
+  for (i = 0; i < cnt; ++i) {
+    if (path[i].len == 1) {
+      freq->lit[in[p]]++;
+    } else {
+      struct sdefl_match_codest cod;
+      sdefl_match_codes(&cod, path[i].off, path[i].len);
+      freq->lit[cod.lc]++;
+      freq->off[cod.dc]++;
+    }
+    p += path[i].len;
+  }
+  freq->lit[SDEFL_EOB]++;
+  memset(&lens, 0, sizeof(lens));
+  sdefl_huff(lens.lit, codes, freq->lit, SDEFL_SYM_MAX, SDEFL_LIT_LEN_CODES);
+  sdefl_huff(lens.off, codes, freq->off, SDEFL_OFF_MAX, SDEFL_OFF_CODES);
+  for (i = 0; i < SDEFL_SYM_MAX; ++i)
+    bits += freq->lit[i]*(lens.lit[i] + ((i > 256 && i < 286) ? sdefl_opt_len_xbits[i - 257] : 0));
+  for (i = 0; i < SDEFL_OFF_MAX; ++i)
+    bits += freq->off[i]*(lens.off[i] + sdefl_opt_off_xbits[i]);
+  freq->lit[SDEFL_EOB]--;
+  return bits;
+}
+static int
+sdefl_compr_opt(struct sdefl *s, unsigned char *out, const unsigned char *in,
+                int in_len) {
+  /* iterative optimal parsing: matches are found once per block, then block is parsed
+   * again with symbols costs from previous parse statistics while estimated size decreases */
+  unsigned char *q = out;
+  int blk_max = SDEFL_OPT_BLK_MAX;
+  int cand_cap = blk_max;
+  struct sdefl_opt_cand *cands = (struct sdefl_opt_cand*)SDEFL_MALLOC(sizeof(struct sdefl_opt_cand)*cand_cap);
+  int *cand_pos = (int*)SDEFL_MALLOC(sizeof(int)*(blk_max + 1));
+  unsigned *dist = (unsigned*)SDEFL_MALLOC(sizeof(unsigned)*(blk_max + 1));
+  struct sdefl_opt_cand *step = (struct sdefl_opt_cand*)SDEFL_MALLOC(sizeof(struct sdefl_opt_cand)*(blk_max + 1));
+  struct sdefl_opt_cand *path = (struct sdefl_opt_cand*)SDEFL_MALLOC(sizeof(struct sdefl_opt_cand)*blk_max);
+  struct sdefl_opt_cand *best_path = (struct sdefl_opt_cand*)SDEFL_MALLOC(sizeof(struct sdefl_opt_cand)*blk_max);
+  int n, i = 0;
+
+  if (!cands || !cand_pos || !dist || !step || !path || !best_path) {
+    /* not enough memory, fallback to max level lazy matching */
+    n = sdefl_compr(s, out, in, in_len, SDEFL_LVL_MAX);
+    goto done;
+  }
+  for (n = 0; n < SDEFL_HASH_SIZ; ++n) {
+    s->tbl[n] = SDEFL_NIL;
+  }
+  do {int blk_begin = i;
+    int blk_end = ((i + blk_max) < in_len) ? (i + blk_max) : in_len;
+    int blk_len = blk_end - blk_begin;
+    int p, k, it, best_cnt = 0, litlen = 0, prv = 0, fnd = 0, flush_begin = blk_begin;
+    unsigned best_bits = SDEFL_OPT_INF;
+    struct sdefl_opt_cost cost;
+
+    /* find matches at every block position (inserted into hash chains), previous position matches
+     * are carried, positions inside long matches only search hash chain periodically */
+    cand_pos[0] = 0;
+    for (p = blk_begin; p < blk_end; ++p) {
+      int at = cand_pos[p - blk_begin], cnt = 0;
+      int left = blk_end - p;
+      int max_match = (left > SDEFL_MAX_MATCH) ? SDEFL_MAX_MATCH : left;
+      if (at + SDEFL_OPT_MATCH_CANDS > cand_cap) {
+        struct sdefl_opt_cand *c = (struct sdefl_opt_cand*)SDEFL_REALLOC(cands, sizeof(struct sdefl_opt_cand)*cand_cap*2);
+        if (c) cands = c, cand_cap *= 2;
+        else max_match = 0;
+      }
+      if (max_match > SDEFL_MIN_MATCH) {
+        struct sdefl_opt_cand carry[SDEFL_OPT_MATCH_CANDS];
+        int carry_cnt = sdefl_opt_carry(carry, cands + prv, at - prv, max_match, in, p);
+        if (carry_cnt && carry[carry_cnt - 1].len > SDEFL_OPT_NICE && (p - fnd) < SDEFL_OPT_SKIP) {
+          memcpy(cands + at, carry, sizeof(struct sdefl_opt_cand)*carry_cnt);
+          cnt = carry_cnt;
+        } else {
+          cnt = sdefl_opt_fnd(cands + at, s, SDEFL_OPT_CHAIN, max_match, in, p, in_len);
+          cnt = sdefl_opt_merge(cands + at, cnt, carry, carry_cnt);
+          fnd = p;
+        }
+      }
+      prv = at;
+      cand_pos[p - blk_begin + 1] = at + cnt;
+      if (in_len - p > SDEFL_MIN_MATCH) {
+        unsigned h = sdefl_hash32(&in[p]);
+        s->prv[p&SDEFL_WIN_MSK] = s->tbl[h];
+        s->tbl[h] = p;
+      }
+    }
+    sdefl_opt_costs_fixed(&cost);
+    for (it = 0; it < SDEFL_OPT_ITER; ++it) {
+      struct sdefl_freq freq;
+      unsigned bits;
+      int cnt = sdefl_opt_parse(path, dist, step, cands, cand_pos, &cost, in + blk_begin, blk_len);
+      memset(&freq, 0, sizeof(freq));
+      bits = sdefl_opt_path_bits(&freq, path, cnt, in + blk_begin);
+      if (bits >= best_bits) break;
+      best_bits = bits, best_cnt = cnt;
+      memcpy(best_path, path, sizeof(struct sdefl_opt_cand)*cnt);
+      sdefl_opt_costs(&cost, &freq);
+    }
+    /* register best parse sequences, block is flushed early if sequences buffer is full */
+    for (k = 0, p = blk_begin; k < best_cnt; ++k) {
+      if (s->seq_cnt + 3 >= SDEFL_SEQ_SIZ) {
+        if (litlen) {
+          sdefl_seq(s, p - litlen, litlen);
+          litlen = 0;
+        }
+        sdefl_flush(&q, s, 0, in, flush_begin, p);
+        flush_begin = p;
+      }
+      if (best_path[k].len == 1) {
+        s->freq.lit[in[p]]++;
+        litlen++;
+      } else {
+        if (litlen) {
+          sdefl_seq(s, p - litlen, litlen);
+          litlen = 0;
+        }
+        sdefl_seq(s, -best_path[k].off, best_path[k].len);
+        sdefl_reg_match(s, best_path[k].off, best_path[k].len);
+      }
+      p += best_path[k].len;
+    }
+    if (litlen) {
+      sdefl_seq(s, p - litlen, litlen);
+    }
+    sdefl_flush(&q, s, blk_end == in_len, in, flush_begin, blk_end);
+    i = blk_end;
+  } while (i < in_len);
+  if (s->bitcnt) {
+    sdefl_put(&q, s, 0x00, 8 - s->bitcnt);
+  }
+  assert(s->bitcnt == 0);
+  n = (int)(q - out);
+done:
+  SDEFL_FREE(cands);
+  SDEFL_FREE(cand_pos);
+  SDEFL_FREE(dist);
+  SDEFL_FREE(step);
+  SDEFL_FREE(path);
+  SDEFL_FREE(best_path);
+  return n;
+}
 extern int
 sdeflate(struct sdefl *s, void *out, const void *in, int n, int lvl) {
   s->bits = s->bitcnt = 0;
+  if (lvl > SDEFL_LVL_MAX) return sdefl_compr_opt(s, (unsigned char*)out, (const unsigned char*)in, n);
   return sdefl_compr(s, (unsigned char*)out, (const unsigned char*)in, n, lvl);
 }
 static unsigned
@@ -2560,7 +3330,8 @@ zsdeflate(struct sdefl *s, void *out, const void *in, int n, int lvl) {
   s->bits = s->bitcnt = 0;
   sdefl_put(&q, s, 0x78, 8); /* deflate, 32k window */
   sdefl_put(&q, s, 0x01, 8); /* fast compression */
-  q += sdefl_compr(s, q, (const unsigned char*)in, n, lvl);
+  if (lvl > SDEFL_LVL_MAX) q += sdefl_compr_opt(s, q, (const unsigned char*)in, n);
+  else q += sdefl_compr(s, q, (const unsigned char*)in, n, lvl);
 
   /* append adler checksum */
   a = sdefl_adler32(SDEFL_ADLER_INIT, (const unsigned char*)in, n);
@@ -24,6 +24,10 @@
 *       #define COMMAND_LINE_ONLY
 *           Compile tool only for command line usage
 *
+*       #define RICONPACKER_LIBRARY
+*           Compile as library (librip), no main entry point, GUI and command line code excluded,
+*           exposes stateless packing/unpacking functions declared in rip.h (implies COMMAND_LINE_ONLY)
+*
 *       #define CUSTOM_MODAL_DIALOGS
 *           Use custom raygui generated modal dialogs instead of native OS ones
 *           NOTE: Avoids including tinyfiledialogs depencency library
@@ -119,6 +123,10 @@
 #define TOOL_RELEASE_DATE       "Apr.2024"
 #define TOOL_LOGO_COLOR         0xffc800ff
 
+#if defined(RICONPACKER_LIBRARY) && !defined(COMMAND_LINE_ONLY)
+    #define COMMAND_LINE_ONLY               // Library does not include GUI code
+#endif
+
 #include "raylib.h"
 
 #if defined(PLATFORM_WEB)
@@ -126,6 +134,7 @@
     #include <emscripten/emscripten.h>      // Emscripten library - LLVM to JavaScript compiler
 #endif
 
+#if !defined(RICONPACKER_LIBRARY)
 #define RAYGUI_IMPLEMENTATION
 #include "raygui.h"                         // Required for: IMGUI controls
 
@@ -154,18 +163,59 @@
 #include "styles/style_terminal.h"          // raygui style: terminal
 #include "styles/style_ashes.h"             // raygui style: ashes
 #include "styles/style_bluish.h"            // raygui style: bluish
+#endif
+
+#if defined(RICONPACKER_LIBRARY)
+    // Library only exports librip functions (rip.h), embedded modules functions are internal
+    // NOTE: Not all embedded functions are used by library, unused warnings are avoided on GCC/Clang
+    #if defined(__GNUC__)
+        #define RPNGAPI static __attribute__((unused))
+        #define RIPTAPI static __attribute__((unused))
+    #else
+        #define RPNGAPI static
+        #define RIPTAPI static
+    #endif
+#endif
 
 #define RPNG_IMPLEMENTATION
 #include "external/rpng.h"                  // PNG chunks management
 
+#if !defined(RICONPACKER_LIBRARY)
 #include "external/miniz.h"                 // ZIP packaging functions definition
 #include "external/miniz.c"                 // ZIP packaging implementation
+#endif
+
+#define RIP_THREADS_IMPLEMENTATION
+#include "rip_threads.h"                    // Threads management: parallel jobs processing
+
+#if defined(RICONPACKER_LIBRARY)
+    #include "rip.h"                        // Library functions declaration (librip)
+#endif
 
 // Standard C libraries
 #include <stdio.h>                          // Required for: fopen(), fclose(), fread()...
-#include <stdlib.h>                         // Required for: calloc(), free()
+#include <stdlib.h>                         // Required for: calloc(), free(), qsort()
 #include <string.h>                         // Required for: strcmp(), strlen()
-#include <math.h>                           // Required for: ceil()
+#include <math.h>                           // Required for: ceil(), floorf(), sinf(), sqrtf()
+#include <signal.h>                         // Required for: signal(), watch mode interruption
+#include <stdarg.h>                         // Required for: va_list, va_start(), vsnprintf()
+
+#if defined(_WIN32)
+    #include <io.h>                         // Required for: _setmode(), _fileno()
+    #include <fcntl.h>                      // Required for: _O_BINARY, standard streams binary mode
+#endif
+
+// SIMD instructions set detection for images resampling and pixel data conversion
+// NOTE: SSE2 is always available on x86_64, NEON on arm64
+#if !defined(RICONPACKER_NO_SIMD)
+    #if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+        #define RESAMPLE_SIMD_SSE2
+        #include <emmintrin.h>              // Required for: SSE2 intrinsics
+    #elif defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+        #define RESAMPLE_SIMD_NEON
+        #include <arm_neon.h>               // Required for: NEON intrinsics
+    #endif
+#endif
 
 //----------------------------------------------------------------------------------
 // Defines and Macros
@@ -184,11 +234,43 @@ bool __stdcall FreeConsole(void);           // Close console from code (kernel32
     #define LOG(...)
 #endif
 
-#define MAX_ICON_BUCKET_SIZE    64          // Maximum icon image entries in the bucket
-#define MAX_PACK_ELEMENTS       12          // Maximum elements in pack
+// Command line progress info, not printed in quiet mode (--quiet)
+// NOTE: Warnings are always printed to standard error
+#define PRINT_INFO(...) do { if (!quietMode) printf(__VA_ARGS__); } while (0)
+
+// Command line job progress info, buffered if required by job (parallel jobs)
+#define PRINT_JOB_INFO(job, ...) do { if (!quietMode) { if ((job)->infoBuffered) AppendIconPackJobInfo(job, __VA_ARGS__); else printf(__VA_ARGS__); } } while (0)
+
+#define ICON_BUCKET_INITIAL_CAPACITY    16  // Icon bucket initial entries capacity, it grows as required
 
 #define MAX_IMAGE_TEXT_SIZE     48          // Maximum image text size for text poem lines
 
+#define MAX_OUTPUT_SIZES        64          // Maximum number of output sizes to generate (command line)
+#define MAX_EXTRACT_SIZES       64          // Maximum number of sizes to extract (command line)
+#define MAX_OUTPUT_TARGETS      8           // Maximum number of output files per job (command line)
+
+#define BENCH_DEFAULT_ITERATIONS    10      // Benchmark iterations per stage and size (command line --bench)
+#define BENCH_SIZES_COUNT           8       // Benchmark corpus sizes count
+#define BENCH_OPTIMAL_ITERATIONS    3       // Benchmark maximum iterations per size for optimal compression stage (slowest level)
+#define BENCH_OPTIMAL_MAX_SIZE      256     // Benchmark maximum size for optimal compression stage
+
+// WARNING: Cache version must be increased on any change to generated or encoded output images (i.e. scaling filters,
+// PNG filters/compression strategies, palette quantization), previous cache entries could be loaded otherwise
+#define ICON_CACHE_VERSION      1           // Disk cache entries version, considered by job key (command line --cache-dir)
+
+#define WATCH_WAIT_TIMEOUT      250         // Watch mode input files changes wait timeout in milliseconds, exit request is checked
+
+#define MAX_ICON_ENCODERS       MAX_WORKER_THREADS  // Maximum number of PNG encoders kept for reuse
+
+#define PALETTE_MAX_ERROR       2.0f        // Maximum quantization error (RMS, 8 bit levels) to save entries as indexed PNG
+
+#define OPTIMAL_STRATEGIES_COUNT    (RPNG_FILTER_BRUTE + 1) // Filter strategies encoded on optimal compression (RPNG_FILTER_NONE..RPNG_FILTER_BRUTE)
+
+#define RESAMPLE_PARALLEL_MIN_PIXELS    (256*256)   // Minimum source image pixels to split resampling rows across threads
+
+#define MAX_ICON_TASKS_PER_FRAME    1       // Maximum GUI background tasks results applied per frame
+#define IDLE_FRAMES_BEFORE_WAITING  4       // Frames processed after last input event before waiting for events (GUI idle mode)
+
 //----------------------------------------------------------------------------------
 // Types and Structures Definition
 //----------------------------------------------------------------------------------
@@ -202,22 +284,32 @@ typedef struct {
     Image image;                // Icon image
     char text[MAX_IMAGE_TEXT_SIZE]; // Text to be embedded in the image
     bool generated;             // Image generated
+    char *pngData;              // Encoded PNG data cache (image + text), NULL if not encoded yet
+    int pngDataSize;            // Encoded PNG data size
+    unsigned long long pngDataKey;  // Encoded PNG data key: hash of image data, size, text and export options
+    bool pngDataSource;         // Encoded PNG data is source data (loaded from file), not re-encoded
 } IconEntry;
 
 // Icon bucket (platform-independant, image pool)
 // NOTE: All loaded icons go into the bucket before
-// being copied into platform icon pack
+// being copied into platform icon pack, entries are kept
+// sorted by size (descending) and sizes are unique
 typedef struct {
     IconEntry *entries;         // Bucket entries
     unsigned int count;         // Bucket entries count
-    unsigned int capacity;      // Bucket entries capacity
+    unsigned int capacity;      // Bucket entries capacity (grows as required)
 } IconBucket;
 
 // Icon pack (platform specific)
+// NOTE: Pack arrays grow as required by platform sizes scheme,
+// all entries previews share one atlas texture, every entry owns one atlas rectangle
 typedef struct {
-    IconEntry entries[MAX_PACK_ELEMENTS];   // Pack entries (fixed capacity)
-    Texture2D textures[MAX_PACK_ELEMENTS];  // Pack textures
+    IconEntry *entries;                     // Pack entries
+    Texture2D atlas;                        // Pack entries atlas texture (loaded on first entry update)
+    Rectangle *recs;                        // Pack entries rectangles on atlas texture
+    bool *pending;                          // Pack entries waiting for generation (GUI background task)
     unsigned int count;                     // Pack entries count, only used ones by platform!
+    unsigned int capacity;                  // Pack arrays capacity
 } IconPack;
 
 // Icon platform type
@@ -227,14 +319,181 @@ typedef enum {
     ICON_PLATFORM_FAVICON,
     ICON_PLATFORM_ANDROID,
     ICON_PLATFORM_IOS7,
+    ICON_PLATFORM_ALL,                      // All platforms sizes combined
 } IconPlatform;
 
+// PNG compression effort level
+typedef enum {
+    ICON_COMPRESSION_SOURCE = -1,           // Source PNG data kept as is (only used for source data keys)
+    ICON_COMPRESSION_FAST = 0,              // Fixed filter (Up), low deflate level
+    ICON_COMPRESSION_DEFAULT,               // Adaptive filter per scanline, deflate level 8
+    ICON_COMPRESSION_MAX,                   // Best result from multiple filter strategies, deflate level 8
+    ICON_COMPRESSION_OPTIMAL,               // Best result from all filter strategies (including brute force), optimal parsing deflate
+} IconCompressionLevel;
+
+// Image resampling filter (icon sizes generation)
+typedef enum {
+    RESAMPLE_FILTER_BOX = 0,                // Box filter, source pixels area average (exact for 2x/4x reductions)
+    RESAMPLE_FILTER_LANCZOS3,               // Lanczos windowed sinc filter, 3 lobes
+} ResampleFilter;
+
+// Image resampling weights for one axis
+// NOTE: Every destination pixel uses [start, start + count) source pixels,
+// weights are normalized and stored with a fixed stride (maxTaps) per destination pixel
+typedef struct {
+    int *start;                             // First source pixel, per destination pixel
+    int *count;                             // Source pixels count, per destination pixel
+    float *weights;                         // Source pixels weights, maxTaps per destination pixel
+    int maxTaps;                            // Maximum source pixels per destination pixel
+} ResampleWeights;
+
+// Image resampling shared state, rows are split in bands processed in parallel
+typedef struct {
+    const float *srcData;                   // Source image data (premultiplied alpha)
+    int srcWidth;
+    int srcHeight;
+    float *tmpData;                         // Horizontally resampled data (premultiplied alpha), dstWidth x srcHeight
+    unsigned char *dstData;                 // Destination image data (8 bit per channel)
+    int dstWidth;
+    int dstHeight;
+    int bpp;                                // Bytes per pixel
+    int alphaChannel;                       // Alpha channel index (-1 if no alpha)
+    ResampleWeights horizontal;
+    ResampleWeights vertical;
+    int bandCount;                          // Number of rows bands (parallel tasks)
+} ResampleTasks;
+
+// Icon pack export options
+// NOTE: Options are provided to save/export functions, so multiple packs
+// can be exported at the same time with different options
+typedef struct {
+    bool textChunk;                         // Embed image text as a PNG chunk (rIPt)
+    int compression;                        // PNG compression effort level (IconCompressionLevel)
+    int threadCount;                        // Threads used to encode pack entries (0 - Available processors count)
+    int dibMaxSize;                         // Max entry size saved as DIB (uncompressed BMP) into .ico, bigger ones as PNG (0 - Always PNG)
+    int paletteMaxSize;                     // Max entry size saved as indexed PNG (palette), if quantization error is low (0 - Always truecolor)
+} IconExportOptions;
+
+// GUI background task type
+typedef enum {
+    ICON_TASK_LOAD = 0,                     // Load icon file entries into task bucket, images decoded
+    ICON_TASK_GENERATE,                     // Generate icon sizes from source entry
+    ICON_TASK_EXPORT,                       // Export icon pack entries into icon file data (.ico, .icns)
+} IconTaskType;
+
+// GUI background task
+// NOTE: Tasks own all their data (file name, source entry copy and results),
+// results are applied to bucket and pack (textures uploaded) by main thread
+typedef struct {
+    int type;                               // Task type (IconTaskType)
+    unsigned int generation;                // Tasks generation on submit, results are discarded if changed
+    char fileName[512];                     // ICON_TASK_LOAD: Input file name, ICON_TASK_EXPORT: Output file name
+    IconBucket bucket;                      // ICON_TASK_LOAD: Loaded entries, ICON_TASK_EXPORT: Pack entries copy (pack order)
+    IconEntry source;                       // ICON_TASK_GENERATE: Source entry copy (image or encoded data)
+    int *sizes;                             // ICON_TASK_GENERATE: Sizes to generate
+    int count;                              // ICON_TASK_GENERATE: Sizes to generate count
+    int scaleAlgorythm;                     // ICON_TASK_GENERATE: Scaling algorythm
+    Image *images;                          // ICON_TASK_GENERATE: Generated images
+    int format;                             // ICON_TASK_EXPORT: Output file format: 0 - Icon (.ico), 1 - Apple icon (.icns)
+    IconExportOptions options;              // ICON_TASK_EXPORT: Export options
+    char *data;                             // ICON_TASK_EXPORT: Exported file data
+    int dataSize;                           // ICON_TASK_EXPORT: Exported file data size
+    bool done;                              // Task processed
+} IconTask;
+
+// GUI background tasks queue, tasks are processed in submission order by one worker thread
+// NOTE: Tasks are referenced by pointer, queue array can grow while worker is processing one task
+typedef struct {
+    IconTask **tasks;                       // Submitted tasks (processed or not), in submission order
+    int count;                              // Submitted tasks count
+    int capacity;                           // Submitted tasks capacity
+    int next;                               // Next task to be processed by worker
+    unsigned int generation;                // Current tasks generation, increased to discard pending results
+    bool workerActive;                      // Worker thread running, tasks are processed on submit otherwise
+    bool quit;                              // Worker thread required to finish
+    WorkerThread worker;                    // Worker thread
+    ThreadMutex mutex;                      // Queue access mutex
+    ThreadCondition cond;                   // Queue tasks available condition
+} IconTaskQueue;
+
+// Icon pack job output target (command line)
+typedef struct {
+    char fileName[512];                     // Output file name
+    int platform;                           // Output platform sizes scheme
+} IconPackTarget;
+
+// Icon pack job output size stats (command line report)
+typedef struct {
+    int size;                               // Icon size
+    int source;                             // Entry source: 0 - Copied from input, 1 - Generated, 2 - Loaded from cache
+    double encodeTime;                      // Encoding time in seconds (0 if input PNG data is written as is)
+    int bytesIn;                            // Raw image data size (RGBA)
+    int bytesOut;                           // Encoded PNG data size
+} IconPackSizeStats;
+
+// Icon pack job stats (command line report)
+// NOTE: Times in seconds, measured by every job, so they are valid for parallel jobs
+typedef struct {
+    double decodeTime;                      // Input files loading and decoding time
+    double resizeTime;                      // Sizes generation time
+    double encodeTime;                      // Entries encoding time (entries are encoded in parallel)
+    double writeTime;                       // Output files and extracted images writing time
+    double totalTime;                       // Job total processing time
+    long long bytesIn;                      // Input files size
+    long long bytesOut;                     // Output files size
+    IconPackSizeStats *sizes;               // Stats for every distinct output size
+    int sizesCount;                         // Output sizes stats count
+    bool cached;                            // Output entries loaded from disk cache
+    bool failed;                            // Job failed, no valid input images or output files not saved
+    int outputsFailed;                      // Output files not saved count
+} IconPackJobStats;
+
+// Icon pack job (command line)
+// NOTE: One job packs a list of input files into one or multiple output files (targets),
+// multiple jobs can be processed in batch mode by the same process
+typedef struct {
+    char **inputFiles;                      // Input file names ("-" for standard input)
+    int inputFilesCount;                    // Input files count
+    bool inputStream;                       // Input file read from standard input required
+    unsigned char *inputData;               // Standard input file data, read once for all "-" input files
+    int inputDataSize;                      // Standard input file data size
+    IconPackTarget targets[MAX_OUTPUT_TARGETS]; // Output targets, all of them generated from the same input images ("-" for standard output)
+    int targetsCount;                       // Output targets count
+    bool outputStream;                      // Output file written to standard output required
+    char outBaseName[256];                  // First output file name without extension, used for extracted images
+    int outSizes[MAX_OUTPUT_SIZES];         // Sizes to generate
+    int outSizesCount;                      // Number of sizes to generate
+    int scaleAlgorythm;                     // Scaling algorythm on generation
+    bool extractSize;                       // Extract size required
+    int extractSizes[MAX_EXTRACT_SIZES];    // Sizes to extract
+    int extractSizesCount;                  // Number of sizes to extract
+    bool extractAll;                        // Extract all sizes required
+    bool extractZip;                        // Extract images into one zip archive: {output}.zip
+    IconExportOptions exportOptions;        // Export options for output file and extracted images
+    char cacheDir[256];                     // Encoded entries cache directory (empty - cache disabled)
+    IconPackJobStats stats;                 // Job processing stats, filled on processing
+    bool infoBuffered;                      // Job progress info buffered, printed at once by caller (parallel jobs)
+    char *infoText;                         // Job progress info text buffer
+    int infoTextLength;                     // Job progress info text length
+    int infoTextCapacity;                   // Job progress info text buffer capacity
+} IconPackJob;
+
+// Icon pack job watch input file (command line watch mode)
+// NOTE: Sizes provided to job bucket by every input file are kept, so only dependent sizes are reloaded
+typedef struct {
+    int *sizes;                             // Sizes added to job bucket by input file
+    int sizesCount;                         // Sizes count
+    IconBucket bucket;                      // Input file entries reloaded, moved to job bucket on update
+} IconWatchInput;
+
 //----------------------------------------------------------------------------------
 // Global Variables Definition
 //----------------------------------------------------------------------------------
+#if !defined(RICONPACKER_LIBRARY)
 static const char *toolName = TOOL_NAME;
 static const char *toolVersion = TOOL_VERSION;
 static const char *toolDescription = TOOL_DESCRIPTION;
+#endif
 
 // NOTE: Default icon sizes by platform: http://iconhandbook.co.uk/reference/chart/
 static unsigned int icoSizesWindows[8] = { 256, 128, 96, 64, 48, 32, 24, 16 };              // Windows app icons
@@ -243,6 +502,12 @@ static unsigned int icoSizesFavicon[10] = { 228, 152, 144, 120, 96, 72, 64, 32,
 static unsigned int icoSizesAndroid[10] = { 192, 144, 96, 72, 64, 48, 36, 32, 24, 16 };     // Android Launcher/Action/Dialog/Others icons, missing: 512
 static unsigned int icoSizesiOS[9] = { 180, 152, 120, 87, 80, 76, 58, 40, 29 };             // iOS App/Settings/Others icons, missing: 512, 1024
 
+// All platforms combined: previous sizes plus Android adaptive icons layers (432, 324, 216, 162, 108)
+// and iOS App Store/iPad Pro/Spotlight/Notifications sizes (1024, 512, 167, 60, 20)
+static unsigned int icoSizesAll[32] = { 1024, 512, 432, 324, 256, 228, 216, 192, 180, 167, 162, 152, 144, 128, 120, 108,
+                                        96, 87, 80, 76, 72, 64, 60, 58, 48, 40, 36, 32, 29, 24, 20, 16 };
+
+#if !defined(RICONPACKER_LIBRARY)
 // NOTE: Max length depends on OS, in Windows MAX_PATH = 256
 static char inFileName[512] = { 0 };        // Input file name (required in case of drag & drop over executable)
 static char outFileName[512] = { 0 };       // Output file name (required for file save/export)
@@ -251,60 +516,187 @@ static IconBucket bucket = { 0 };           // Icon image bucket
 
 static IconPack currentPack = { 0 };
 //static int platform = ICON_PLATFORM_WINDOWS;
-static int *platformSizes = icoSizesWindows;
-static int platformSizeCount = 8;
 static int packValidCount = 0;              // Valid ico entries counter
 
 static int sizeListActive = 0;              // Current list text entry
 
-// WARNING: This global is required by export functions
-static bool exportTextChunkChecked = true;  // Flag to embed text as a PNG chunk (rIPt)
+static bool exportTextChunkChecked = true;  // Flag to embed text as a PNG chunk (rIPt), GUI export option
 
 static RenderTexture screenTarget = { 0 };
 
+// PNG encoders pool, encoders work buffers are reused between entries and jobs
+// NOTE: Pool is shared by all threads, access is protected by a mutex
+static rpng_encoder *iconEncoders[MAX_ICON_ENCODERS] = { 0 };  // Available encoders
+static int iconEncodersCount = 0;           // Available encoders count
+static ThreadMutex iconEncodersMutex = { 0 };   // Encoders pool access mutex
+
+// GUI background tasks queue: files loading/decoding and icons generation
+// NOTE: Only GPU textures upload is done by main thread, when task results are applied
+static IconTaskQueue iconTasks = { 0 };
+
+// Command line quiet mode, only warnings printed (--quiet)
+// NOTE: Set before processing jobs, only read by jobs threads
+static bool quietMode = false;
+
+// Command line watch mode exit requested (interruption signal received)
+static volatile sig_atomic_t watchExitRequested = 0;
+#endif
+
 //----------------------------------------------------------------------------------
 // Module Functions Declaration
 //----------------------------------------------------------------------------------
-#if defined(PLATFORM_DESKTOP) || defined(COMMAND_LINE_ONLY)
+#if (defined(PLATFORM_DESKTOP) || defined(COMMAND_LINE_ONLY)) && !defined(RICONPACKER_LIBRARY)
 static void ShowCommandLineInfo(void);                      // Show command line usage info
-static void ProcessCommandLine(int argc, char *argv[]);     // Process command line input
+static int ProcessCommandLine(int argc, char *argv[]);      // Process command line input, returns exit status (0 - Success, 1 - Any job failed)
+static bool ProcessCommandLineBatch(const char *fileName, int threadCount, const char *cacheDir, FILE *reportFile);  // Process batch jobs file (one job per line), returns false if any job failed
+static int SplitCommandLineArgs(char *text, char **args, int maxArgs);      // Split command line text into arguments
+
+static bool ParseIconPackJob(int argc, char *argv[], IconPackJob *job);     // Parse icon pack job from command line arguments
+static void UnloadIconPackJob(IconPackJob *job);            // Unload icon pack job data
+static void ProcessIconPackJob(IconPackJob *job);           // Process icon pack job: load, generate, save and extract
+static void ProcessIconPackJobTask(void *userData, int index);  // Process icon pack job from jobs array (parallel task)
+static void AppendIconPackJobInfo(IconPackJob *job, const char *format, ...);  // Append formatted text to icon pack job progress info buffer
+static void ProcessIconPackWatch(IconPackJob *job);         // Process icon pack job in watch mode: rebuild output files when input files change
+static int UpdateIconPackWatchBucket(IconPackJob *job, IconBucket *jobBucket, IconWatchInput *inputs, const bool *changed, int **affectedSizes);  // Update watch mode job bucket with changed input files
+static void WatchSignalHandler(int signal);                 // Watch mode interruption signal handler
+
+static int GetIconPackJobSizes(IconPackJob *job, int (*outSizes)[MAX_OUTPUT_SIZES], int *outSizesCount, int *poolSizes);   // Get icon pack job targets output sizes and unique pool sizes
+static void SaveIconPackJobTargets(IconPackJob *job, IconEntry *pool, int (*outSizes)[MAX_OUTPUT_SIZES], const int *outSizesCount, bool atomic);  // Save every icon pack job target icon file from pool entries
+static unsigned long long ComputeIconPackJobKey(IconPackJob *job, const int *outSizes, int outSizesCount);   // Compute icon pack job key for disk cache
+static bool LoadIconPackJobCache(IconPackJob *job, unsigned long long key, IconEntry *outPack, int outPackCount);  // Load icon pack job output entries from disk cache
+static void SaveIconPackJobCache(IconPackJob *job, unsigned long long key, IconEntry *outPack, int outPackCount);  // Save icon pack job output entries to disk cache
+static void SaveIconPackJobReport(FILE *reportFile, IconPackJob *job, int index);  // Save icon pack job stats into report file (JSON)
+static void SaveReportString(FILE *reportFile, const char *text);    // Save text as JSON string into report file, escaped
+static unsigned char *LoadStandardInputData(int *dataSize); // Load all standard input data (binary mode)
+
+static void ProcessBenchmark(int iterations, int threadCount);  // Process benchmark suite over a fixed corpus, report stages latencies and throughput
+static Image GenBenchmarkImage(int size);                   // Generate benchmark corpus image (deterministic)
+static void PrintBenchmarkResult(const char *stage, int size, double *samples, int count, double pixels, double bytes);  // Print benchmark stage results
+static int CompareBenchmarkSamples(const void *a, const void *b);  // Compare benchmark samples (qsort() callback)
 #endif
 
+#if !defined(RICONPACKER_LIBRARY)
 static void AddIconToBucket(IconBucket *bucket, const char *fileName);      // Add icon images from input file to bucket
-static void RemoveIconFromBucket(IconBucket *bucket, unsigned int size);    // TODO: Remove icon from bucket -NOT USED-
+static void AddIconDataToBucket(IconBucket *bucket, const unsigned char *fileData, int fileSize, const char *fileType);  // Add icon images from input file data to bucket
+static const char *GetIconFileDataType(const unsigned char *fileData, int fileSize);   // Get icon/image file type from file data signature (NULL if not recognized)
+#endif
+static IconEntry *LoadIconEntriesFromMemory(const unsigned char *fileData, int fileSize, const char *fileType, int *count);  // Load icon entries from icon/image file data
+static void AddIconEntriesToBucket(IconBucket *bucket, IconEntry *entries, int count);   // Add icon entries to bucket, replacing same size entries
+static int FindIconBucketEntry(IconBucket bucket, int size, int *insertIndex);  // Find bucket entry index by size (binary search), -1 if not found
+#if !defined(RICONPACKER_LIBRARY)
+static void RemoveIconFromBucket(IconBucket *bucket, unsigned int size);    // Remove icon from bucket, unload entry image
 static void UpdateIconPackFromBucket(IconPack *pack, IconBucket bucket);    // Update icon pack with icon bucket data
+#endif
 static void ClearIconBucket(IconBucket *bucket);                            // Clear icon bucket, unload all contained images
 
+#if !defined(RICONPACKER_LIBRARY)
 static void ResetIconPack(IconPack *pack, int platform);    // Reset icon pack, unload generated images and textures
+static void UpdateIconPackAtlas(IconPack *pack, int index); // Update icon pack atlas texture rectangle with entry image
+static void UnloadIconPack(IconPack *pack);                 // Unload icon pack, all entries and arrays
+#endif
+static unsigned int *GetPlatformSizes(int platform, int *count);    // Get platform sizes scheme (descending order)
+#if !defined(RICONPACKER_LIBRARY)
 static char *GetTextIconSizes(IconPack pack);               // Get sizes as a text array separated by semicolon (ready for GuiListView())
+#endif
 
 // Load/Save/Export data functions
+#if !defined(RICONPACKER_LIBRARY)
 static IconEntry *LoadIconPackFromICO(const char *fileName, int *count);                    // Load icon pack from .ico file
-static void SaveIconPackToICO(IconEntry *entries, int entryCount, const char *fileName);    // Save icon pack to.ico file
-static void ExportIconPackImages(IconEntry *entries, int entryCount, const char *fileName); // Export icon pack to multiple .png images
+#endif
+static IconEntry *LoadIconPackFromICOMemory(const unsigned char *fileData, int fileSize, int *count);  // Load icon pack from .ico file data
+#if !defined(RICONPACKER_LIBRARY)
+static bool SaveIconPackToICO(IconEntry *entries, int entryCount, const char *fileName, IconExportOptions options);     // Save icon pack to.ico file, returns false on failure
+#endif
+static char *ExportIconPackToICOMemory(IconEntry *entries, int entryCount, IconExportOptions options, int *dataSize);  // Export icon pack to .ico file data
+#if !defined(RICONPACKER_LIBRARY)
+static void ExportIconPackImages(IconEntry *entries, int entryCount, const char *fileName, IconExportOptions options);  // Export icon pack to multiple .png images
 static IconEntry *LoadIconPackFromICNS(const char *fileName, int *count);                   // Load icon pack from .icns file
-static void SaveIconPackToICNS(IconEntry *entries, int entryCount, const char *fileName);   // Save icon pack to .icns file
+#endif
+static IconEntry *LoadIconPackFromICNSMemory(const unsigned char *icnsData, int icnsDataSize, int *count);  // Load icon pack from .icns file data
+#if !defined(RICONPACKER_LIBRARY)
+static bool SaveIconPackToICNS(IconEntry *entries, int entryCount, const char *fileName, IconExportOptions options);    // Save icon pack to .icns file, returns false on failure
+#endif
+static char *ExportIconPackToICNSMemory(IconEntry *entries, int entryCount, IconExportOptions options, int *dataSize);  // Export icon pack to .icns file data
+static char *ExportIconEntryToMemory(IconEntry entry, IconExportOptions options, int *dataSize);    // Export icon entry image as PNG file data (memory)
+static int ExportIconEntriesToMemory(IconEntry *entries, int entryCount, IconExportOptions options, char **pngDataPtrs, int *pngDataSizes, double *encodeTimes);  // Export icon valid entries as PNG file data (cached), in parallel
+#if !defined(RICONPACKER_LIBRARY)
+static void SaveIconEntryToPNG(IconEntry entry, const char *fileName, IconExportOptions options, mz_zip_archive *zip);  // Save icon entry image as .png file (or into zip archive)
+#endif
+static Image LoadImageFromDIB(const unsigned char *data, int dataSize);  // Load image from .ico DIB data (BMP without file header)
+static char *ExportIconEntryToDIB(IconEntry entry, int *dataSize);  // Export icon entry image as .ico DIB data (32bpp + AND mask)
+#if !defined(RICONPACKER_LIBRARY)
+static int GetIconEntryDIBSize(int size);                   // Get .ico DIB data size for an icon size (32bpp + AND mask)
+#endif
+static void SwapPixelDataRB(const unsigned char *srcData, unsigned char *dstData, int pixelCount);  // Swap red and blue channels (RGBA <-> BGRA), dstData can be srcData
+static void GenPixelDataMask(const unsigned char *data, int pixelCount, unsigned char *mask);    // Generate 1bpp transparency mask from RGBA data (AND mask, MSB first)
+static bool DecodeIcnsRLE(const unsigned char *data, int dataSize, unsigned char *pixels, int pixelCount, const int *channels, int channelCount);  // Decode ICNS RLE data (channel planes) into RGBA image data
+static void MergePixelDataAlpha(unsigned char *data, const unsigned char *alpha, int pixelCount);   // Merge alpha plane (8 bit per pixel) into RGBA data alpha channel
+static int QuantizeImageData(const unsigned char *data, int pixelCount, int channels, unsigned char *indices, unsigned char *palette, unsigned char *paletteAlpha, float *error);  // Quantize image data to a palette (alpha-aware median cut)
+static int GetColorDistance(unsigned int color1, unsigned int color2);  // Get colors distance (squared), color channels premultiplied by alpha
+static int CompareColors(const void *a, const void *b);    // Compare packed colors (qsort() callback)
 
 // Misc functions
+#if !defined(RICONPACKER_LIBRARY)
 static unsigned int CountIconPackTextLines(IconPack pack);  // Count text lines available on icon pack
+#endif
+static bool CheckFileExtension(const char *fileName, const char *ext);  // Check file extension (thread-safe, no internal buffers used)
+static unsigned long long ComputeIconEntryKey(IconEntry entry, IconExportOptions options);  // Compute icon entry key for encoded data cache
+static unsigned long long ComputeDataHash(const void *data, int size, unsigned long long hash);  // Compute data hash (64bit, FNV-1a based)
+static void UnloadIconEntryCache(IconEntry *entry);         // Unload icon entry encoded data cache
+static void CopyIconEntryCache(IconEntry *dst, IconEntry src);  // Copy icon entry encoded data cache
+static bool SetIconEntrySourceData(IconEntry *entry, unsigned char *data, int dataSize);   // Set icon entry source PNG data as encoded data cache, image not decoded
+static bool CheckIconEntryCache(IconEntry entry, IconExportOptions options);    // Check icon entry encoded data cache is valid for export options
+static bool LoadIconEntryImage(IconEntry *entry);           // Load icon entry image from encoded data (if not loaded yet)
+static void GenerateIconSizes(Image image, const int *sizes, int count, int scaleAlgorythm, int threadCount, Image *outImages);  // Generate multiple icon sizes from image, filtering image only once
+static void HalveImageData(const unsigned char *srcData, int width, int height, int bpp, unsigned char *dstData);   // Halve image data size (2x2 box filter), dstData can be srcData
+static float *LoadPremultipliedData(const unsigned char *data, int width, int height, int bpp);  // Load image data as float, color channels premultiplied by alpha
+static void ResampleImageData(const float *srcData, int srcWidth, int srcHeight, int bpp, unsigned char *dstData, int dstWidth, int dstHeight, int filter, int threadCount);   // Resample premultiplied image data (separable filter)
+static ResampleWeights LoadResampleWeights(int srcSize, int dstSize, int filter);  // Load resampling weights for one axis
+static void UnloadResampleWeights(ResampleWeights weights); // Unload resampling weights
+static void ResampleHorizontalTask(void *userData, int index);  // Resample one band of source rows horizontally
+static void ResampleVerticalTask(void *userData, int index);    // Resample one band of destination rows vertically
+
+#if !defined(RICONPACKER_LIBRARY)
+static void InitIconEncoders(void);                         // Initialize PNG encoders pool
+static void UnloadIconEncoders(void);                       // Unload PNG encoders pool, all encoders work buffers
+#endif
+static rpng_encoder *AcquireIconEncoder(void);              // Get PNG encoder from pool (or a new one)
+static void ReleaseIconEncoder(rpng_encoder *encoder);      // Return PNG encoder to pool, buffers are kept for reuse
+
+#if !defined(RICONPACKER_LIBRARY)
+// GUI background tasks functions
+static void InitIconTasks(void);                            // Initialize GUI background tasks queue and worker thread
+static void UnloadIconTasks(void);                          // Stop worker thread and unload pending tasks
+static void SubmitIconTask(IconTask *task);                 // Submit task to background worker (queue takes ownership)
+static void SubmitIconLoadTask(const char *fileName);       // Submit icon file loading task
+static void SubmitIconGenerateTask(IconEntry entry, const int *sizes, int count, int scaleAlgorythm);  // Submit icon sizes generation task
+static void SubmitIconExportTask(IconPack pack, const char *fileName, int format, IconExportOptions options);   // Submit icon pack export task
+static int UpdateIconTasks(IconBucket *bucket, IconPack *pack, int maxResults);    // Apply processed tasks results (main thread), returns pending tasks count
+static void ProcessIconTask(IconTask *task);                // Process one task (worker thread)
+static void ProcessIconTasks(void *userData);               // Worker thread loop
+static void UnloadIconTask(IconTask *task);                 // Unload task data, results not applied
+static void DrawIconPendingPlaceholder(Rectangle bounds);   // Draw placeholder for pending icon image
+#endif
 
+#if !defined(RICONPACKER_LIBRARY)
 //------------------------------------------------------------------------------------
 // Program main entry point
 //------------------------------------------------------------------------------------
 int main(int argc, char *argv[])
 {
-    bucket.entries = (IconEntry *)RL_CALLOC(MAX_ICON_BUCKET_SIZE, sizeof(IconEntry));
-    bucket.capacity = MAX_ICON_BUCKET_SIZE;
+    int exitStatus = 0;                 // Program exit status, command line jobs failures only
+
+    InitIconEncoders();
 
     // Initialize current icon pack
-    currentPack.count = platformSizeCount;
-    for (int i = 0; i < currentPack.count; i++) currentPack.entries[i].size = platformSizes[i];
+    // NOTE: Bucket entries are allocated on first entries addition
+    ResetIconPack(&currentPack, ICON_PLATFORM_WINDOWS);
 
 #if !defined(_DEBUG)
     SetTraceLogLevel(LOG_NONE);         // Disable raylib trace log messsages
 #endif
 #if defined(COMMAND_LINE_ONLY)
-    ProcessCommandLine(argc, argv);
+    exitStatus = ProcessCommandLine(argc, argv);
 #else
 #if defined(PLATFORM_DESKTOP)
     // Command-line usage mode
@@ -313,7 +705,8 @@ int main(int argc, char *argv[])
     {
         if ((argc == 2) &&
             (strcmp(argv[1], "-h") != 0) &&
-            (strcmp(argv[1], "--help") != 0))       // One argument (file dropped over executable?)
+            (strcmp(argv[1], "--help") != 0) &&
+            (strcmp(argv[1], "--bench") != 0))      // One argument (file dropped over executable?)
         {
             if (IsFileExtension(argv[1], ".ico") ||
                 IsFileExtension(argv[1], ".png;.bmp;.qoi"))
@@ -323,8 +716,9 @@ int main(int argc, char *argv[])
         }
         else
         {
-            ProcessCommandLine(argc, argv);
-            return 0;
+            exitStatus = ProcessCommandLine(argc, argv);
+            UnloadIconEncoders();
+            return exitStatus;
         }
     }
 #endif
@@ -344,6 +738,15 @@ int main(int argc, char *argv[])
     InitWindow(screenWidth, screenHeight, TextFormat("%s v%s", toolName, toolVersion));
     SetExitKey(0);
 
+    // Initialize background tasks worker: files loading and icons generation
+    // NOTE: Main thread only applies processed results and uploads textures
+    InitIconTasks();
+    int iconTasksPending = 0;
+
+    // Idle mode: if nothing is happening, frame loop waits for input events (no redraw)
+    bool eventWaitingActive = false;
+    int idleFramesCounter = 0;
+
     // GUI: Main Layout
     //-----------------------------------------------------------------------------------
     Vector2 anchorMain = { 0, 0 };
@@ -384,6 +787,7 @@ int main(int argc, char *argv[])
     //-----------------------------------------------------------------------------------
     bool showExportWindow = false;
     int exportFormatActive = 0;         // ComboBox file type selection (.ico, .png)
+    int exportCompressionActive = ICON_COMPRESSION_DEFAULT;    // ComboBox PNG compression level selection
     //-----------------------------------------------------------------------------------
 
     // GUI: Exit Window
@@ -402,13 +806,7 @@ int main(int argc, char *argv[])
     //-----------------------------------------------------------------------------------
 
     // Check if an icon input file has been provided on command line
-    if (inFileName[0] != '\0')
-    {
-        AddIconToBucket(&bucket, inFileName);
-
-        // Update current pack with bucket data
-        UpdateIconPackFromBucket(&currentPack, bucket);
-    }
+    if (inFileName[0] != '\0') SubmitIconLoadTask(inFileName);
 
     SetTargetFPS(60);       // Set our game frames-per-second
     //--------------------------------------------------------------------------------------
@@ -434,10 +832,8 @@ int main(int argc, char *argv[])
                 if (IsFileExtension(droppedFiles.paths[i], ".ico;.icns") ||
                     IsFileExtension(droppedFiles.paths[i], ".png;.bmp;.qoi"))
                 {
-                    AddIconToBucket(&bucket, droppedFiles.paths[i]);
-
-                    // Update current pack with bucket data
-                    UpdateIconPackFromBucket(&currentPack, bucket);
+                    // NOTE: File is loaded in background, bucket and pack are updated once processed
+                    SubmitIconLoadTask(droppedFiles.paths[i]);
                 }
             }
 
@@ -445,12 +841,20 @@ int main(int argc, char *argv[])
         }
         //----------------------------------------------------------------------------------
 
+        // Background tasks results logic
+        //----------------------------------------------------------------------------------
+        // Apply processed tasks results (bucket and pack update, textures upload)
+        // NOTE: Results applied per frame are limited, to keep interface responsive
+        iconTasksPending = UpdateIconTasks(&bucket, &currentPack, MAX_ICON_TASKS_PER_FRAME);
+        //----------------------------------------------------------------------------------
+
         // Keyboard shortcuts
         //----------------------------------------------------------------------------------
         // New style file, previous in/out files registeres are reseted
         if ((IsKeyDown(KEY_LEFT_CONTROL) && IsKeyPressed(KEY_N)) || mainToolbarState.btnNewFilePressed)
         {
             ClearIconBucket(&bucket);
+            iconTasks.generation++;     // Discard pending background tasks results
 
             // Set icon pack to current platform
             ResetIconPack(&currentPack, mainToolbarState.platformActive);
@@ -531,9 +935,9 @@ int main(int argc, char *argv[])
             else
             {
                 // Reset one pack entry
+                UnloadIconEntryCache(&currentPack.entries[sizeListActive - 1]);
                 currentPack.entries[sizeListActive - 1].valid = false;
                 currentPack.entries[sizeListActive - 1].image = (Image){ 0 };
-                UnloadTexture(currentPack.textures[sizeListActive - 1]);
                 memset(currentPack.entries[sizeListActive - 1].text, 0, MAX_IMAGE_TEXT_SIZE);
             }
         }
@@ -629,48 +1033,32 @@ int main(int argc, char *argv[])
         {
             if (sizeListActive == 0)
             {
-                // Get bigger available input image in bucket
-                int biggerSizeIndex = 0;
-                int biggerSize = bucket.entries[0].size;
-                for (int i = 1; i < bucket.count; i++)
-                {
-                    if (bucket.entries[i].size > biggerSize)
-                    {
-                        biggerSize = bucket.entries[i].size;
-                        biggerSizeIndex = i;
-                    }
-                }
+                // Get all missing entries sizes in the series (not already pending)
+                int *genSizes = (int *)RL_CALLOC(currentPack.count, sizeof(int));
+                int genCount = 0;
 
-                // Generate all missing entries in the series
                 for (int i = 0; i < currentPack.count; i++)
                 {
-                    if (!currentPack.entries[i].valid)
-                    {
-                        if (currentPack.entries[i].generated) UnloadImage(currentPack.entries[i].image);
-                        else currentPack.entries[i].image = (Image){ 0 };   // Unlink from bucket image
-                        //currentPack.entries[i].image = ImageCopy(bucket.entries[biggerSizeIndex].image);
-
-                        Image newImage = ImageCopy(bucket.entries[biggerSizeIndex].image);
-
-                        if (scaleAlgorythmActive == 0) ImageResizeNN(&newImage, currentPack.entries[i].size, currentPack.entries[i].size);
-                        else if (scaleAlgorythmActive == 1) ImageResize(&newImage, currentPack.entries[i].size, currentPack.entries[i].size);
-
-                        currentPack.entries[i].image = newImage;
+                    if (!currentPack.entries[i].valid && !currentPack.pending[i]) { genSizes[genCount] = currentPack.entries[i].size; genCount++; }
+                }
 
-                        UnloadTexture(currentPack.textures[i]);
-                        currentPack.textures[i] = LoadTextureFromImage(currentPack.entries[i].image);
+                // Generate all missing sizes at once from bigger image (first bucket entry), in background
+                // NOTE: GUI scale algorythm values: 0 - Nearest-neighbor, 1 - Bicubic
+                if ((genCount > 0) && (bucket.count > 0))
+                {
+                    SubmitIconGenerateTask(bucket.entries[0], genSizes, genCount, scaleAlgorythmActive + 1);
 
-                        currentPack.entries[i].generated = true;
-                        currentPack.entries[i].valid = true;
-                    }
+                    for (int i = 0; i < currentPack.count; i++) if (!currentPack.entries[i].valid) currentPack.pending[i] = true;
                 }
+
+                RL_FREE(genSizes);
             }
             else
             {
                 // Get inmmediately bigger available image in the pack
                 int biggerSizeIndex = 0;
                 int biggerSize = 0;
-                for (int i = currentPack.count; i >= 0; i--)
+                for (int i = currentPack.count - 1; i >= 0; i--)
                 {
                     if (currentPack.entries[i].valid)
                     {
@@ -684,25 +1072,12 @@ int main(int argc, char *argv[])
                     }
                 }
 
-                // Generate only selected missing size
-                if (!currentPack.entries[sizeListActive - 1].valid)
+                // Generate only selected missing size, in background
+                if (!currentPack.entries[sizeListActive - 1].valid && !currentPack.pending[sizeListActive - 1])
                 {
-                    if (currentPack.entries[sizeListActive - 1].generated) UnloadImage(currentPack.entries[sizeListActive - 1].image);
-                    else currentPack.entries[sizeListActive - 1].image = (Image){ 0 };   // Unlink from bucket image
-                    //currentPack.entries[sizeListActive - 1].image = ImageCopy(bucket.entries[biggerSizeIndex].image);
-
-                    Image newImage = ImageCopy(currentPack.entries[biggerSizeIndex].image);
-
-                    if (scaleAlgorythmActive == 0) ImageResizeNN(&newImage, currentPack.entries[sizeListActive - 1].size, currentPack.entries[sizeListActive - 1].size);
-                    else if (scaleAlgorythmActive == 1) ImageResize(&newImage, currentPack.entries[sizeListActive - 1].size, currentPack.entries[sizeListActive - 1].size);
-
-                    currentPack.entries[sizeListActive - 1].image = newImage;
+                    SubmitIconGenerateTask(currentPack.entries[biggerSizeIndex], &currentPack.entries[sizeListActive - 1].size, 1, scaleAlgorythmActive + 1);
 
-                    UnloadTexture(currentPack.textures[sizeListActive - 1]);
-                    currentPack.textures[sizeListActive - 1] = LoadTextureFromImage(currentPack.entries[sizeListActive - 1].image);
-
-                    currentPack.entries[sizeListActive - 1].generated = true;
-                    currentPack.entries[sizeListActive - 1].valid = true;
+                    currentPack.pending[sizeListActive - 1] = true;
                 }
             }
         }
@@ -753,6 +1128,28 @@ int main(int argc, char *argv[])
             showExportFileDialog) GuiLock();
         //----------------------------------------------------------------------------------
 
+        // Idle mode logic
+        //----------------------------------------------------------------------------------
+        // NOTE: A frame processed while waiting is enabled has been woken up by an input event,
+        // some frames are processed after it without waiting, GUI controls actions are registered
+        // when drawn and processed on next frame. Background tasks and text edition (cursor blinking)
+        // require continuous frames processing, idle mode is not available on web (ASYNCIFY main loop)
+        if (eventWaitingActive || (iconTasks.count > 0) || iconTextEditMode) idleFramesCounter = 0;
+        else if (idleFramesCounter <= IDLE_FRAMES_BEFORE_WAITING) idleFramesCounter++;
+
+#if !defined(PLATFORM_WEB)
+        bool eventWaiting = (idleFramesCounter > IDLE_FRAMES_BEFORE_WAITING);
+
+        if (eventWaiting != eventWaitingActive)
+        {
+            if (eventWaiting) EnableEventWaiting();
+            else DisableEventWaiting();
+
+            eventWaitingActive = eventWaiting;
+        }
+#endif
+        //----------------------------------------------------------------------------------
+
         // Draw
         //----------------------------------------------------------------------------------
         BeginTextureMode(screenTarget);
@@ -770,32 +1167,39 @@ int main(int argc, char *argv[])
 
             if (sizeListActive == 0)
             {
-                // macOS supports icns up to 1024x1024 and 512x512, bigger sizes are not drawn on ALL icons mode
-                for (int i = ((mainToolbarState.platformActive == ICON_PLATFORM_MACOS)? 2: 0); i < currentPack.count; i++)
+                // Sizes bigger than 256x256 (i.e. macOS 1024x1024 and 512x512) are not drawn on ALL icons mode
+                for (int i = 0; i < currentPack.count; i++)
                 {
-                    if (currentPack.entries[i].valid) DrawTexture(currentPack.textures[i], (int)anchorMain.x + 135, (int)anchorMain.y + 52, WHITE);
+                    if (currentPack.entries[i].size > 256) continue;
+
+                    if (currentPack.entries[i].valid) DrawTextureRec(currentPack.atlas, currentPack.recs[i], (Vector2){ (float)((int)anchorMain.x + 135), (float)((int)anchorMain.y + 52) }, WHITE);
+                    else if (currentPack.pending[i]) DrawIconPendingPlaceholder((Rectangle){ anchorMain.x + 135, anchorMain.y + 52, currentPack.entries[i].size, currentPack.entries[i].size });
                     else GuiPanel((Rectangle){ anchorMain.x + 135, anchorMain.y + 52, currentPack.entries[i].size, currentPack.entries[i].size }, NULL);
                 }
             }
             else if (sizeListActive > 0)
             {
-                if (mainToolbarState.platformActive == ICON_PLATFORM_MACOS)
+                if (currentPack.entries[sizeListActive - 1].size > 256)
                 {
-                    // macOS supports icns up to 1024x1024 and 512x512, those sizes require a scaled drawing
+                    // Sizes bigger than 256x256 (i.e. macOS 1024x1024 and 512x512) require a scaled drawing
                     float scaling = 256.0f/currentPack.entries[sizeListActive - 1].size;
                     if (scaling > 1.0f) scaling = 1.0f;
 
                     if (currentPack.entries[sizeListActive - 1].valid)
                     {
-                        DrawTextureEx(currentPack.textures[sizeListActive - 1],
-                            (Vector2){ anchorMain.x + 135 + 128 - (currentPack.entries[sizeListActive - 1].size*scaling/2),
-                            anchorMain.y + 52 + 128 - (currentPack.entries[sizeListActive - 1].size*scaling/2) }, 0.0f, scaling, WHITE);
+                        DrawTexturePro(currentPack.atlas, currentPack.recs[sizeListActive - 1],
+                            (Rectangle){ anchorMain.x + 135 + 128 - (currentPack.entries[sizeListActive - 1].size*scaling/2),
+                            anchorMain.y + 52 + 128 - (currentPack.entries[sizeListActive - 1].size*scaling/2),
+                            currentPack.entries[sizeListActive - 1].size*scaling, currentPack.entries[sizeListActive - 1].size*scaling }, (Vector2){ 0 }, 0.0f, WHITE);
                     }
                     else
                     {
-                        GuiPanel((Rectangle){ anchorMain.x + 135 + 128 - currentPack.entries[sizeListActive - 1].size*scaling/2,
+                        Rectangle bounds = { anchorMain.x + 135 + 128 - currentPack.entries[sizeListActive - 1].size*scaling/2,
                             anchorMain.y + 52 + 128 - currentPack.entries[sizeListActive - 1].size*scaling/2,
-                            currentPack.entries[sizeListActive - 1].size*scaling, currentPack.entries[sizeListActive - 1].size*scaling }, NULL);
+                            currentPack.entries[sizeListActive - 1].size*scaling, currentPack.entries[sizeListActive - 1].size*scaling };
+
+                        if (currentPack.pending[sizeListActive - 1]) DrawIconPendingPlaceholder(bounds);
+                        else GuiPanel(bounds, NULL);
                     }
 
                     if (scaling < 1.0f) DrawText(TextFormat("SCALE: %0.2f", scaling), (int)anchorMain.x + 135 + 10, (int)anchorMain.y + 52 + 256 - 24, 20, GREEN);
@@ -804,15 +1208,18 @@ int main(int argc, char *argv[])
                 {
                     if (currentPack.entries[sizeListActive - 1].valid)
                     {
-                        DrawTexture(currentPack.textures[sizeListActive - 1],
-                            (int)anchorMain.x + 135 + 128 - currentPack.entries[sizeListActive - 1].size/2,
-                            (int)anchorMain.y + 52 + 128 - currentPack.entries[sizeListActive - 1].size/2, WHITE);
+                        DrawTextureRec(currentPack.atlas, currentPack.recs[sizeListActive - 1],
+                            (Vector2){ (float)((int)anchorMain.x + 135 + 128 - currentPack.entries[sizeListActive - 1].size/2),
+                            (float)((int)anchorMain.y + 52 + 128 - currentPack.entries[sizeListActive - 1].size/2) }, WHITE);
                     }
                     else
                     {
-                        GuiPanel((Rectangle){ anchorMain.x + 135 + 128 - currentPack.entries[sizeListActive - 1].size/2,
+                        Rectangle bounds = { anchorMain.x + 135 + 128 - currentPack.entries[sizeListActive - 1].size/2,
                             anchorMain.y + 52 + 128 - currentPack.entries[sizeListActive - 1].size/2,
-                            currentPack.entries[sizeListActive - 1].size, currentPack.entries[sizeListActive - 1].size }, NULL);
+                            currentPack.entries[sizeListActive - 1].size, currentPack.entries[sizeListActive - 1].size };
+
+                        if (currentPack.pending[sizeListActive - 1]) DrawIconPendingPlaceholder(bounds);
+                        else GuiPanel(bounds, NULL);
                     }
                 }
             }
@@ -843,7 +1250,8 @@ int main(int argc, char *argv[])
             GuiSetStyle(STATUSBAR, TEXT_ALIGNMENT, TEXT_ALIGN_CENTER);
             GuiStatusBar((Rectangle){ anchorMain.x + 0, screenHeight - 24, 136, 24 }, TextFormat("BUCKET COUNT: %i", bucket.count));
             GuiStatusBar((Rectangle){ anchorMain.x + 136 - 1, screenHeight - 24, 120, 24 }, TextFormat("PACK COUNT: %i", currentPack.count));
-            GuiStatusBar((Rectangle){ anchorMain.x + 256 - 2, screenHeight - 24, screenWidth - 252 - 2, 24 }, (sizeListActive > 0)? TextFormat("ICON TEXT: %i/%i", strlen(currentPack.entries[sizeListActive - 1].text), MAX_IMAGE_TEXT_SIZE - 1) : NULL);
+            if (iconTasksPending > 0) GuiStatusBar((Rectangle){ anchorMain.x + 256 - 2, screenHeight - 24, screenWidth - 252 - 2, 24 }, TextFormat("PROCESSING: %i", iconTasksPending));
+            else GuiStatusBar((Rectangle){ anchorMain.x + 256 - 2, screenHeight - 24, screenWidth - 252 - 2, 24 }, (sizeListActive > 0)? TextFormat("ICON TEXT: %i/%i", strlen(currentPack.entries[sizeListActive - 1].text), MAX_IMAGE_TEXT_SIZE - 1) : NULL);
             GuiSetStyle(STATUSBAR, TEXT_ALIGNMENT, TEXT_ALIGN_LEFT);
             //----------------------------------------------------------------------------------------
 
@@ -919,7 +1327,7 @@ int main(int argc, char *argv[])
             //----------------------------------------------------------------------------------------
             if (showExportWindow)
             {
-                Rectangle messageBox = { (float)screenWidth/2 - 248/2, (float)screenHeight/2 - 200/2, 248, 112 };
+                Rectangle messageBox = { (float)screenWidth/2 - 248/2, (float)screenHeight/2 - 200/2, 248, 144 };
                 int result = GuiMessageBox(messageBox, "#7#Export Icon File", " ", "#7#Export Icon");
 
                 GuiLabel((Rectangle){ messageBox.x + 12, messageBox.y + 12 + 24, 106, 24 }, "Icon Format:");
@@ -927,7 +1335,10 @@ int main(int argc, char *argv[])
                 // NOTE: If current platform is macOS, we support .icns file export
                 GuiComboBox((Rectangle){ messageBox.x + 12 + 88, messageBox.y + 12 + 24, 136, 24 }, (mainToolbarState.platformActive == 1)? "Icon (.ico);Images (.png);Icns (.icns)" : "Icon (.ico);Images (.png)", &exportFormatActive);
 
-                // WARNING: exportTextChunkChecked is used as a global variable required by SaveICO() and SaveICNS() functions
+                GuiLabel((Rectangle){ messageBox.x + 12, messageBox.y + 12 + 24 + 32, 106, 24 }, "Compression:");
+                GuiComboBox((Rectangle){ messageBox.x + 12 + 88, messageBox.y + 12 + 24 + 32, 136, 24 }, "Fast;Default;Max;Optimal", &exportCompressionActive);
+
+                // NOTE: exportTextChunkChecked is provided to export functions as IconExportOptions
                 //GuiCheckBox((Rectangle){ messageBox.x + 20, messageBox.y + 48 + 24, 16, 16 }, "Export text poem with icon", &exportTextChunkChecked);
 
                 if (result == 1)    // Export button pressed
@@ -961,10 +1372,7 @@ int main(int argc, char *argv[])
 #endif
                 if (result == 1)
                 {
-                    AddIconToBucket(&bucket, inFileName);   // Load icon file
-
-                    // Update current pack with bucket data
-                    UpdateIconPackFromBucket(&currentPack, bucket);
+                    SubmitIconLoadTask(inFileName);     // Load icon file in background
                 }
 
                 if (result >= 0) showLoadFileDialog = false;
@@ -996,10 +1404,13 @@ int main(int argc, char *argv[])
                         else if ((exportFormatActive == 2) && !IsFileExtension(outFileName, ".icns")) strcat(outFileName, ".icns\0");
                     }
 
+                    IconExportOptions exportOptions = { .textChunk = exportTextChunkChecked, .compression = exportCompressionActive };
+
                     // Save into icon file provided pack entries
-                    if (exportFormatActive == 0) SaveIconPackToICO(currentPack.entries, currentPack.count, outFileName);
-                    else if (exportFormatActive == 1) ExportIconPackImages(currentPack.entries, currentPack.count, outFileName);
-                    else if (exportFormatActive == 2) SaveIconPackToICNS(currentPack.entries, currentPack.count, outFileName);
+                    // NOTE: Icon files are encoded and saved by background task, UI keeps responsive while encoding
+                    if (exportFormatActive == 0) SubmitIconExportTask(currentPack, outFileName, 0, exportOptions);
+                    else if (exportFormatActive == 1) ExportIconPackImages(currentPack.entries, currentPack.count, outFileName, exportOptions);
+                    else if (exportFormatActive == 2) SubmitIconExportTask(currentPack, outFileName, 1, exportOptions);
 
                     /*
                     // Testing packaging exported icons into a .zip file -> WORKS
@@ -1059,13 +1470,7 @@ int main(int argc, char *argv[])
                         strcpy(tempFileName, TextFormat("%s.zip", outFileName));
                         emscripten_run_script(TextFormat("saveFileFromMEMFSToDisk('%s','%s')", tempFileName, GetFileName(tempFileName)));
                     }
-                    else
-                    {
-                        // Download file from MEMFS (emscripten memory filesystem)
-                        // NOTE: Second argument must be a simple filename (we can't use directories)
-                        // NOTE: Included security check to (partially) avoid malicious code on PLATFORM_WEB
-                        if (strchr(outFileName, '\'') == NULL) emscripten_run_script(TextFormat("saveFileFromMEMFSToDisk('%s','%s')", outFileName, GetFileName(outFileName)));
-                    }
+                    // NOTE: Icon files are downloaded once saved by background export task
                 #endif
                 }
 
@@ -1118,8 +1523,11 @@ int main(int argc, char *argv[])
 
     // De-Initialization
     //--------------------------------------------------------------------------------------
+    // Stop background tasks worker, pending tasks are discarded
+    UnloadIconTasks();
+
     // Unload icon packs data
-    ResetIconPack(&currentPack, 0);
+    UnloadIconPack(&currentPack);
 
     // Unload icon bucket data
     ClearIconBucket(&bucket);
@@ -1130,13 +1538,16 @@ int main(int argc, char *argv[])
 
 #endif      // !COMMAND_LINE_ONLY
 
-    return 0;
+    UnloadIconEncoders();
+
+    return exitStatus;
 }
+#endif      // !RICONPACKER_LIBRARY
 
 //--------------------------------------------------------------------------------------------
 // Module functions definition
 //--------------------------------------------------------------------------------------------
-#if defined(PLATFORM_DESKTOP) || defined(COMMAND_LINE_ONLY)
+#if (defined(PLATFORM_DESKTOP) || defined(COMMAND_LINE_ONLY)) && !defined(RICONPACKER_LIBRARY)
 // Show command line usage info
 static void ShowCommandLineInfo(void)
 {
@@ -1153,14 +1564,22 @@ static void ShowCommandLineInfo(void)
     printf("USAGE:\n\n");
     printf("    > riconpacker [--help] --input <file01.ext>,[file02.ext],... [--output <filename.ico>]\n");
     printf("                  [--out-sizes <size01>,[size02],...] [--out-platform <value>] [--scale-algorythm <value>]\n");
-    printf("                  [--extract-size <size01>,[size02],...] [--extract-all]\n");
+    printf("                  [--png-compression <value>] [--dib-max-size <size>] [--palette-max-size <size>]\n");
+    printf("                  [--extract-size <size01>,[size02],...] [--extract-all] [--extract-zip]\n");
+    printf("                  [--batch <jobs.txt>] [--jobs <value>]\n");
+    printf("                  [--cache-dir <directory>] [--bench [iterations]]\n");
+    printf("                  [--report json [report.json]] [--quiet] [--watch]\n");
 
     printf("\nOPTIONS:\n\n");
     printf("    -h, --help                      : Show tool version and command line usage help\n\n");
     printf("    -i, --input <file01.ext>,[file02.ext],...\n");
     printf("                                    : Define input file(s). Comma separated for multiple files.\n");
-    printf("                                      Supported extensions: .ico, .icns, .png, .bmp, .qoi\n\n");
-    printf("    -o, --output <filename.ico>     : Define output icon file.\n");
+    printf("                                      Supported extensions: .ico, .icns, .png, .bmp, .qoi\n");
+    printf("                                      NOTE: Use '-' as file name to read input file from standard input\n\n");
+    printf("    -o, --output <filename.ico>     : Define output icon file, .icns supported for macOS platform.\n");
+    printf("                                      Multiple outputs can be defined, paired in order with -op values,\n");
+    printf("                                      input images are loaded and sizes generated once for all outputs.\n");
+    printf("                                      Use '-' as file name to write output file to standard output.\n");
     printf("                                      NOTE: If not specified, defaults to: output.ico\n\n");
     printf("    -op, --out-platform <value>     : Define out sizes by platform scheme.\n");
     printf("                                      Supported values:\n");
@@ -1169,6 +1588,8 @@ static void ShowCommandLineInfo(void)
     printf("                                          2 - favicon (Sizes: 228, 152, 144, 120, 96, 72, 64, 32, 24, 16)\n");
     printf("                                          3 - Android (Sizes: 192, 144, 96, 72, 64, 48, 36, 32, 24, 16)\n");
     printf("                                          4 - iOS (Sizes: 180, 152, 120, 87, 80, 76, 58, 40, 29)\n");
+    printf("                                          5 - All platforms (32 sizes: previous ones, Android adaptive\n");
+    printf("                                              432, 324, 216, 162, 108 and iOS 1024, 512, 167, 60, 20)\n");
     printf("                                      NOTE: If not specified, any icon size can be generated\n\n");
     printf("    -os, --out-sizes <size01>,[size02],...\n");
     printf("                                    : Define output sizes for the output.\n");
@@ -1177,1052 +1598,5162 @@ static void ShowCommandLineInfo(void)
     printf("    -sa, --scale-algorythm <value>  : Define the algorythm used to scale images.\n");
     printf("                                      Supported values:\n");
     printf("                                          1 - Nearest-neighbor scaling algorythm\n");
-    printf("                                          2 - Bicubic scaling algorythm (default)\n\n");
+    printf("                                          2 - Bicubic scaling algorythm (default)\n");
+    printf("                                          3 - Box filter (area average, best for 2x/4x reductions)\n");
+    printf("                                          4 - Lanczos3 filter (sharpest, highest quality)\n\n");
+    printf("    -pc, --png-compression <value>  : Define PNG compression effort level for output images.\n");
+    printf("                                      Supported values:\n");
+    printf("                                          0 - Fast (fixed filter, low compression level)\n");
+    printf("                                          1 - Default (adaptive filter, high compression level)\n");
+    printf("                                          2 - Max (best of multiple filter strategies)\n");
+    printf("                                          3 - Optimal (all filter strategies, optimal parsing deflate, slowest)\n\n");
+    printf("    -dib, --dib-max-size <size>     : Define max size saved as uncompressed DIB (BMP) into .ico output,\n");
+    printf("                                      bigger sizes are saved as PNG. Faster decoding for small sizes.\n");
+    printf("                                      NOTE: If not specified, defaults to 0 (all sizes saved as PNG)\n\n");
+    printf("    -pal, --palette-max-size <size> : Define max size saved as indexed PNG (palette, up to 256 colors).\n");
+    printf("                                      Truecolor PNG is kept if quantization error is high or if smaller.\n");
+    printf("                                      NOTE: If not specified, defaults to 0 (all sizes saved as truecolor)\n\n");
     printf("    -xs, --extract-size <size01>,[size02],...\n");
     printf("                                    : Extract image sizes from input (if size is available)\n");
     printf("                                      NOTE: Exported images name: output_{size}.png\n\n");
     printf("    -xa, --extract-all              : Extract all images from icon.\n");
     printf("                                      NOTE: Exported images naming: output_{size}.png,...\n\n");
+    printf("    -xz, --extract-zip              : Pack extracted images into one zip archive.\n");
+    printf("                                      NOTE: Archive naming: output.zip, images are not recompressed\n\n");
+    printf("    -b, --batch <jobs.txt>          : Process multiple jobs from a text file, one job per line.\n");
+    printf("                                      Every line supports the same options than one command line.\n");
+    printf("                                      NOTE: Use '-' as file name to read jobs from standard input\n\n");
+    printf("    -j, --jobs <value>              : Define number of threads used for processing.\n");
+    printf("                                      Batch jobs and icon sizes are processed in parallel.\n");
+    printf("                                      NOTE: If not specified, defaults to available processors count\n\n");
+    printf("    -cd, --cache-dir <directory>    : Define directory to cache encoded output images between runs.\n");
+    printf("                                      Cached images are reused if input files and options are unchanged.\n");
+    printf("                                      NOTE: Directory must exist, cache is not used for images extraction\n\n");
+    printf("    --report json [report.json]     : Save processing report: per job and per size times (decode, resize,\n");
+    printf("                                      encode, write), bytes in/out, encode ratio and failed outputs.\n");
+    printf("                                      NOTE: If no file is specified, report is written to standard output\n");
+    printf("                                      and progress info is not printed\n\n");
+    printf("    -q, --quiet                     : Do not print progress info, only warnings (standard error).\n\n");
+    printf("    -w, --watch                     : Watch input files and rebuild output files when they change,\n");
+    printf("                                      only changed files are reloaded and dependent sizes regenerated.\n");
+    printf("                                      Output files are replaced atomically. Press Ctrl+C to finish.\n");
+    printf("                                      NOTE: Not available for batch jobs, cache and extraction not used\n\n");
+    printf("    --bench [iterations]            : Run benchmark suite over a generated corpus and exit.\n");
+    printf("                                      Stages: resize, encode, text chunk, decode, write, parse.\n");
+    printf("                                      Reports p50/p99 latencies and throughput (MP/s, MB/s).\n");
+    printf("                                      NOTE: If not specified, iterations defaults to 10,\n");
+    printf("                                      optimal encode stage limited to 3 iterations, up to 256x256\n\n");
     printf("\nEXAMPLES:\n\n");
     printf("    > riconpacker --input image.png --output image.ico --out-platform 0\n");
     printf("        Process <image.png> to generate <image.ico> including full Windows icons sequence\n\n");
+    printf("    > riconpacker --input image.png --output image.ico --out-platform 0 --output image.icns --out-platform 1\n");
+    printf("        Process <image.png> to generate <image.ico> (Windows) and <image.icns> (macOS) in a single run\n\n");
     printf("    > riconpacker --input image.png --out-sizes 256,64,48,32\n");
     printf("        Process <image.png> to generate <output.ico> including sizes: 256,64,48,32\n");
     printf("        NOTE: If a specific size is not found on input file, it's generated from bigger available size\n\n");
     printf("    > riconpacker --input image.ico --extract-all\n");
     printf("        Extract all available images contained in image.ico\n\n");
+    printf("    > riconpacker --input image.ico --output image.ico --extract-all --extract-zip\n");
+    printf("        Extract all available images contained in image.ico into <image.zip>\n\n");
+    printf("    > riconpacker --input image.png --output image.ico --out-platform 0 --watch\n");
+    printf("        Process <image.png> to generate <image.ico>, updated every time <image.png> is saved\n\n");
+    printf("    > cat image.png | riconpacker --input - --output - --out-platform 1 > image.icns\n");
+    printf("        Process <image.png> from standard input to write macOS icon file to standard output\n\n");
+    printf("    > riconpacker --batch jobs.txt\n");
+    printf("        Process all jobs defined in <jobs.txt>, one per line, i.e: -i image.png -o image.ico -op 0\n\n");
+    printf("    > riconpacker --batch jobs.txt --jobs 8\n");
+    printf("        Process all jobs defined in <jobs.txt>, up to 8 jobs processed in parallel\n\n");
+    printf("    > riconpacker --batch jobs.txt --cache-dir cache\n");
+    printf("        Process all jobs defined in <jobs.txt>, reusing images cached in <cache> by previous runs\n\n");
 }
 
 // Process command line input
-static void ProcessCommandLine(int argc, char *argv[])
+// NOTE: Exit status is 1 if any job failed (not parsed, no valid input images loaded or output files not saved)
+static int ProcessCommandLine(int argc, char *argv[])
 {
-    #define MAX_OUTPUT_SIZES    64      // Maximum number of output sizes to generate
-    #define MAX_EXTRACT_SIZES   64      // Maximum number of sizes to extract
-
     // CLI required variables
     bool showUsageInfo = false;         // Toggle command line usage info
-
-    int inputFilesCount = 0;
-    char **inputFiles = NULL;           // Input file names
-    char outFileName[512] = { 0 };      // Output file name
-
-    int outPlatform = 0;                // Output platform sizes scheme
-
-    int outSizes[MAX_OUTPUT_SIZES] = { 0 }; // Sizes to generate
-    int outSizesCount = 0;              // Number of sizes to generate
-
-    int scaleAlgorythm = 2;             // Scaling algorythm on generation
-
-    bool extractSize = false;           // Extract size required
-    int extractSizes[MAX_EXTRACT_SIZES] = { 0 }; // Sizes to extract
-    int extractSizesCount = 0;          // Number of sizes to extract
-
-    bool extractAll = false;            // Extract all sizes required
+    char batchFileName[512] = { 0 };    // Batch jobs file name (one job per line)
+    int threadCount = 0;                // Threads used for processing (0 - Available processors count)
+    char cacheDir[256] = { 0 };         // Encoded entries cache directory (empty - cache disabled)
+    int benchIterations = 0;            // Benchmark iterations per stage (0 - Benchmark not required)
+    bool reportRequired = false;        // Report required (JSON), written once all jobs are processed
+    char reportFileName[512] = { 0 };   // Report file name (empty - standard output)
+    bool watchMode = false;             // Watch input files for changes and rebuild output files (single job)
+    bool outputStream = false;          // Output file written to standard output (single job), progress info disabled
+    bool jobsFailed = false;            // Any job failed (not parsed or processing failed)
 
 #if defined(COMMAND_LINE_ONLY)
     if (argc == 1) showUsageInfo = true;
 #endif
 
-    // Process command line arguments
+    // Process command line arguments not related to one specific job
     for (int i = 1; i < argc; i++)
     {
         if ((strcmp(argv[i], "-h") == 0) || (strcmp(argv[i], "--help") == 0))
         {
             showUsageInfo = true;
         }
-        else if ((strcmp(argv[i], "-i") == 0) || (strcmp(argv[i], "--input") == 0))
+        else if ((strcmp(argv[i], "-b") == 0) || (strcmp(argv[i], "--batch") == 0))
         {
-            // Check for valid argument
-            if (((i + 1) < argc) && (argv[i + 1][0] != '-'))
+            // NOTE: Batch file name "-" is accepted to read jobs from standard input
+            if (((i + 1) < argc) && ((argv[i + 1][0] != '-') || (argv[i + 1][1] == '\0')))
             {
-                const char **files = TextSplit(argv[i + 1], ',', &inputFilesCount);
-
-                inputFiles = (char **)RL_CALLOC(inputFilesCount, sizeof(char *));
-                for (int j = 0; j < inputFilesCount; j++)
-                {
-                    inputFiles[j] = (char *)RL_CALLOC(256, 1);    // Input file name
-                    strcpy(inputFiles[j], files[j]);
-                }
-
+                strncpy(batchFileName, argv[i + 1], 511);
                 i++;
             }
-            else printf("WARNING: No input file(s) provided\n");
+            else fprintf(stderr, "WARNING: No batch file provided\n");
         }
-        else if ((strcmp(argv[i], "-o") == 0) || (strcmp(argv[i], "--output") == 0))
+        else if ((strcmp(argv[i], "-j") == 0) || (strcmp(argv[i], "--jobs") == 0))
         {
             if (((i + 1) < argc) && (argv[i + 1][0] != '-'))
             {
-                if (IsFileExtension(argv[i + 1], ".ico") ||
-                    ((outPlatform == 1) && IsFileExtension(argv[i + 1], ".icns")))      // macOS
-                {
-                    strcpy(outFileName, argv[i + 1]);   // Read output filename
-                }
+                int value = TextToInteger(argv[i + 1]);
+
+                if (value > 0) threadCount = value;
+                else fprintf(stderr, "WARNING: Number of jobs not valid, default to processors count\n");
 
                 i++;
             }
-            else printf("WARNING: Output file extension not recognized.\n");
+            else fprintf(stderr, "WARNING: No number of jobs provided\n");
         }
-        else if ((strcmp(argv[i], "-os") == 0) || (strcmp(argv[i], "--out-sizes") == 0))
+        else if (strcmp(argv[i], "--bench") == 0)
         {
+            benchIterations = BENCH_DEFAULT_ITERATIONS;
+
+            // NOTE: Iterations value is optional
             if (((i + 1) < argc) && (argv[i + 1][0] != '-'))
             {
-                int numValues = 0;
-                const char **values = TextSplit(argv[i + 1], ',', &numValues);
+                int value = TextToInteger(argv[i + 1]);
 
-                for (int j = 0; j < numValues; j++)
-                {
-                    int value = TextToInteger(values[j]);
+                if (value > 0) benchIterations = value;
+                else fprintf(stderr, "WARNING: Benchmark iterations not valid, default to %i\n", BENCH_DEFAULT_ITERATIONS);
 
-                    if ((value > 0) && (value <= 256))
-                    {
-                        outSizes[j] = value;
-                        outSizesCount++;
-                    }
-                    else printf("WARNING: Provided generation size not valid: %i\n", value);
-                }
+                i++;
             }
-            else printf("WARNING: No sizes provided\n");
         }
-        else if ((strcmp(argv[i], "-op") == 0) || (strcmp(argv[i], "--out-platform") == 0))
+        else if (strcmp(argv[i], "--report") == 0)
         {
-            if (((i + 1) < argc) && (argv[i + 1][0] != '-'))
+            // NOTE: Only JSON format supported, report file name is optional
+            if (((i + 1) < argc) && (strcmp(argv[i + 1], "json") == 0))
             {
-                int platform = TextToInteger(argv[i + 1]);   // Read provided platform value
+                reportRequired = true;
+                i++;
 
-                if ((platform >= 0) && (platform < 5)) outPlatform = platform;
-                else printf("WARNING: Platform requested not recognized\n");
+                if (((i + 1) < argc) && (argv[i + 1][0] != '-'))
+                {
+                    strncpy(reportFileName, argv[i + 1], 511);
+                    i++;
+                }
             }
-            else printf("WARNING: No platform provided\n");
+            else fprintf(stderr, "WARNING: Report format not recognized, supported formats: json\n");
         }
-        else if ((strcmp(argv[i], "-sa") == 0) || (strcmp(argv[i], "--scale-algorythm") == 0))
+        else if ((strcmp(argv[i], "-q") == 0) || (strcmp(argv[i], "--quiet") == 0)) quietMode = true;
+        else if ((strcmp(argv[i], "-w") == 0) || (strcmp(argv[i], "--watch") == 0)) watchMode = true;
+        else if ((strcmp(argv[i], "-o") == 0) || (strcmp(argv[i], "--output") == 0))
         {
-            if (((i + 1) < argc) && (argv[i + 1][0] != '-'))
-            {
-                int scale = TextToInteger(argv[i + 1]);   // Read provided scale algorythm value
-
-                if ((scale == 1) || (scale == 2)) scaleAlgorythm = scale;
-                else printf("WARNING: Scale algorythm not recognized, default to Bicubic\n");
-            }
-            else printf("WARNING: No scale algortyhm provided\n");
+            // NOTE: Output file is parsed by job, here it's only checked for standard output
+            if (((i + 1) < argc) && (strcmp(argv[i + 1], "-") == 0)) outputStream = true;
         }
-        else if ((strcmp(argv[i], "-xs") == 0) || (strcmp(argv[i], "--extract-size") == 0))
+        else if ((strcmp(argv[i], "-cd") == 0) || (strcmp(argv[i], "--cache-dir") == 0))
         {
+            // NOTE: Cache directory is also parsed by every job, here it's only required for batch jobs
             if (((i + 1) < argc) && (argv[i + 1][0] != '-'))
             {
-                extractSize = true;
-
-                int numValues = 0;
-                const char **values = TextSplit(argv[i + 1], ',', &numValues);
-
-                for (int j = 0; j < numValues; j++)
-                {
-                    int value = TextToInteger(values[j]);
-
-                    if ((value > 0) && (value <= 256))
-                    {
-                        extractSizes[j] = value;
-                        extractSizesCount++;
-                    }
-                    else printf("WARNING: Requested extract size not valid: %i\n", value);
-                }
+                strncpy(cacheDir, argv[i + 1], 255);
+                i++;
             }
-            else printf("WARNING: No sizes provided\n");
         }
-        else if ((strcmp(argv[i], "-xa") == 0) || (strcmp(argv[i], "--extract-all") == 0)) extractAll = true;
     }
 
-    // Process input files if provided
-    if (inputFilesCount > 0)
+    if (threadCount == 0) threadCount = GetProcessorCount();
+
+    // Standard output is reserved for output file data, no other info can be written to it
+    if (outputStream && (batchFileName[0] == '\0'))
     {
-        if (outFileName[0] == '\0') strcpy(outFileName, (outPlatform == 1)? "output.icns" : "output.ico");  // Set a default name for output in case not provided
+        quietMode = true;
+
+        if (reportRequired && (reportFileName[0] == '\0'))
+        {
+            fprintf(stderr, "WARNING: Report can not be written to standard output along output file, report file required\n");
+            reportRequired = false;
+        }
+    }
 
-        printf("\nInput files:      %s", inputFiles[0]);
-        for (int i = 1; i < inputFilesCount; i++) printf(",%s", inputFiles[i]);
-        printf("\nOutput file:      %s\n\n", outFileName);
+    // Open report file and write report header, jobs stats are written as soon as jobs are processed
+    FILE *reportFile = NULL;
+    double startTime = GetPerformanceTime();
 
-        printf(" > PROCESSING INPUT FILES\n");
+    if (reportRequired && (benchIterations == 0))
+    {
+        // NOTE: Progress info is disabled if report is written to standard output
+        reportFile = (reportFileName[0] != '\0')? fopen(reportFileName, "wt") : stdout;
+        if (reportFile == stdout) quietMode = true;
 
-        // Load input files (all of them) into bucket,
-        // NOTE: If one size has been previously loaded, it is overriden
-        for (int i = 0; i < inputFilesCount; i++)
+        if (reportFile != NULL)
         {
-            AddIconToBucket(&bucket, inputFiles[i]);
-            printf("\nInput file: %s - Added to icon bucket - Total files: %i\n", inputFiles[i], bucket.count);
-
-            RL_FREE(inputFiles[i]);    // Free input file name memory
+            fprintf(reportFile, "{\n  \"tool\": \"%s\",\n  \"version\": \"%s\",\n  \"threads\": %i,\n  \"jobs\": [", toolName, toolVersion, threadCount);
         }
+        else fprintf(stderr, "WARNING: Report file could not be created: %s\n", reportFileName);
+    }
 
-        RL_FREE(inputFiles);           // Free input file names array memory
-
-        // Get bigger available input image in bucket
-        int biggerSizeIndex = 0;
-        int biggerSize = bucket.entries[0].size;
+    if (benchIterations > 0) ProcessBenchmark(benchIterations, threadCount);
+    else if (batchFileName[0] != '\0')
+    {
+        if (watchMode) fprintf(stderr, "WARNING: Watch mode not available for batch jobs, ignored\n");
+        jobsFailed = !ProcessCommandLineBatch(batchFileName, threadCount, cacheDir, reportFile);
+    }
+    else
+    {
+        IconPackJob job = { 0 };
 
-        for (int i = 1; i < bucket.count; i++)
+        if (ParseIconPackJob(argc, argv, &job))
         {
-            if (bucket.entries[i].size > biggerSize)
+            job.exportOptions.threadCount = threadCount;    // Single job, all threads used for entries encoding
+
+            // NOTE: Standard input is read at once, data is shared by all "-" input files
+            if (job.inputStream) job.inputData = LoadStandardInputData(&job.inputDataSize);
+
+            if (watchMode && (job.inputStream || job.outputStream))
             {
-                biggerSize = bucket.entries[i].size;
-                biggerSizeIndex = i;
+                fprintf(stderr, "WARNING: Watch mode not available for standard input/output, ignored\n");
+                watchMode = false;
             }
-        }
 
-        printf("\nAll input images processed.\n");
-        printf("Image sizes added to the bucket: %i (%i", bucket.count, bucket.entries[0].size);
-        for (int i = 1; i < bucket.count; i++) printf(",%i", bucket.entries[i].size);
-        printf(")\n");
-        printf("Biggest size available: %i\n\n", biggerSize);
+            // NOTE: Watch mode keeps processing until interrupted, job stats are not available
+            if (watchMode) ProcessIconPackWatch(&job);
+            else ProcessIconPackJob(&job);
 
-        printf(" > PROCESSING OUTPUT FILE\n\n");
+            if ((reportFile != NULL) && !watchMode) SaveIconPackJobReport(reportFile, &job, 0);
 
-        // Generate output sizes list by platform scheme
-        switch (outPlatform)
-        {
-            case ICON_PLATFORM_WINDOWS: for (int i = 0; i < 8; i++) { outSizes[outSizesCount] = icoSizesWindows[i]; outSizesCount++; }; break;
-            case ICON_PLATFORM_MACOS: for (int i = 0; i < 8; i++) { outSizes[outSizesCount] = icoSizesMacOS[i]; outSizesCount++; }; break;
-            case ICON_PLATFORM_FAVICON: for (int i = 0; i < 10; i++) { outSizes[outSizesCount] = icoSizesFavicon[i]; outSizesCount++; }; break;
-            case ICON_PLATFORM_ANDROID: for (int i = 0; i < 10; i++) { outSizes[outSizesCount] = icoSizesAndroid[i]; outSizesCount++; }; break;
-            case ICON_PLATFORM_IOS7: for (int i = 0; i < 9; i++) { outSizes[outSizesCount] = icoSizesiOS[i]; outSizesCount++; }; break;
-            default: return;
+            jobsFailed = job.stats.failed;
         }
+        else if (!showUsageInfo) jobsFailed = true;
 
-        IconEntry *outPack = NULL;
-        int outPackCount = 0;
+        UnloadIconPackJob(&job);
+    }
 
-        if (outSizesCount > 0)
-        {
-            printf("Output sizes requested: %i", outSizes[0]);
-            for (int i = 1; i < outSizesCount; i++) printf(",%i", outSizes[i]);
-            printf("\n");
+    if (reportFile != NULL)
+    {
+        // NOTE: Peak memory is process peak resident memory, it includes all jobs processed in parallel
+        fprintf(reportFile, "\n  ],\n  \"totalMs\": %.3f,\n  \"peakMemory\": %lld\n}\n", (GetPerformanceTime() - startTime)*1000.0, GetPeakMemoryUsage());
 
-            // Generate custom sizes if required, use biggest available input size and use provided scale algorythm
-            outPackCount = outSizesCount;
-            outPack = (IconEntry *)RL_CALLOC(outPackCount, sizeof(IconEntry));
+        if (reportFile != stdout) fclose(reportFile);
+    }
 
-            // Copy from inputPack or generate if required
-            for (int i = 0; i < outPackCount; i++)
-            {
-                outPack[i].size = outSizes[i];
+    if (showUsageInfo) ShowCommandLineInfo();
 
-                // Check input pack for size to copy
-                for (int j = 0; j < bucket.count; j++)
-                {
-                    if (outPack[i].size == bucket.entries[j].size)
-                    {
-                        printf(" > Size %i: COPIED from input images.\n", outPack[i].size);
-                        outPack[i].image = bucket.entries[j].image;
-                        outPack[i].valid = true;
-                        break;
-                    }
-                }
+    return jobsFailed? 1 : 0;
+}
 
-                // Generate image size if not copied
-                if (!outPack[i].valid)
-                {
-                    printf(" > Size %i: GENERATED from input bigger image (%i).\n", outPack[i].size, biggerSize);
-                    outPack[i].image = ImageCopy(bucket.entries[biggerSizeIndex].image);
+// Process batch jobs file, one job per line
+// NOTE: Every line supports the same options as a single job command line,
+// empty lines and lines starting with '#' are skipped
+// Jobs are parsed in groups on main thread and processed in parallel by threadCount threads,
+// every job owns its icon bucket and export options, so no data is shared between jobs
+// Jobs stats are saved into report file (if provided) once every jobs group is processed
+// Failed jobs are the ones not parsed and the ones failing on processing (no valid input images or output files not saved)
+static bool ProcessCommandLineBatch(const char *fileName, int threadCount, const char *cacheDir, FILE *reportFile)
+{
+    #define MAX_BATCH_LINE_LENGTH   4096    // Maximum length of one batch job line
+    #define MAX_BATCH_LINE_ARGS     64      // Maximum number of arguments in one batch job line
+    #define MAX_BATCH_JOBS_GROUP    256     // Maximum number of batch jobs parsed before processing them
 
-                    if (scaleAlgorythm == 1) ImageResizeNN(&outPack[i].image, outPack[i].size, outPack[i].size);
-                    else if (scaleAlgorythm == 2) ImageResize(&outPack[i].image, outPack[i].size, outPack[i].size);
+    FILE *batchFile = (strcmp(fileName, "-") == 0)? stdin : fopen(fileName, "rt");
 
-                    outPack[i].generated = true;
-                    outPack[i].valid = true;
-                }
-            }
+    if (batchFile == NULL)
+    {
+        fprintf(stderr, "WARNING: Batch file could not be opened: %s\n", fileName);
+        return false;
+    }
 
-            printf("\n");
+    if ((cacheDir[0] != '\0') && !DirectoryExists(cacheDir))
+    {
+        fprintf(stderr, "WARNING: Cache directory not found, cache disabled: %s\n", cacheDir);
+        cacheDir = "";
+    }
 
-            // Save into icon file provided pack entries
-            // NOTE: Only valid entries are exported, png zip packaging also done (if required)
-            if (outPlatform == 1) SaveIconPackToICNS(outPack, outPackCount, outFileName);
-            else SaveIconPackToICO(outPack, outPackCount, outFileName);
-        }
-        else printf("WARNING: No output sizes defined\n");
+    char line[MAX_BATCH_LINE_LENGTH] = { 0 };
+    char *args[MAX_BATCH_LINE_ARGS + 1] = { 0 };
+    int jobsCount = 0;
+    int jobsFailedCount = 0;
+    int jobsReportedCount = 0;
+
+    IconPackJob *jobs = (IconPackJob *)RL_CALLOC(MAX_BATCH_JOBS_GROUP, sizeof(IconPackJob));
+    int groupCount = 0;
+    bool endOfFile = false;
 
-        // Extract required entries: all or provided sizes (only available ones)
-        if (extractAll)
+    while (!endOfFile)
+    {
+        endOfFile = (fgets(line, MAX_BATCH_LINE_LENGTH, batchFile) == NULL);
+
+        if (!endOfFile)
         {
-            // Extract all input pack entries
-            for (int i = 0; i < bucket.count; i++)
+            // First argument is skipped by job parser, like program name on command line
+            args[0] = TOOL_SHORT_NAME;
+            int argsCount = SplitCommandLineArgs(line, args + 1, MAX_BATCH_LINE_ARGS) + 1;
+
+            if ((argsCount == 1) || (args[1][0] == '#')) continue;
+
+            // NOTE: Jobs parsing is done on main thread, it uses raylib text functions (not thread-safe)
+            // NOTE: Standard input/output can not be shared by parallel jobs
+            bool jobParsed = ParseIconPackJob(argsCount, args, &jobs[groupCount]);
+            if (jobParsed && (jobs[groupCount].inputStream || jobs[groupCount].outputStream))
             {
-                if (bucket.entries[i].valid)
-                {
-                    printf(" > Image extract requested (%i): %s_%ix%i.png\n", bucket.entries[i].size, GetFileNameWithoutExt(outFileName), bucket.entries[i].size, bucket.entries[i].size);
-                    ExportImage(bucket.entries[i].image, TextFormat("%s_%ix%i.png", GetFileNameWithoutExt(outFileName), bucket.entries[i].size, bucket.entries[i].size));
-                }
+                fprintf(stderr, "WARNING: Standard input/output not available for batch jobs, job skipped\n");
+                jobParsed = false;
             }
-        }
-        else if (extractSize)
-        {
-            // Extract requested sizes from pack (if available)
-            for (int i = 0; i < bucket.count; i++)
+
+            if (jobParsed)
             {
-                for (int j = 0; j < extractSizesCount; j++)
-                {
-                    if (bucket.entries[i].size == extractSizes[j])
-                    {
-                        printf(" > Image extract requested (%i): %s_%ix%i.png\n", extractSizes[j], GetFileNameWithoutExt(outFileName), bucket.entries[i].size, bucket.entries[i].size);
-                        ExportImage(bucket.entries[i].image, TextFormat("%s_%ix%i.png", GetFileNameWithoutExt(outFileName), bucket.entries[i].size, bucket.entries[i].size));
-                    }
-                }
+                // Command line cache directory used by default, job line can override it
+                if (jobs[groupCount].cacheDir[0] == '\0') strncpy(jobs[groupCount].cacheDir, cacheDir, 255);
+                groupCount++;
             }
-
-            // Extract requested sizes from output pack (if available)
-            for (int i = 0; i < outPackCount; i++)
+            else
             {
-                for (int j = 0; j < extractSizesCount; j++)
-                {
-                    if ((extractSizes[j] > 0) && (outPack[i].size == extractSizes[j]))
-                    {
-                        printf(" > Image extract requested (%i): %s_%ix%i.png\n", extractSizes[j], GetFileNameWithoutExt(outFileName), outPack[i].size, outPack[i].size);
-                        ExportImage(outPack[i].image, TextFormat("%s_%ix%i.png", GetFileNameWithoutExt(outFileName), outPack[i].size, outPack[i].size));
-                    }
-                }
+                UnloadIconPackJob(&jobs[groupCount]);
+                memset(&jobs[groupCount], 0, sizeof(IconPackJob));
+                jobsFailedCount++;
             }
+
+            jobsCount++;
         }
 
-        // Memory cleaning
-        for (int i = 0; i < bucket.count; i++) UnloadImage(bucket.entries[i].image);
-        for (int i = 0; i < outPackCount; i++) if (outPack[i].generated) UnloadImage(outPack[i].image);
-        RL_FREE(outPack);
-    }
+        // Process current jobs group when full or no more jobs available
+        if ((groupCount == MAX_BATCH_JOBS_GROUP) || (endOfFile && (groupCount > 0)))
+        {
+            // Remaining threads (if any) are used for entries encoding inside every job,
+            // it avoids creating more threads than requested
+            int encodingThreadCount = (groupCount < threadCount)? threadCount/groupCount : 1;
+            for (int i = 0; i < groupCount; i++) jobs[i].exportOptions.threadCount = encodingThreadCount;
 
-    if (showUsageInfo) ShowCommandLineInfo();
-}
-#endif
+            RunParallelTasks(ProcessIconPackJobTask, jobs, groupCount, threadCount);
 
-//--------------------------------------------------------------------------------------------
-// Load/Save/Export functions
-//--------------------------------------------------------------------------------------------
-// Get sizes as a text array separated by semicolon (ready for GuiListView())
-static char *GetTextIconSizes(IconPack pack)
-{
-    static char buffer[512] = { 0 };
-    memset(buffer, 0, 512);
+            for (int i = 0; i < groupCount; i++) if (jobs[i].stats.failed) jobsFailedCount++;
 
-    int offset = 0;
-    int length = 0;
-    memcpy(buffer, "ALL;", 4);
-    offset += 4;
+            for (int i = 0; (i < groupCount) && (reportFile != NULL); i++) { SaveIconPackJobReport(reportFile, &jobs[i], jobsReportedCount); jobsReportedCount++; }
 
-    for (int i = 0; i < pack.count; i++)
-    {
-        length = TextLength(TextFormat("%i x %i;", pack.entries[i].size, pack.entries[i].size));
-        memcpy(buffer + offset, TextFormat("%i x %i;", pack.entries[i].size, pack.entries[i].size), length);
-        offset += length;
+            for (int i = 0; i < groupCount; i++) UnloadIconPackJob(&jobs[i]);
+            memset(jobs, 0, MAX_BATCH_JOBS_GROUP*sizeof(IconPackJob));
+            groupCount = 0;
+        }
     }
 
-    buffer[offset - 1] = '\0';
+    RL_FREE(jobs);
 
-    return buffer;
-}
+    if (batchFile != stdin) fclose(batchFile);
+
+    PRINT_INFO("\nBatch processed: %i jobs (%i failed)\n", jobsCount, jobsFailedCount);
+
+    return (jobsFailedCount == 0);
+}
+
+// Split a command line text into arguments, modifying provided text
+// NOTE: Arguments are separated by spaces/tabs, double quotes can be used for arguments containing spaces
+static int SplitCommandLineArgs(char *text, char **args, int maxArgs)
+{
+    int count = 0;
+    char *ptr = text;
+
+    while ((*ptr != '\0') && (count < maxArgs))
+    {
+        // Skip separators between arguments
+        while ((*ptr == ' ') || (*ptr == '\t') || (*ptr == '\r') || (*ptr == '\n')) ptr++;
+        if (*ptr == '\0') break;
+
+        if (*ptr == '\"')
+        {
+            ptr++;
+            args[count] = ptr;
+            while ((*ptr != '\0') && (*ptr != '\"')) ptr++;
+        }
+        else
+        {
+            args[count] = ptr;
+            while ((*ptr != '\0') && (*ptr != ' ') && (*ptr != '\t') && (*ptr != '\r') && (*ptr != '\n')) ptr++;
+        }
+
+        count++;
+
+        if (*ptr != '\0')
+        {
+            *ptr = '\0';
+            ptr++;
+        }
+    }
+
+    return count;
+}
+
+// Parse one icon pack job from command line arguments
+// NOTE: Returns false if job can not be processed (no input files provided or output file extension not valid)
+static bool ParseIconPackJob(int argc, char *argv[], IconPackJob *job)
+{
+    job->scaleAlgorythm = 2;            // Scaling algorythm on generation, default: Bicubic
+    job->exportOptions.textChunk = true;    // Embed image text as PNG chunk, default: enabled
+    job->exportOptions.compression = ICON_COMPRESSION_DEFAULT;
+
+    // NOTE: Multiple output files and platforms can be provided, n-th output file is paired with n-th platform
+    int fileNamesCount = 0;
+    int platformsCount = 0;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if ((strcmp(argv[i], "-i") == 0) || (strcmp(argv[i], "--input") == 0))
+        {
+            // Check for valid argument
+            // NOTE: Input file name "-" is accepted to read input file from standard input
+            if (((i + 1) < argc) && ((argv[i + 1][0] != '-') || (argv[i + 1][1] == '\0') || (argv[i + 1][1] == ',')))
+            {
+                const char **files = TextSplit(argv[i + 1], ',', &job->inputFilesCount);
+
+                job->inputFiles = (char **)RL_CALLOC(job->inputFilesCount, sizeof(char *));
+                for (int j = 0; j < job->inputFilesCount; j++)
+                {
+                    job->inputFiles[j] = (char *)RL_CALLOC(256, 1);    // Input file name
+                    strcpy(job->inputFiles[j], files[j]);
+
+                    if (strcmp(files[j], "-") == 0) job->inputStream = true;
+                }
+
+                i++;
+            }
+            else fprintf(stderr, "WARNING: No input file(s) provided\n");
+        }
+        else if ((strcmp(argv[i], "-o") == 0) || (strcmp(argv[i], "--output") == 0))
+        {
+            // NOTE: Output file name "-" is accepted to write output file to standard output
+            if (((i + 1) < argc) && ((argv[i + 1][0] != '-') || (argv[i + 1][1] == '\0')))
+            {
+                // NOTE: File extension is checked once all platforms are parsed
+                if (fileNamesCount < MAX_OUTPUT_TARGETS)
+                {
+                    strncpy(job->targets[fileNamesCount].fileName, argv[i + 1], 511);   // Read output filename
+                    fileNamesCount++;
+                }
+                else fprintf(stderr, "WARNING: Maximum number of output files reached (%i)\n", MAX_OUTPUT_TARGETS);
+
+                i++;
+            }
+            else fprintf(stderr, "WARNING: No output file provided\n");
+        }
+        else if ((strcmp(argv[i], "-os") == 0) || (strcmp(argv[i], "--out-sizes") == 0))
+        {
+            if (((i + 1) < argc) && (argv[i + 1][0] != '-'))
+            {
+                int numValues = 0;
+                const char **values = TextSplit(argv[i + 1], ',', &numValues);
+
+                for (int j = 0; (j < numValues) && (job->outSizesCount < MAX_OUTPUT_SIZES); j++)
+                {
+                    int value = TextToInteger(values[j]);
+
+                    if ((value > 0) && (value <= 256))
+                    {
+                        job->outSizes[job->outSizesCount] = value;
+                        job->outSizesCount++;
+                    }
+                    else fprintf(stderr, "WARNING: Provided generation size not valid: %i\n", value);
+                }
+            }
+            else fprintf(stderr, "WARNING: No sizes provided\n");
+        }
+        else if ((strcmp(argv[i], "-op") == 0) || (strcmp(argv[i], "--out-platform") == 0))
+        {
+            if (((i + 1) < argc) && (argv[i + 1][0] != '-'))
+            {
+                int platform = TextToInteger(argv[i + 1]);   // Read provided platform value
+
+                if ((platform >= 0) && (platform <= ICON_PLATFORM_ALL))
+                {
+                    if (platformsCount < MAX_OUTPUT_TARGETS)
+                    {
+                        job->targets[platformsCount].platform = platform;
+                        platformsCount++;
+                    }
+                    else fprintf(stderr, "WARNING: Maximum number of output platforms reached (%i)\n", MAX_OUTPUT_TARGETS);
+                }
+                else fprintf(stderr, "WARNING: Platform requested not recognized\n");
+
+                i++;
+            }
+            else fprintf(stderr, "WARNING: No platform provided\n");
+        }
+        else if ((strcmp(argv[i], "-sa") == 0) || (strcmp(argv[i], "--scale-algorythm") == 0))
+        {
+            if (((i + 1) < argc) && (argv[i + 1][0] != '-'))
+            {
+                int scale = TextToInteger(argv[i + 1]);   // Read provided scale algorythm value
+
+                if ((scale >= 1) && (scale <= 4)) job->scaleAlgorythm = scale;
+                else fprintf(stderr, "WARNING: Scale algorythm not recognized, default to Bicubic\n");
+            }
+            else fprintf(stderr, "WARNING: No scale algortyhm provided\n");
+        }
+        else if ((strcmp(argv[i], "-pc") == 0) || (strcmp(argv[i], "--png-compression") == 0))
+        {
+            if (((i + 1) < argc) && (argv[i + 1][0] != '-'))
+            {
+                int compression = TextToInteger(argv[i + 1]);   // Read provided compression level value
+
+                if ((compression >= ICON_COMPRESSION_FAST) && (compression <= ICON_COMPRESSION_OPTIMAL)) job->exportOptions.compression = compression;
+                else fprintf(stderr, "WARNING: Compression level not recognized, default to 1 (Default)\n");
+            }
+            else fprintf(stderr, "WARNING: No compression level provided\n");
+        }
+        else if ((strcmp(argv[i], "-dib") == 0) || (strcmp(argv[i], "--dib-max-size") == 0))
+        {
+            if (((i + 1) < argc) && (argv[i + 1][0] != '-'))
+            {
+                int dibMaxSize = TextToInteger(argv[i + 1]);    // Read provided max size saved as DIB
+
+                if ((dibMaxSize >= 0) && (dibMaxSize <= 256)) job->exportOptions.dibMaxSize = dibMaxSize;
+                else fprintf(stderr, "WARNING: DIB max size not valid [0..256], default to 0 (Always PNG)\n");
+            }
+            else fprintf(stderr, "WARNING: No DIB max size provided\n");
+        }
+        else if ((strcmp(argv[i], "-pal") == 0) || (strcmp(argv[i], "--palette-max-size") == 0))
+        {
+            if (((i + 1) < argc) && (argv[i + 1][0] != '-'))
+            {
+                int paletteMaxSize = TextToInteger(argv[i + 1]);    // Read provided max size saved as indexed PNG
+
+                if ((paletteMaxSize >= 0) && (paletteMaxSize <= 1024)) job->exportOptions.paletteMaxSize = paletteMaxSize;
+                else fprintf(stderr, "WARNING: Palette max size not valid [0..1024], default to 0 (Always truecolor)\n");
+            }
+            else fprintf(stderr, "WARNING: No palette max size provided\n");
+        }
+        else if ((strcmp(argv[i], "-xs") == 0) || (strcmp(argv[i], "--extract-size") == 0))
+        {
+            if (((i + 1) < argc) && (argv[i + 1][0] != '-'))
+            {
+                job->extractSize = true;
+
+                int numValues = 0;
+                const char **values = TextSplit(argv[i + 1], ',', &numValues);
+
+                for (int j = 0; (j < numValues) && (job->extractSizesCount < MAX_EXTRACT_SIZES); j++)
+                {
+                    int value = TextToInteger(values[j]);
+
+                    if ((value > 0) && (value <= 256))
+                    {
+                        job->extractSizes[job->extractSizesCount] = value;
+                        job->extractSizesCount++;
+                    }
+                    else fprintf(stderr, "WARNING: Requested extract size not valid: %i\n", value);
+                }
+            }
+            else fprintf(stderr, "WARNING: No sizes provided\n");
+        }
+        else if ((strcmp(argv[i], "-xa") == 0) || (strcmp(argv[i], "--extract-all") == 0)) job->extractAll = true;
+        else if ((strcmp(argv[i], "-xz") == 0) || (strcmp(argv[i], "--extract-zip") == 0)) job->extractZip = true;
+        else if ((strcmp(argv[i], "-cd") == 0) || (strcmp(argv[i], "--cache-dir") == 0))
+        {
+            if (((i + 1) < argc) && (argv[i + 1][0] != '-'))
+            {
+                if (DirectoryExists(argv[i + 1])) strncpy(job->cacheDir, argv[i + 1], 255);
+                else fprintf(stderr, "WARNING: Cache directory not found, cache disabled: %s\n", argv[i + 1]);
+
+                i++;
+            }
+            else fprintf(stderr, "WARNING: No cache directory provided\n");
+        }
+    }
+
+    job->targetsCount = (fileNamesCount > platformsCount)? fileNamesCount : platformsCount;
+    if (job->targetsCount == 0) job->targetsCount = 1;
+
+    bool targetsValid = true;
+
+    for (int i = 0; i < job->targetsCount; i++)
+    {
+        IconPackTarget *target = &job->targets[i];
+
+        // Check standard output target, output file format defined by platform (.icns for macOS)
+        // NOTE: Only one output file can be written to standard output
+        if (strcmp(target->fileName, "-") == 0)
+        {
+            if (!job->outputStream)
+            {
+                job->outputStream = true;
+                continue;
+            }
+
+            fprintf(stderr, "WARNING: Only one output file can be written to standard output, default name used\n");
+            target->fileName[0] = '\0';
+        }
+
+        // Check output file extension, .icns only supported for macOS platform
+        // NOTE: Job is not processed if any output file extension is not valid for its platform
+        if ((target->fileName[0] != '\0') && !IsFileExtension(target->fileName, ".ico") &&
+            !((target->platform == ICON_PLATFORM_MACOS) && IsFileExtension(target->fileName, ".icns")))
+        {
+            fprintf(stderr, "WARNING: Output file extension not recognized for output platform, job skipped: %s\n", target->fileName);
+            targetsValid = false;
+        }
+
+        // Set a default name for output in case not provided
+        // NOTE: Additional outputs default names include the platform index: output_{platform}.ico
+        if (target->fileName[0] == '\0')
+        {
+            const char *extension = (target->platform == ICON_PLATFORM_MACOS)? "icns" : "ico";
+
+            if (i == 0) snprintf(target->fileName, 512, "output.%s", extension);
+            else snprintf(target->fileName, 512, "output_%i.%s", target->platform, extension);
+        }
+    }
+
+    // NOTE: Base name is computed on parsing, GetFileNameWithoutExt() is not thread-safe
+    if (strcmp(job->targets[0].fileName, "-") == 0) strcpy(job->outBaseName, "output");
+    else strncpy(job->outBaseName, GetFileNameWithoutExt(job->targets[0].fileName), 255);
+
+    return ((job->inputFilesCount > 0) && targetsValid);
+}
+
+// Unload icon pack job data (input file names)
+static void UnloadIconPackJob(IconPackJob *job)
+{
+    for (int i = 0; i < job->inputFilesCount; i++) RL_FREE(job->inputFiles[i]);    // Free input file name memory
+    RL_FREE(job->inputFiles);           // Free input file names array memory
+    RL_FREE(job->inputData);            // Free standard input data memory
+    RL_FREE(job->stats.sizes);          // Free output sizes stats memory
+    RL_FREE(job->infoText);             // Free progress info text memory
+
+    job->inputFiles = NULL;
+    job->inputFilesCount = 0;
+    job->inputData = NULL;
+    job->inputDataSize = 0;
+    job->stats.sizes = NULL;
+    job->stats.sizesCount = 0;
+    job->infoText = NULL;
+    job->infoTextLength = 0;
+    job->infoTextCapacity = 0;
+}
+
+// Process one icon pack job: load input files, generate requested sizes, save icon files and extract images
+// NOTE: Every job owns its icon bucket, so multiple jobs can be processed in parallel
+// All distinct sizes required by job targets are generated (and encoded) only once into a shared
+// entries pool, every target output file is assembled from pool entries
+static void ProcessIconPackJob(IconPackJob *job)
+{
+    IconBucket jobBucket = { 0 };      // NOTE: Entries allocated on first entries addition
+    IconPackJobStats *stats = &job->stats;
+    double jobStartTime = GetPerformanceTime();
+    double time = 0.0;
+
+    PRINT_JOB_INFO(job, "\nInput files:      %s", job->inputFiles[0]);
+    for (int i = 1; i < job->inputFilesCount; i++) PRINT_JOB_INFO(job, ",%s", job->inputFiles[i]);
+    PRINT_JOB_INFO(job, "\n");
+    for (int i = 0; i < job->targetsCount; i++) PRINT_JOB_INFO(job, "Output file:      %s\n", job->targets[i].fileName);
+    PRINT_JOB_INFO(job, "\n");
+
+    // Generate output sizes list for every target: custom sizes + platform scheme sizes
+    int (*outSizes)[MAX_OUTPUT_SIZES] = (int (*)[MAX_OUTPUT_SIZES])RL_CALLOC(job->targetsCount, sizeof(*outSizes));
+    int outSizesCount[MAX_OUTPUT_TARGETS] = { 0 };
+    int *poolSizes = (int *)RL_CALLOC(job->targetsCount*MAX_OUTPUT_SIZES, sizeof(int));
+    int poolCount = GetIconPackJobSizes(job, outSizes, outSizesCount, poolSizes);
+
+    IconEntry *pool = (poolCount > 0)? (IconEntry *)RL_CALLOC(poolCount, sizeof(IconEntry)) : NULL;
+    for (int i = 0; i < poolCount; i++) pool[i].size = poolSizes[i];
+
+    stats->sizes = (poolCount > 0)? (IconPackSizeStats *)RL_CALLOC(poolCount, sizeof(IconPackSizeStats)) : NULL;
+    stats->sizesCount = poolCount;
+    for (int i = 0; i < poolCount; i++) stats->sizes[i].size = poolSizes[i];
+
+    for (int i = 0; i < job->inputFilesCount; i++) stats->bytesIn += (strcmp(job->inputFiles[i], "-") == 0)? job->inputDataSize : GetFileLength(job->inputFiles[i]);
+
+    // Check disk cache for all pool entries, input files are not loaded if available
+    // NOTE: Cache is not used if images extraction is required, it requires input images
+    unsigned long long cacheKey = 0;
+    bool cached = false;
+
+    if ((job->cacheDir[0] != '\0') && (poolCount > 0))
+    {
+        cacheKey = ComputeIconPackJobKey(job, poolSizes, poolCount);
+
+        if (!job->extractAll && !job->extractSize)
+        {
+            cached = LoadIconPackJobCache(job, cacheKey, pool, poolCount);
+            stats->cached = cached;
+
+            if (cached)
+            {
+                for (int i = 0; i < poolCount; i++) stats->sizes[i].source = 2;
+
+                PRINT_JOB_INFO(job, " > PROCESSING OUTPUT FILE (CACHED)\n\n");
+                for (int i = 0; i < poolCount; i++) PRINT_JOB_INFO(job, " > Size %i: LOADED from cache.\n", pool[i].size);
+                PRINT_JOB_INFO(job, "\n");
+            }
+            else
+            {
+                // NOTE: Partially loaded entries are discarded, all of them are generated
+                for (int i = 0; i < poolCount; i++)
+                {
+                    UnloadIconEntryCache(&pool[i]);
+                    memset(&pool[i], 0, sizeof(IconEntry));
+                    pool[i].size = poolSizes[i];
+                }
+            }
+        }
+    }
+
+    if (!cached)
+    {
+        PRINT_JOB_INFO(job, " > PROCESSING INPUT FILES\n");
+
+        time = GetPerformanceTime();
+
+        // Load input files (all of them) into bucket,
+        // NOTE: If one size has been previously loaded, it is overriden
+        for (int i = 0; i < job->inputFilesCount; i++)
+        {
+            if (strcmp(job->inputFiles[i], "-") == 0)
+            {
+                const char *fileType = GetIconFileDataType(job->inputData, job->inputDataSize);
+
+                if (fileType != NULL) AddIconDataToBucket(&jobBucket, job->inputData, job->inputDataSize, fileType);
+                else fprintf(stderr, "WARNING: Standard input data format not recognized\n");
+            }
+            else AddIconToBucket(&jobBucket, job->inputFiles[i]);
+
+            PRINT_JOB_INFO(job, "\nInput file: %s - Added to icon bucket - Total files: %i\n", job->inputFiles[i], jobBucket.count);
+        }
+
+        stats->decodeTime = GetPerformanceTime() - time;
+
+        if (jobBucket.count == 0)
+        {
+            fprintf(stderr, "WARNING: No valid input images loaded\n");
+            stats->failed = true;
+            stats->totalTime = GetPerformanceTime() - jobStartTime;
+            RL_FREE(jobBucket.entries);
+            RL_FREE(pool);
+            RL_FREE(poolSizes);
+            RL_FREE(outSizes);
+            return;
+        }
+
+        // Get bigger available input image in bucket (bucket is sorted by size, descending)
+        int biggerSizeIndex = 0;
+        int biggerSize = jobBucket.entries[0].size;
+
+        PRINT_JOB_INFO(job, "\nAll input images processed.\n");
+        PRINT_JOB_INFO(job, "Image sizes added to the bucket: %i (%i", jobBucket.count, jobBucket.entries[0].size);
+        for (int i = 1; i < jobBucket.count; i++) PRINT_JOB_INFO(job, ",%i", jobBucket.entries[i].size);
+        PRINT_JOB_INFO(job, ")\n");
+        PRINT_JOB_INFO(job, "Biggest size available: %i\n\n", biggerSize);
+
+        PRINT_JOB_INFO(job, " > PROCESSING OUTPUT FILE\n\n");
+
+        if (poolCount > 0)
+        {
+            PRINT_JOB_INFO(job, "Output sizes requested: %i", poolSizes[0]);
+            for (int i = 1; i < poolCount; i++) PRINT_JOB_INFO(job, ",%i", poolSizes[i]);
+            PRINT_JOB_INFO(job, "\n");
+
+            // Generate custom sizes if required, use biggest available input size and use provided scale algorythm
+            int *genSizes = (int *)RL_CALLOC(poolCount, sizeof(int));       // Sizes to generate (not available in bucket)
+            int *genIndices = (int *)RL_CALLOC(poolCount, sizeof(int));     // Pool index for every size to generate
+            int genCount = 0;
+
+            // Copy from inputPack or generate if required
+            for (int i = 0; i < poolCount; i++)
+            {
+                // Check input pack for size to copy
+                int j = FindIconBucketEntry(jobBucket, pool[i].size, NULL);
+
+                if (j >= 0)
+                {
+                    PRINT_JOB_INFO(job, " > Size %i: COPIED from input images.\n", pool[i].size);
+
+                    // NOTE: Input image and text are copied, source PNG data (if available) is written as is
+                    pool[i].image = jobBucket.entries[j].image;
+                    memcpy(pool[i].text, jobBucket.entries[j].text, MAX_IMAGE_TEXT_SIZE);
+                    CopyIconEntryCache(&pool[i], jobBucket.entries[j]);
+                    pool[i].valid = true;
+                }
+
+                // Generate image size if not copied
+                if (!pool[i].valid)
+                {
+                    PRINT_JOB_INFO(job, " > Size %i: GENERATED from input bigger image (%i).\n", pool[i].size, biggerSize);
+                    stats->sizes[i].source = 1;
+                    genSizes[genCount] = pool[i].size;
+                    genIndices[genCount] = i;
+                    genCount++;
+                }
+            }
+
+            // Generate all missing sizes at once from bigger image
+            if (genCount > 0)
+            {
+                Image *genImages = (Image *)RL_CALLOC(genCount, sizeof(Image));
+
+                // NOTE: Bigger image decoding (if not decoded yet) is considered input decoding time
+                time = GetPerformanceTime();
+                LoadIconEntryImage(&jobBucket.entries[biggerSizeIndex]);
+                stats->decodeTime += GetPerformanceTime() - time;
+
+                time = GetPerformanceTime();
+                int threadCount = (job->exportOptions.threadCount > 0)? job->exportOptions.threadCount : GetProcessorCount();
+                GenerateIconSizes(jobBucket.entries[biggerSizeIndex].image, genSizes, genCount, job->scaleAlgorythm, threadCount, genImages);
+                stats->resizeTime = GetPerformanceTime() - time;
+
+                for (int i = 0; i < genCount; i++)
+                {
+                    pool[genIndices[i]].image = genImages[i];
+                    pool[genIndices[i]].generated = true;
+                    pool[genIndices[i]].valid = true;
+                }
+
+                RL_FREE(genImages);
+            }
+
+            RL_FREE(genSizes);
+            RL_FREE(genIndices);
+
+            PRINT_JOB_INFO(job, "\n");
+
+            // Encode all pool entries at once (in parallel), encoded data is cached in pool entries
+            // NOTE: Entries only saved as DIB (.ico) are not encoded, they are temporarily set as not valid,
+            // PNG data is always required for .icns outputs and disk cache
+            char **pngDataPtrs = (char **)RL_CALLOC(poolCount, sizeof(char *));
+            int *pngDataSizes = (int *)RL_CALLOC(poolCount, sizeof(int));
+            double *encodeTimes = (double *)RL_CALLOC(poolCount, sizeof(double));
+            bool *dibEntries = (bool *)RL_CALLOC(poolCount, sizeof(bool));
+
+            bool pngRequired = (job->cacheDir[0] != '\0');
+            for (int t = 0; t < job->targetsCount; t++) if (job->targets[t].platform == ICON_PLATFORM_MACOS) pngRequired = true;
+
+            for (int i = 0; i < poolCount; i++)
+            {
+                if (!pngRequired && pool[i].valid && (pool[i].size <= job->exportOptions.dibMaxSize))
+                {
+                    dibEntries[i] = true;
+                    pool[i].valid = false;
+                }
+            }
+
+            time = GetPerformanceTime();
+            ExportIconEntriesToMemory(pool, poolCount, job->exportOptions, pngDataPtrs, pngDataSizes, encodeTimes);
+            stats->encodeTime = GetPerformanceTime() - time;
+
+            for (int i = 0, k = 0; i < poolCount; i++) if (pool[i].valid) { stats->sizes[i].encodeTime = encodeTimes[k]; k++; }
+            for (int i = 0; i < poolCount; i++) if (dibEntries[i]) pool[i].valid = true;
+
+            RL_FREE(pngDataPtrs);
+            RL_FREE(pngDataSizes);
+            RL_FREE(encodeTimes);
+            RL_FREE(dibEntries);
+        }
+        else fprintf(stderr, "WARNING: No output sizes defined\n");
+    }
+
+    // Save every target icon file from pool entries
+    // NOTE: Target entries are shallow copies of pool entries, encoded data cache is valid
+    // for job export options, so it's written as is and it's only owned by pool entries
+    time = GetPerformanceTime();
+
+    // NOTE: Entries saved as DIB into .ico outputs are considered by their DIB data size
+    bool dibTarget = false;
+    for (int t = 0; t < job->targetsCount; t++) if (job->targets[t].platform != ICON_PLATFORM_MACOS) dibTarget = true;
+
+    for (int i = 0; i < poolCount; i++)
+    {
+        stats->sizes[i].bytesIn = pool[i].size*pool[i].size*4;
+        if (!pool[i].valid) stats->sizes[i].bytesOut = 0;
+        else if (dibTarget && (pool[i].size <= job->exportOptions.dibMaxSize)) stats->sizes[i].bytesOut = GetIconEntryDIBSize(pool[i].size);
+        else stats->sizes[i].bytesOut = pool[i].pngDataSize;
+    }
+
+    if (poolCount > 0)
+    {
+        SaveIconPackJobTargets(job, pool, outSizes, outSizesCount, false);
+
+        // Save encoded entries to disk cache for next runs
+        if (!cached && (job->cacheDir[0] != '\0')) SaveIconPackJobCache(job, cacheKey, pool, poolCount);
+    }
+
+    // Extract required entries: all or provided sizes (only available ones)
+    // NOTE: Extracted file names are composed locally, TextFormat() is not thread-safe
+    char imageFileName[512] = { 0 };
+
+    // Extracted images can be packed into one zip archive: {output}.zip
+    // NOTE: One zip writer session is used for all images, central directory is only written once
+    mz_zip_archive zip = { 0 };
+    mz_zip_archive *extractZip = NULL;
+
+    if (job->extractZip && (job->extractAll || job->extractSize))
+    {
+        snprintf(imageFileName, 512, "%s.zip", job->outBaseName);
+
+        if (mz_zip_writer_init_file(&zip, imageFileName, 0))
+        {
+            PRINT_JOB_INFO(job, " > Images extract archive: %s\n", imageFileName);
+            extractZip = &zip;
+        }
+        else fprintf(stderr, "WARNING: Zip file could not be created: %s\n", imageFileName);
+    }
+
+    if (job->extractAll)
+    {
+        // Extract all input pack entries
+        for (int i = 0; i < jobBucket.count; i++)
+        {
+            snprintf(imageFileName, 512, "%s_%ix%i.png", job->outBaseName, jobBucket.entries[i].size, jobBucket.entries[i].size);
+            PRINT_JOB_INFO(job, " > Image extract requested (%i): %s\n", jobBucket.entries[i].size, imageFileName);
+            SaveIconEntryToPNG(jobBucket.entries[i], imageFileName, job->exportOptions, extractZip);
+        }
+    }
+    else if (job->extractSize)
+    {
+        // Extract requested sizes from pack (if available)
+        for (int i = 0; i < jobBucket.count; i++)
+        {
+            for (int j = 0; j < job->extractSizesCount; j++)
+            {
+                if (jobBucket.entries[i].size == job->extractSizes[j])
+                {
+                    snprintf(imageFileName, 512, "%s_%ix%i.png", job->outBaseName, jobBucket.entries[i].size, jobBucket.entries[i].size);
+                    PRINT_JOB_INFO(job, " > Image extract requested (%i): %s\n", job->extractSizes[j], imageFileName);
+                    SaveIconEntryToPNG(jobBucket.entries[i], imageFileName, job->exportOptions, extractZip);
+                }
+            }
+        }
+
+        // Extract requested sizes from generated entries pool (if available)
+        // NOTE: Only generated entries, copied ones have been already extracted from input images
+        for (int i = 0; i < poolCount; i++)
+        {
+            for (int j = 0; j < job->extractSizesCount; j++)
+            {
+                if (pool[i].generated && (job->extractSizes[j] > 0) && (pool[i].size == job->extractSizes[j]))
+                {
+                    snprintf(imageFileName, 512, "%s_%ix%i.png", job->outBaseName, pool[i].size, pool[i].size);
+                    PRINT_JOB_INFO(job, " > Image extract requested (%i): %s\n", job->extractSizes[j], imageFileName);
+                    SaveIconEntryToPNG(pool[i], imageFileName, job->exportOptions, extractZip);
+                }
+            }
+        }
+    }
+
+    if (extractZip != NULL)
+    {
+        if (!mz_zip_writer_finalize_archive(extractZip)) fprintf(stderr, "WARNING: Zip file could not be finalized\n");
+        mz_zip_writer_end(extractZip);
+    }
+
+    stats->writeTime = GetPerformanceTime() - time;
+
+    // Memory cleaning
+    for (int i = 0; i < poolCount; i++)
+    {
+        if (pool[i].generated) UnloadImage(pool[i].image);
+        UnloadIconEntryCache(&pool[i]);
+    }
+    RL_FREE(pool);
+    RL_FREE(poolSizes);
+    RL_FREE(outSizes);
+
+    ClearIconBucket(&jobBucket);
+    RL_FREE(jobBucket.entries);
+
+    stats->totalTime = GetPerformanceTime() - jobStartTime;
+}
+
+// Process icon pack job from jobs array (parallel task)
+// NOTE: Job progress info is buffered and printed at once when job finishes, so parallel jobs
+// progress info is not interleaved (standard output stream is locked by every stdio call)
+static void ProcessIconPackJobTask(void *userData, int index)
+{
+    IconPackJob *job = &((IconPackJob *)userData)[index];
+
+    job->infoBuffered = true;
+    ProcessIconPackJob(job);
+
+    if (job->infoText != NULL) fputs(job->infoText, stdout);
+}
+
+// Append formatted text to icon pack job progress info buffer
+// NOTE: Buffer grows as required, raylib TextFormat() is not used (not thread-safe)
+static void AppendIconPackJobInfo(IconPackJob *job, const char *format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(NULL, 0, format, args);
+    va_end(args);
+
+    if (length <= 0) return;
+
+    if ((job->infoTextLength + length + 1) > job->infoTextCapacity)
+    {
+        int capacity = (job->infoTextCapacity > 0)? job->infoTextCapacity*2 : 1024;
+        while (capacity < (job->infoTextLength + length + 1)) capacity *= 2;
+
+        char *infoText = (char *)RL_REALLOC(job->infoText, capacity);
+        if (infoText == NULL) return;
+
+        job->infoText = infoText;
+        job->infoTextCapacity = capacity;
+    }
+
+    va_start(args, format);
+    vsnprintf(job->infoText + job->infoTextLength, length + 1, format, args);
+    va_end(args);
+
+    job->infoTextLength += length;
+}
+
+// Process icon pack job in watch mode: build output files and rebuild them when input files change
+// NOTE: Job bucket and entries pool are kept between rebuilds, only changed input files (and input files
+// providing the same sizes) are reloaded, generated sizes are only regenerated if bigger input image is reloaded
+// and entries encoded data is reused if entry image is unchanged, output files are replaced atomically
+// Watching finishes when process is interrupted (Ctrl+C), disk cache and images extraction are not used
+static void ProcessIconPackWatch(IconPackJob *job)
+{
+    IconBucket jobBucket = { 0 };      // NOTE: Entries allocated on first entries addition
+
+    PRINT_INFO("\nInput files:      %s", job->inputFiles[0]);
+    for (int i = 1; i < job->inputFilesCount; i++) PRINT_INFO(",%s", job->inputFiles[i]);
+    PRINT_INFO("\n");
+    for (int i = 0; i < job->targetsCount; i++) PRINT_INFO("Output file:      %s\n", job->targets[i].fileName);
+    PRINT_INFO("\n");
+
+    int (*outSizes)[MAX_OUTPUT_SIZES] = (int (*)[MAX_OUTPUT_SIZES])RL_CALLOC(job->targetsCount, sizeof(*outSizes));
+    int outSizesCount[MAX_OUTPUT_TARGETS] = { 0 };
+    int *poolSizes = (int *)RL_CALLOC(job->targetsCount*MAX_OUTPUT_SIZES, sizeof(int));
+    int poolCount = GetIconPackJobSizes(job, outSizes, outSizesCount, poolSizes);
+
+    if (poolCount == 0)
+    {
+        fprintf(stderr, "WARNING: No output sizes defined\n");
+        RL_FREE(poolSizes);
+        RL_FREE(outSizes);
+        return;
+    }
+
+    IconEntry *pool = (IconEntry *)RL_CALLOC(poolCount, sizeof(IconEntry));
+    for (int i = 0; i < poolCount; i++) pool[i].size = poolSizes[i];
+
+    IconWatchInput *inputs = (IconWatchInput *)RL_CALLOC(job->inputFilesCount, sizeof(IconWatchInput));
+    bool *changed = (bool *)RL_CALLOC(job->inputFilesCount, sizeof(bool));
+    bool *dibEntries = (bool *)RL_CALLOC(poolCount, sizeof(bool));
+    char **pngDataPtrs = (char **)RL_CALLOC(poolCount, sizeof(char *));
+    int *pngDataSizes = (int *)RL_CALLOC(poolCount, sizeof(int));
+    double *encodeTimes = (double *)RL_CALLOC(poolCount, sizeof(double));
+
+    // NOTE: Entries only saved as DIB (.ico) are not encoded, PNG data is always required for .icns outputs
+    bool pngRequired = false;
+    for (int t = 0; t < job->targetsCount; t++) if (job->targets[t].platform == ICON_PLATFORM_MACOS) pngRequired = true;
+
+    int threadCount = (job->exportOptions.threadCount > 0)? job->exportOptions.threadCount : GetProcessorCount();
+    int biggerSize = 0;
+
+    // First build loads all input files
+    FilesWatcher watcher = { 0 };
+    InitFilesWatcher(&watcher, (const char **)job->inputFiles, job->inputFilesCount);
+    for (int i = 0; i < job->inputFilesCount; i++) changed[i] = true;
+    int changedCount = job->inputFilesCount;
+
+    watchExitRequested = 0;
+    signal(SIGINT, WatchSignalHandler);
+
+    while (!watchExitRequested)
+    {
+        if (changedCount > 0)
+        {
+            double time = GetPerformanceTime();
+
+            // Reload changed input files contribution to job bucket
+            int *affectedSizes = NULL;
+            int affectedCount = UpdateIconPackWatchBucket(job, &jobBucket, inputs, changed, &affectedSizes);
+
+            if (jobBucket.count == 0) fprintf(stderr, "WARNING: No valid input images loaded\n");
+            else if (affectedCount > 0)
+            {
+                // Bigger image reloaded (or replaced by a new bigger one), generated sizes must be regenerated
+                bool regenerate = (jobBucket.entries[0].size != biggerSize);
+                for (int k = 0; k < affectedCount; k++) if (affectedSizes[k] == jobBucket.entries[0].size) regenerate = true;
+                biggerSize = jobBucket.entries[0].size;
+
+                int *genSizes = (int *)RL_CALLOC(poolCount, sizeof(int));
+                int *genIndices = (int *)RL_CALLOC(poolCount, sizeof(int));
+                int genCount = 0;
+
+                for (int i = 0; i < poolCount; i++)
+                {
+                    int j = FindIconBucketEntry(jobBucket, pool[i].size, NULL);
+
+                    bool affected = false;
+                    for (int k = 0; k < affectedCount; k++) if (affectedSizes[k] == pool[i].size) affected = true;
+
+                    if (j >= 0)
+                    {
+                        // NOTE: Bucket entries could be moved on bucket update, image is always copied again,
+                        // encoded data is only copied again if bucket entry has been reloaded, previous encoded data
+                        // is reused if bucket entry provides no encoded data and reloaded image is unchanged
+                        if (pool[i].generated)
+                        {
+                            UnloadImage(pool[i].image);
+                            pool[i].generated = false;
+                            affected = true;
+                        }
+
+                        pool[i].image = jobBucket.entries[j].image;
+                        memcpy(pool[i].text, jobBucket.entries[j].text, MAX_IMAGE_TEXT_SIZE);
+
+                        if (affected && ((jobBucket.entries[j].pngData != NULL) || pool[i].pngDataSource))
+                        {
+                            UnloadIconEntryCache(&pool[i]);
+                            CopyIconEntryCache(&pool[i], jobBucket.entries[j]);
+                        }
+                    }
+                    else if (regenerate || !pool[i].generated)
+                    {
+                        // NOTE: Previous encoded data is kept, it's reused if generated image is unchanged
+                        genSizes[genCount] = pool[i].size;
+                        genIndices[genCount] = i;
+                        genCount++;
+                    }
+
+                    pool[i].valid = true;
+                }
+
+                if (genCount > 0)
+                {
+                    Image *genImages = (Image *)RL_CALLOC(genCount, sizeof(Image));
+
+                    LoadIconEntryImage(&jobBucket.entries[0]);
+                    GenerateIconSizes(jobBucket.entries[0].image, genSizes, genCount, job->scaleAlgorythm, threadCount, genImages);
+
+                    for (int i = 0; i < genCount; i++)
+                    {
+                        // NOTE: Copied image (if any) is owned by job bucket, it's not unloaded,
+                        // previously copied entry encoded data is discarded
+                        if (pool[genIndices[i]].generated) UnloadImage(pool[genIndices[i]].image);
+                        else
+                        {
+                            UnloadIconEntryCache(&pool[genIndices[i]]);
+                            memset(pool[genIndices[i]].text, 0, MAX_IMAGE_TEXT_SIZE);
+                        }
+
+                        pool[genIndices[i]].image = genImages[i];
+                        pool[genIndices[i]].generated = true;
+                    }
+
+                    RL_FREE(genImages);
+                }
+
+                RL_FREE(genSizes);
+                RL_FREE(genIndices);
+
+                // Encode pool entries, only entries with changed images are encoded
+                for (int i = 0; i < poolCount; i++)
+                {
+                    dibEntries[i] = (!pngRequired && (pool[i].size <= job->exportOptions.dibMaxSize));
+                    if (dibEntries[i]) pool[i].valid = false;
+                }
+
+                int validCount = ExportIconEntriesToMemory(pool, poolCount, job->exportOptions, pngDataPtrs, pngDataSizes, encodeTimes);
+
+                int encodedCount = 0;
+                for (int i = 0; i < validCount; i++) if (encodeTimes[i] > 0.0) encodedCount++;
+                for (int i = 0; i < poolCount; i++) if (dibEntries[i]) pool[i].valid = true;
+
+                SaveIconPackJobTargets(job, pool, outSizes, outSizesCount, true);
+
+                PRINT_INFO(" > Output files updated: %i input files changed, %i sizes generated, %i sizes encoded (%.1f ms)\n",
+                           changedCount, genCount, encodedCount, (GetPerformanceTime() - time)*1000.0);
+                if (!quietMode) fflush(stdout);
+            }
+
+            RL_FREE(affectedSizes);
+        }
+
+        changedCount = WaitFilesWatcherChanges(&watcher, changed, WATCH_WAIT_TIMEOUT);
+    }
+
+    signal(SIGINT, SIG_DFL);
+    PRINT_INFO("\nWatch mode finished\n");
+
+    UnloadFilesWatcher(&watcher);
+
+    // Memory cleaning
+    for (int i = 0; i < poolCount; i++)
+    {
+        if (pool[i].generated) UnloadImage(pool[i].image);
+        UnloadIconEntryCache(&pool[i]);
+    }
+
+    for (int i = 0; i < job->inputFilesCount; i++) RL_FREE(inputs[i].sizes);
+
+    RL_FREE(inputs);
+    RL_FREE(changed);
+    RL_FREE(dibEntries);
+    RL_FREE(pngDataPtrs);
+    RL_FREE(pngDataSizes);
+    RL_FREE(encodeTimes);
+    RL_FREE(pool);
+    RL_FREE(poolSizes);
+    RL_FREE(outSizes);
+
+    ClearIconBucket(&jobBucket);
+    RL_FREE(jobBucket.entries);
+}
+
+// Update watch mode job bucket with changed input files
+// NOTE: Changed input files are reloaded (AddIconToBucket()) into their own bucket and any other input file
+// providing the same sizes (previously or now) is also reloaded, affected sizes are removed from job bucket
+// and reloaded files entries are added in input files order, so same size entries replacement order is kept
+// Input files that can not be loaded (i.e. file still being written) keep their previous entries
+// Returns affected sizes count, affected sizes list is allocated and must be freed by caller
+static int UpdateIconPackWatchBucket(IconPackJob *job, IconBucket *jobBucket, IconWatchInput *inputs, const bool *changed, int **affectedSizes)
+{
+    int count = job->inputFilesCount;
+    bool *reloaded = (bool *)RL_CALLOC(count, sizeof(bool));
+    int *affected = NULL;
+    int affectedCount = 0;
+
+    for (int i = 0; i < count; i++)
+    {
+        if (changed[i])
+        {
+            AddIconToBucket(&inputs[i].bucket, job->inputFiles[i]);
+
+            if (inputs[i].bucket.count > 0) reloaded[i] = true;
+            else fprintf(stderr, "WARNING: Input file could not be loaded, previous images kept: %s\n", job->inputFiles[i]);
+        }
+    }
+
+    // Add input files providing affected sizes to reloaded files, until no more files are added
+    bool updated = true;
+
+    while (updated)
+    {
+        updated = false;
+
+        // Affected sizes: previous and new sizes of every reloaded input file
+        int capacity = 0;
+        for (int i = 0; i < count; i++) if (reloaded[i]) capacity += (inputs[i].sizesCount + inputs[i].bucket.count);
+
+        RL_FREE(affected);
+        affected = (int *)RL_CALLOC((capacity > 0)? capacity : 1, sizeof(int));
+        affectedCount = 0;
+
+        for (int i = 0; i < count; i++)
+        {
+            if (!reloaded[i]) continue;
+
+            for (int j = 0; j < (inputs[i].sizesCount + inputs[i].bucket.count); j++)
+            {
+                int size = (j < inputs[i].sizesCount)? inputs[i].sizes[j] : inputs[i].bucket.entries[j - inputs[i].sizesCount].size;
+
+                int k = 0;
+                while ((k < affectedCount) && (affected[k] != size)) k++;
+                if (k == affectedCount) { affected[affectedCount] = size; affectedCount++; }
+            }
+        }
+
+        for (int i = 0; i < count; i++)
+        {
+            if (reloaded[i]) continue;
+
+            for (int j = 0; (j < inputs[i].sizesCount) && !reloaded[i]; j++)
+            {
+                for (int k = 0; k < affectedCount; k++)
+                {
+                    if (inputs[i].sizes[j] == affected[k])
+                    {
+                        AddIconToBucket(&inputs[i].bucket, job->inputFiles[i]);
+                        reloaded[i] = true;
+                        updated = true;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    for (int k = 0; k < affectedCount; k++) RemoveIconFromBucket(jobBucket, affected[k]);
+
+    // Move reloaded input files entries to job bucket, in input files order
+    // NOTE: Job bucket takes ownership of entries, input file bucket is emptied
+    for (int i = 0; i < count; i++)
+    {
+        if (!reloaded[i]) continue;
+
+        RL_FREE(inputs[i].sizes);
+        inputs[i].sizes = (inputs[i].bucket.count > 0)? (int *)RL_CALLOC(inputs[i].bucket.count, sizeof(int)) : NULL;
+        inputs[i].sizesCount = inputs[i].bucket.count;
+        for (int j = 0; j < inputs[i].bucket.count; j++) inputs[i].sizes[j] = inputs[i].bucket.entries[j].size;
+
+        AddIconEntriesToBucket(jobBucket, inputs[i].bucket.entries, inputs[i].bucket.count);
+        RL_FREE(inputs[i].bucket.entries);
+        inputs[i].bucket = (IconBucket){ 0 };
+
+        PRINT_INFO("Input file: %s - Loaded into icon bucket - Total sizes: %i\n", job->inputFiles[i], jobBucket->count);
+    }
+
+    RL_FREE(reloaded);
+
+    *affectedSizes = affected;
+
+    return affectedCount;
+}
+
+// Watch mode interruption signal handler
+static void WatchSignalHandler(int signal)
+{
+    (void)signal;
+    watchExitRequested = 1;
+}
+
+// Get icon pack job output sizes for every target (custom sizes + platform scheme sizes) and unique pool sizes
+// NOTE: Target sizes are kept in requested order, pool sizes are unique, returns pool sizes count
+static int GetIconPackJobSizes(IconPackJob *job, int (*outSizes)[MAX_OUTPUT_SIZES], int *outSizesCount, int *poolSizes)
+{
+    int poolCount = 0;
+
+    for (int t = 0; t < job->targetsCount; t++)
+    {
+        for (int i = 0; i < job->outSizesCount; i++) outSizes[t][i] = job->outSizes[i];
+        outSizesCount[t] = job->outSizesCount;
+
+        int platformSizesCount = 0;
+        unsigned int *platformSizes = GetPlatformSizes(job->targets[t].platform, &platformSizesCount);
+
+        for (int i = 0; (i < platformSizesCount) && (outSizesCount[t] < MAX_OUTPUT_SIZES); i++) { outSizes[t][outSizesCount[t]] = platformSizes[i]; outSizesCount[t]++; }
+
+        for (int i = 0; i < outSizesCount[t]; i++)
+        {
+            int k = 0;
+            while ((k < poolCount) && (poolSizes[k] != outSizes[t][i])) k++;
+            if (k == poolCount) { poolSizes[poolCount] = outSizes[t][i]; poolCount++; }
+        }
+    }
+
+    return poolCount;
+}
+
+// Save every icon pack job target icon file from pool entries
+// NOTE: Target entries are shallow copies of pool entries, only valid entries are exported,
+// on atomic saving, every target is saved into a temporary file that replaces target file once completed
+// Job is set as failed if any target could not be saved
+static void SaveIconPackJobTargets(IconPackJob *job, IconEntry *pool, int (*outSizes)[MAX_OUTPUT_SIZES], const int *outSizesCount, bool atomic)
+{
+    IconEntry *outPack = (IconEntry *)RL_CALLOC(MAX_OUTPUT_SIZES, sizeof(IconEntry));
+    char tempFileName[520] = { 0 };
+
+    for (int t = 0; t < job->targetsCount; t++)
+    {
+        for (int i = 0; i < outSizesCount[t]; i++)
+        {
+            int k = 0;
+            while (pool[k].size != outSizes[t][i]) k++;
+            outPack[i] = pool[k];
+        }
+
+        // Write standard output target, icon file data is written at once
+        if (strcmp(job->targets[t].fileName, "-") == 0)
+        {
+            int dataSize = 0;
+            char *data = NULL;
+
+            if (job->targets[t].platform == ICON_PLATFORM_MACOS) data = ExportIconPackToICNSMemory(outPack, outSizesCount[t], job->exportOptions, &dataSize);
+            else data = ExportIconPackToICOMemory(outPack, outSizesCount[t], job->exportOptions, &dataSize);
+
+            if (data != NULL)
+            {
+#if defined(_WIN32)
+                _setmode(_fileno(stdout), _O_BINARY);
+#endif
+                if ((fwrite(data, 1, dataSize, stdout) != (size_t)dataSize) || (fflush(stdout) != 0))
+                {
+                    fprintf(stderr, "WARNING: Output file could not be written to standard output\n");
+                    job->stats.failed = true;
+                    job->stats.outputsFailed++;
+                }
+                else job->stats.bytesOut += dataSize;
+
+                RL_FREE(data);
+            }
+            else
+            {
+                job->stats.failed = true;
+                job->stats.outputsFailed++;
+            }
+
+            continue;
+        }
+
+        const char *fileName = job->targets[t].fileName;
+        if (atomic)
+        {
+            snprintf(tempFileName, 520, "%s.tmp", fileName);
+            fileName = tempFileName;
+        }
+
+        // Save into icon file provided pack entries
+        bool saved = false;
+        if (job->targets[t].platform == ICON_PLATFORM_MACOS) saved = SaveIconPackToICNS(outPack, outSizesCount[t], fileName, job->exportOptions);
+        else saved = SaveIconPackToICO(outPack, outSizesCount[t], fileName, job->exportOptions);
+
+        // NOTE: Temporary file is not renamed if it could not be saved, target file is kept
+        if (!saved)
+        {
+            fprintf(stderr, "WARNING: Output file could not be saved: %s\n", job->targets[t].fileName);
+            if (atomic) remove(tempFileName);
+            job->stats.failed = true;
+            job->stats.outputsFailed++;
+        }
+        else if (atomic)
+        {
+            remove(job->targets[t].fileName);   // NOTE: Required by rename() on Windows if file exists
+            if (rename(tempFileName, job->targets[t].fileName) != 0)
+            {
+                fprintf(stderr, "WARNING: Output file could not be replaced: %s\n", job->targets[t].fileName);
+                remove(tempFileName);
+                saved = false;
+                job->stats.failed = true;
+                job->stats.outputsFailed++;
+            }
+        }
+
+        if (saved) job->stats.bytesOut += GetFileLength(job->targets[t].fileName);
+    }
+
+    RL_FREE(outPack);
+}
+
+// Compute icon pack job key for disk cache
+// NOTE: Key considers input files content (in order), output sizes and all options affecting output images,
+// cache version and tool version are also considered, cache entries generated by previous encoder/generator
+// implementations are only invalidated if ICON_CACHE_VERSION is increased along them
+static unsigned long long ComputeIconPackJobKey(IconPackJob *job, const int *outSizes, int outSizesCount)
+{
+    unsigned long long hash = 0xcbf29ce484222325ULL;    // FNV-1a 64bit offset basis
+
+    int cacheVersion = ICON_CACHE_VERSION;
+    hash = ComputeDataHash(&cacheVersion, sizeof(int), hash);
+    hash = ComputeDataHash(toolVersion, (int)strlen(toolVersion), hash);
+
+    for (int i = 0; i < job->inputFilesCount; i++)
+    {
+        bool inputStream = (strcmp(job->inputFiles[i], "-") == 0);
+
+        int dataSize = inputStream? job->inputDataSize : 0;
+        unsigned char *data = inputStream? job->inputData : LoadFileData(job->inputFiles[i], &dataSize);
+
+        hash = ComputeDataHash(&dataSize, sizeof(int), hash);
+        if (data != NULL) hash = ComputeDataHash(data, dataSize, hash);
+
+        if (!inputStream) UnloadFileData(data);
+    }
+
+    int options[5] = { job->scaleAlgorythm, job->exportOptions.compression, job->exportOptions.textChunk, job->exportOptions.paletteMaxSize, outSizesCount };
+    hash = ComputeDataHash(options, sizeof(options), hash);
+    hash = ComputeDataHash(outSizes, outSizesCount*sizeof(int), hash);
+
+    return hash;
+}
+
+// Load icon pack job output entries from disk cache
+// NOTE: Entries only contain encoded PNG data and image size, no image data is loaded,
+// returns false if any of the required entries is not available on cache
+static bool LoadIconPackJobCache(IconPackJob *job, unsigned long long key, IconEntry *outPack, int outPackCount)
+{
+    char cacheFileName[512] = { 0 };
+    bool cached = true;
+
+    for (int i = 0; (i < outPackCount) && cached; i++)
+    {
+        snprintf(cacheFileName, 512, "%s/%016llx_%i.png", job->cacheDir, key, i);
+
+        cached = false;
+        FILE *cacheFile = fopen(cacheFileName, "rb");
+
+        if (cacheFile != NULL)
+        {
+            fseek(cacheFile, 0, SEEK_END);
+            int dataSize = (int)ftell(cacheFile);
+            fseek(cacheFile, 0, SEEK_SET);
+
+            if (dataSize > 0)
+            {
+                unsigned char *data = (unsigned char *)RPNG_MALLOC(dataSize);
+
+                // NOTE: Cached data was encoded with job export options, it's not source data
+                if ((fread(data, 1, dataSize, cacheFile) == (size_t)dataSize) && SetIconEntrySourceData(&outPack[i], data, dataSize))
+                {
+                    outPack[i].pngDataSource = false;
+                    outPack[i].pngDataKey = ComputeIconEntryKey(outPack[i], job->exportOptions);
+                    outPack[i].valid = true;
+                    cached = true;
+                }
+                else RPNG_FREE(data);
+            }
+
+            fclose(cacheFile);
+        }
+    }
+
+    return cached;
+}
+
+// Save icon pack job output entries to disk cache
+// NOTE: Entries are saved to a temporary file and renamed, so concurrent jobs
+// never read a partially written cache file
+static void SaveIconPackJobCache(IconPackJob *job, unsigned long long key, IconEntry *outPack, int outPackCount)
+{
+    char cacheFileName[512] = { 0 };
+    char tempFileName[512] = { 0 };
+
+    for (int i = 0; i < outPackCount; i++)
+    {
+        if (!outPack[i].valid || (outPack[i].pngData == NULL)) continue;
+
+        snprintf(cacheFileName, 512, "%s/%016llx_%i.png", job->cacheDir, key, i);
+        snprintf(tempFileName, 512, "%s.%p.tmp", cacheFileName, (void *)job);
+
+        if (SaveFileData(tempFileName, outPack[i].pngData, outPack[i].pngDataSize))
+        {
+            remove(cacheFileName);  // NOTE: Required by rename() on Windows if file exists
+            if (rename(tempFileName, cacheFileName) != 0) remove(tempFileName);
+        }
+        else fprintf(stderr, "WARNING: Cache file could not be saved: %s\n", cacheFileName);
+    }
+}
+
+// Save icon pack job stats into report file (JSON), one object per job
+// NOTE: Jobs are separated by commas, index is required to know if job is the first one
+static void SaveIconPackJobReport(FILE *reportFile, IconPackJob *job, int index)
+{
+    static const char *sourceNames[3] = { "copied", "generated", "cached" };
+    IconPackJobStats *stats = &job->stats;
+
+    long long rawBytes = 0;
+    long long encodedBytes = 0;
+    for (int i = 0; i < stats->sizesCount; i++) { rawBytes += stats->sizes[i].bytesIn; encodedBytes += stats->sizes[i].bytesOut; }
+
+    fprintf(reportFile, "%s\n    {\n      \"inputs\": [", (index > 0)? "," : "");
+    for (int i = 0; i < job->inputFilesCount; i++)
+    {
+        if (i > 0) fprintf(reportFile, ", ");
+        SaveReportString(reportFile, job->inputFiles[i]);
+    }
+    fprintf(reportFile, "],\n      \"outputs\": [");
+    for (int i = 0; i < job->targetsCount; i++)
+    {
+        if (i > 0) fprintf(reportFile, ", ");
+        SaveReportString(reportFile, job->targets[i].fileName);
+    }
+    fprintf(reportFile, "],\n");
+
+    fprintf(reportFile, "      \"failed\": %s,\n      \"outputsFailed\": %i,\n      \"cached\": %s,\n", stats->failed? "true" : "false", stats->outputsFailed, stats->cached? "true" : "false");
+    fprintf(reportFile, "      \"decodeMs\": %.3f,\n      \"resizeMs\": %.3f,\n      \"encodeMs\": %.3f,\n      \"writeMs\": %.3f,\n      \"totalMs\": %.3f,\n",
+        stats->decodeTime*1000.0, stats->resizeTime*1000.0, stats->encodeTime*1000.0, stats->writeTime*1000.0, stats->totalTime*1000.0);
+    // NOTE: Job bytes in/out are input/output files sizes, encode ratio is computed from output sizes raw/encoded data,
+    // same as sizes compression ratio, input files could be already encoded and output files contain headers and DIB data
+    fprintf(reportFile, "      \"bytesIn\": %lld,\n      \"bytesOut\": %lld,\n      \"encodeRatio\": %.3f,\n",
+        stats->bytesIn, stats->bytesOut, (encodedBytes > 0)? (double)rawBytes/encodedBytes : 0.0);
+
+    fprintf(reportFile, "      \"sizes\": [");
+    for (int i = 0; i < stats->sizesCount; i++)
+    {
+        IconPackSizeStats *size = &stats->sizes[i];
+
+        fprintf(reportFile, "%s\n        { \"size\": %i, \"source\": \"%s\", \"encodeMs\": %.3f, \"bytesIn\": %i, \"bytesOut\": %i, \"compressionRatio\": %.3f }",
+            (i > 0)? "," : "", size->size, sourceNames[size->source], size->encodeTime*1000.0, size->bytesIn, size->bytesOut,
+            (size->bytesOut > 0)? (double)size->bytesIn/size->bytesOut : 0.0);
+    }
+    fprintf(reportFile, "%s]\n    }", (stats->sizesCount > 0)? "\n      " : "");
+}
+
+// Save text as JSON string into report file
+// NOTE: Quotes, backslashes (Windows paths) and control characters are escaped
+static void SaveReportString(FILE *reportFile, const char *text)
+{
+    fputc('"', reportFile);
+
+    for (const unsigned char *c = (const unsigned char *)text; *c != '\0'; c++)
+    {
+        if ((*c == '"') || (*c == '\\')) { fputc('\\', reportFile); fputc(*c, reportFile); }
+        else if (*c < 0x20) fprintf(reportFile, "\\u%04x", *c);
+        else fputc(*c, reportFile);
+    }
+
+    fputc('"', reportFile);
+}
+
+// Load all standard input data (binary mode)
+// NOTE: Standard input size is not known in advance, data buffer grows as required
+static unsigned char *LoadStandardInputData(int *dataSize)
+{
+    #define STDIN_DATA_CHUNK_SIZE   65536   // Standard input data buffer grow size
+
+#if defined(_WIN32)
+    _setmode(_fileno(stdin), _O_BINARY);
+#endif
+
+    int capacity = STDIN_DATA_CHUNK_SIZE;
+    int size = 0;
+    unsigned char *data = (unsigned char *)RL_MALLOC(capacity);
+
+    while (data != NULL)
+    {
+        size += (int)fread(data + size, 1, capacity - size, stdin);
+
+        if (size < capacity) break;     // End of data (or read error)
+
+        capacity *= 2;
+        unsigned char *newData = (unsigned char *)RL_REALLOC(data, capacity);
+        if (newData == NULL) { RL_FREE(data); data = NULL; }
+        else data = newData;
+    }
+
+    if ((data != NULL) && (size == 0)) { RL_FREE(data); data = NULL; }
+    if (data == NULL) { fprintf(stderr, "WARNING: No data available on standard input\n"); size = 0; }
+
+    *dataSize = size;
+    return data;
+}
+
+// Compare benchmark samples (qsort() callback)
+static int CompareBenchmarkSamples(const void *a, const void *b)
+{
+    double sa = *(const double *)a;
+    double sb = *(const double *)b;
+
+    return (sa > sb) - (sa < sb);
+}
+
+// Print benchmark stage results: latencies percentiles and throughput
+// NOTE: Samples are sorted, throughput is computed from median latency,
+// pixels or bytes per run can be 0 if not meaningful for the stage
+static void PrintBenchmarkResult(const char *stage, int size, double *samples, int count, double pixels, double bytes)
+{
+    qsort(samples, count, sizeof(double), CompareBenchmarkSamples);
+
+    double p50 = samples[(count - 1)/2];
+    double p99 = samples[(int)ceil(0.99*count) - 1];
+    char sizeText[16] = { 0 };
+    char pixelsText[16] = { 0 };
+    char bytesText[16] = { 0 };
+
+    if (size > 0) snprintf(sizeText, 16, "%i", size);
+    else strcpy(sizeText, "all");
+    if ((pixels > 0) && (p50 > 0)) snprintf(pixelsText, 16, "%.2f", pixels/p50/1000000.0);
+    else strcpy(pixelsText, "-");
+    if ((bytes > 0) && (p50 > 0)) snprintf(bytesText, 16, "%.2f", bytes/p50/1000000.0);
+    else strcpy(bytesText, "-");
+
+    printf(" %-18s %6s %6i %11.3f %11.3f %10s %10s\n", stage, sizeText, count, p50*1000.0, p99*1000.0, pixelsText, bytesText);
+}
+
+// Generate benchmark corpus image, same image always generated (no input files required)
+// NOTE: Image combines smooth gradients, hard edges and transparent areas with
+// an antialiased border, similar to usual icons content
+static Image GenBenchmarkImage(int size)
+{
+    Image image = { 0 };
+    image.data = RL_CALLOC(size*size, 4);
+    image.width = size;
+    image.height = size;
+    image.mipmaps = 1;
+    image.format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+
+    unsigned char *pixels = (unsigned char *)image.data;
+    float center = size/2.0f;
+    float radius = size*0.45f;
+    float border = size*0.02f;
+
+    for (int y = 0; y < size; y++)
+    {
+        for (int x = 0; x < size; x++)
+        {
+            unsigned char *pixel = &pixels[(y*size + x)*4];
+            float dx = x - center;
+            float dy = y - center;
+            float alpha = (radius + border - sqrtf(dx*dx + dy*dy))/border;
+
+            if (alpha < 0.0f) alpha = 0.0f;
+            else if (alpha > 1.0f) alpha = 1.0f;
+
+            pixel[0] = (unsigned char)(255*x/size);
+            pixel[1] = (unsigned char)(255*y/size);
+            pixel[2] = ((((x/(size/8)) + (y/(size/8)))%2) == 0)? 200 : 40;
+            pixel[3] = (unsigned char)(alpha*255.0f);
+        }
+    }
+
+    return image;
+}
+
+// Process benchmark suite over a fixed corpus (command line --bench)
+// NOTE: Every stage is measured per icon size, latencies percentiles are reported
+// per stage and size, pixels throughput is computed over stage output image size,
+// bytes throughput over stage PNG data (encoded output or decoded/parsed input)
+static void ProcessBenchmark(int iterations, int threadCount)
+{
+    static const int sizes[BENCH_SIZES_COUNT] = { 1024, 512, 256, 128, 64, 48, 32, 16 };
+    static const char *resizeStages[4] = { "resize/nearest", "resize/bicubic", "resize/box", "resize/lanczos3" };
+    static const char *encodeStages[4] = { "encode/fast", "encode/default", "encode/max", "encode/optimal" };
+    const char *icoFileName = "riconpacker_bench.ico";
+    const char *icnsFileName = "riconpacker_bench.icns";
+
+    double *samples = (double *)RL_CALLOC(iterations, sizeof(double));
+    IconExportOptions options = { .textChunk = false, .compression = ICON_COMPRESSION_DEFAULT, .threadCount = threadCount };
+
+    printf("\nBenchmark: %i iterations per stage and size, %i threads\n", iterations, threadCount);
+    printf("Corpus: generated %ix%i RGBA image, sizes: %i", sizes[0], sizes[0], sizes[0]);
+    for (int i = 1; i < BENCH_SIZES_COUNT; i++) printf(",%i", sizes[i]);
+    printf("\n\n");
+    printf(" %-18s %6s %6s %11s %11s %10s %10s\n", "STAGE", "SIZE", "RUNS", "P50 (ms)", "P99 (ms)", "MP/s", "MB/s");
+
+    // Generate corpus entries: one entry per size (box filter), encoded with default options
+    Image source = GenBenchmarkImage(sizes[0]);
+    Image corpusImages[BENCH_SIZES_COUNT] = { 0 };
+    IconEntry corpus[BENCH_SIZES_COUNT] = { 0 };
+
+    corpusImages[0] = ImageCopy(source);
+    GenerateIconSizes(source, sizes + 1, BENCH_SIZES_COUNT - 1, 3, threadCount, corpusImages + 1);
+
+    for (int i = 0; i < BENCH_SIZES_COUNT; i++)
+    {
+        corpus[i].image = corpusImages[i];
+        corpus[i].size = sizes[i];
+        corpus[i].valid = true;
+        strcpy(corpus[i].text, "rIconPacker benchmark corpus image");
+    }
+
+    // Resize: generate every size from source image, per algorythm
+    for (int alg = 1; alg <= 4; alg++)
+    {
+        for (int s = 1; s < BENCH_SIZES_COUNT; s++)
+        {
+            for (int i = 0; i < iterations; i++)
+            {
+                Image image = { 0 };
+                double time = GetPerformanceTime();
+                GenerateIconSizes(source, &sizes[s], 1, alg, threadCount, &image);
+                samples[i] = GetPerformanceTime() - time;
+                UnloadImage(image);
+            }
+
+            PrintBenchmarkResult(resizeStages[alg - 1], sizes[s], samples, iterations, (double)sizes[s]*sizes[s], 0);
+        }
+    }
+
+    // Encode: PNG filter + deflate, per compression effort level
+    // NOTE: Optimal level takes seconds per big size, it's only measured up to BENCH_OPTIMAL_MAX_SIZE
+    // and iterations are limited to BENCH_OPTIMAL_ITERATIONS
+    for (int level = ICON_COMPRESSION_FAST; level <= ICON_COMPRESSION_OPTIMAL; level++)
+    {
+        options.compression = level;
+
+        int levelIterations = iterations;
+        if ((level == ICON_COMPRESSION_OPTIMAL) && (levelIterations > BENCH_OPTIMAL_ITERATIONS)) levelIterations = BENCH_OPTIMAL_ITERATIONS;
+
+        for (int s = 0; s < BENCH_SIZES_COUNT; s++)
+        {
+            if ((level == ICON_COMPRESSION_OPTIMAL) && (sizes[s] > BENCH_OPTIMAL_MAX_SIZE)) continue;
+
+            int dataSize = 0;
+
+            for (int i = 0; i < levelIterations; i++)
+            {
+                double time = GetPerformanceTime();
+                char *data = ExportIconEntryToMemory(corpus[s], options, &dataSize);
+                samples[i] = GetPerformanceTime() - time;
+                RPNG_FREE(data);
+            }
+
+            PrintBenchmarkResult(encodeStages[level], sizes[s], samples, levelIterations, (double)sizes[s]*sizes[s], dataSize);
+        }
+    }
+
+    // Keep default encoded data as corpus entries cache, required by next stages
+    options.compression = ICON_COMPRESSION_DEFAULT;
+    for (int s = 0; s < BENCH_SIZES_COUNT; s++)
+    {
+        corpus[s].pngData = ExportIconEntryToMemory(corpus[s], options, &corpus[s].pngDataSize);
+        corpus[s].pngDataKey = ComputeIconEntryKey(corpus[s], options);
+    }
+
+    // Text chunk: rIPt chunk insertion into already encoded PNG data
+    rpng_chunk textChunk = { 0 };
+    textChunk.data = (unsigned char *)corpus[0].text;
+    textChunk.length = (int)strlen(corpus[0].text);
+    memcpy(textChunk.type, "rIPt", 4);
+
+    for (int s = 0; s < BENCH_SIZES_COUNT; s++)
+    {
+        for (int i = 0; i < iterations; i++)
+        {
+            int dataSize = 0;
+            double time = GetPerformanceTime();
+            char *data = rpng_chunk_write_from_memory(corpus[s].pngData, textChunk, &dataSize);
+            samples[i] = GetPerformanceTime() - time;
+            RPNG_FREE(data);
+        }
+
+        PrintBenchmarkResult("text chunk", sizes[s], samples, iterations, 0, corpus[s].pngDataSize);
+    }
+
+    // PNG decode
+    for (int s = 0; s < BENCH_SIZES_COUNT; s++)
+    {
+        for (int i = 0; i < iterations; i++)
+        {
+            double time = GetPerformanceTime();
+            Image image = LoadImageFromMemory(".png", (unsigned char *)corpus[s].pngData, corpus[s].pngDataSize);
+            samples[i] = GetPerformanceTime() - time;
+            UnloadImage(image);
+        }
+
+        PrintBenchmarkResult("png decode", sizes[s], samples, iterations, (double)sizes[s]*sizes[s], corpus[s].pngDataSize);
+    }
+
+    // File write: all sizes, encoded data already available (cached)
+    int corpusBytes = 0;
+    double corpusPixels = 0;
+    for (int s = 0; s < BENCH_SIZES_COUNT; s++) { corpusBytes += corpus[s].pngDataSize; corpusPixels += (double)sizes[s]*sizes[s]; }
+
+    for (int i = 0; i < iterations; i++)
+    {
+        double time = GetPerformanceTime();
+        SaveIconPackToICO(corpus, BENCH_SIZES_COUNT, icoFileName, options);
+        samples[i] = GetPerformanceTime() - time;
+    }
+    PrintBenchmarkResult("ico write", 0, samples, iterations, 0, corpusBytes);
+
+    for (int i = 0; i < iterations; i++)
+    {
+        double time = GetPerformanceTime();
+        SaveIconPackToICNS(corpus, BENCH_SIZES_COUNT, icnsFileName, options);
+        samples[i] = GetPerformanceTime() - time;
+    }
+    PrintBenchmarkResult("icns write", 0, samples, iterations, 0, corpusBytes);
+
+    // File parse: all entries, images not decoded (source PNG data kept)
+    for (int format = 0; format < 2; format++)
+    {
+        for (int i = 0; i < iterations; i++)
+        {
+            int count = 0;
+            double time = GetPerformanceTime();
+            IconEntry *entries = (format == 0)? LoadIconPackFromICO(icoFileName, &count) : LoadIconPackFromICNS(icnsFileName, &count);
+            samples[i] = GetPerformanceTime() - time;
+
+            for (int k = 0; k < count; k++)
+            {
+                UnloadImage(entries[k].image);
+                UnloadIconEntryCache(&entries[k]);
+            }
+            RL_FREE(entries);
+        }
+        PrintBenchmarkResult((format == 0)? "ico parse" : "icns parse", 0, samples, iterations, 0, corpusBytes);
+    }
+
+    // Full pack: parse, decode, generate missing sizes and encode, same as one job from .icns input
+    for (int i = 0; i < iterations; i++)
+    {
+        IconBucket bucket = { 0 };
+        Image images[BENCH_SIZES_COUNT] = { 0 };
+        IconEntry entries[BENCH_SIZES_COUNT] = { 0 };
+
+        double time = GetPerformanceTime();
+        AddIconToBucket(&bucket, icnsFileName);
+        LoadIconEntryImage(&bucket.entries[0]);
+        GenerateIconSizes(bucket.entries[0].image, sizes + 1, BENCH_SIZES_COUNT - 1, 2, threadCount, images + 1);
+        entries[0] = bucket.entries[0];
+        for (int s = 1; s < BENCH_SIZES_COUNT; s++) { entries[s].image = images[s]; entries[s].size = sizes[s]; entries[s].valid = true; }
+        SaveIconPackToICO(entries, BENCH_SIZES_COUNT, icoFileName, options);
+        samples[i] = GetPerformanceTime() - time;
+
+        for (int s = 1; s < BENCH_SIZES_COUNT; s++) { UnloadImage(images[s]); UnloadIconEntryCache(&entries[s]); }
+        bucket.entries[0] = entries[0];     // NOTE: Entry cache could be updated by export
+        ClearIconBucket(&bucket);
+        RL_FREE(bucket.entries);
+    }
+    PrintBenchmarkResult("full pack", 0, samples, iterations, corpusPixels, 0);
+
+    remove(icoFileName);
+    remove(icnsFileName);
+
+    for (int s = 0; s < BENCH_SIZES_COUNT; s++)
+    {
+        UnloadImage(corpus[s].image);
+        UnloadIconEntryCache(&corpus[s]);
+    }
+    UnloadImage(source);
+    RL_FREE(samples);
+
+    printf("\n");
+}
+#endif
+
+//--------------------------------------------------------------------------------------------
+// Load/Save/Export functions
+//--------------------------------------------------------------------------------------------
+#if !defined(RICONPACKER_LIBRARY)
+// Get sizes as a text array separated by semicolon (ready for GuiListView())
+static char *GetTextIconSizes(IconPack pack)
+{
+    static char buffer[1024] = { 0 };
+    memset(buffer, 0, 1024);
+
+    int offset = 0;
+    int length = 0;
+    memcpy(buffer, "ALL;", 4);
+    offset += 4;
+
+    for (int i = 0; i < pack.count; i++)
+    {
+        length = TextLength(TextFormat("%i x %i;", pack.entries[i].size, pack.entries[i].size));
+        if ((offset + length) >= 1024) break;   // Buffer full, remaining sizes not listed
+
+        memcpy(buffer + offset, TextFormat("%i x %i;", pack.entries[i].size, pack.entries[i].size), length);
+        offset += length;
+    }
+
+    buffer[offset - 1] = '\0';
+
+    return buffer;
+}
+#endif
 
 // Icon File Header (6 bytes)
 typedef struct {
-    unsigned short reserved;    // Must always be 0.
-    unsigned short imageType;   // Specifies image type: 1 for icon (.ICO) image, 2 for cursor (.CUR) image. Other values are invalid.
-    unsigned short imageCount;  // Specifies number of entries in the file.
-} IcoHeader;
+    unsigned short reserved;    // Must always be 0.
+    unsigned short imageType;   // Specifies image type: 1 for icon (.ICO) image, 2 for cursor (.CUR) image. Other values are invalid.
+    unsigned short imageCount;  // Specifies number of entries in the file.
+} IcoHeader;
+
+// Icon Entry info (16 bytes)
+typedef struct {
+    unsigned char width;        // Specifies image width in pixels. Can be any number between 0 and 255. Value 0 means image width is 256 pixels.
+    unsigned char height;       // Specifies image height in pixels. Can be any number between 0 and 255. Value 0 means image height is 256 pixels.
+    unsigned char colpalette;   // Specifies number of colors in the color palette. Should be 0 if the image does not use a color palette.
+    unsigned char reserved;     // Reserved. Should be 0.
+    unsigned short planes;      // In ICO format: Specifies color planes. Should be 0 or 1.
+    // In CUR format: Specifies the horizontal coordinates of the hotspot in number of pixels from the left.
+    unsigned short bpp;         // In ICO format: Specifies bits per pixel. [Notes 4]
+    // In CUR format: Specifies the vertical coordinates of the hotspot in number of pixels from the top.
+    unsigned int size;          // Specifies the size of the image's data in bytes
+    unsigned int offset;        // Specifies the offset of BMP or PNG data from the beginning of the ICO/CUR file
+} IcoDirEntry;
+
+// Icon Entry BMP info header (40 bytes), BMP data (DIB) is stored without file header
+typedef struct {
+    unsigned int size;          // Specifies header size in bytes: 40 (BITMAPINFOHEADER)
+    int width;                  // Specifies image width in pixels
+    int height;                 // Specifies image height in pixels. In ICO format it includes the AND mask (2x image height).
+    unsigned short planes;      // Specifies color planes. Must be 1.
+    unsigned short bpp;         // Specifies bits per pixel: 1, 4, 8 (palette), 24 or 32
+    unsigned int compression;   // Specifies compression type: 0 (BI_RGB) or 3 (BI_BITFIELDS, color masks after header)
+    unsigned int imageSize;     // Specifies image data size in bytes (color + mask). Can be 0 for uncompressed data.
+    int xPixelsPerMeter;        // Specifies horizontal resolution. Not used.
+    int yPixelsPerMeter;        // Specifies vertical resolution. Not used.
+    unsigned int colorsUsed;    // Specifies number of palette colors. Value 0 means maximum for bpp.
+    unsigned int colorsImportant;   // Specifies number of important palette colors. Not used.
+} DibHeader;
+
+#if !defined(RICONPACKER_LIBRARY)
+// Icon data loader
+static IconEntry *LoadIconPackFromICO(const char *fileName, int *count)
+{
+    // NOTE: File is read once, image data is located using directory entries offsets
+    int fileSize = 0;
+    unsigned char *fileData = LoadFileData(fileName, &fileSize);
+
+    IconEntry *entries = LoadIconPackFromICOMemory(fileData, fileSize, count);
+
+    UnloadFileData(fileData);
+
+    return entries;
+}
+#endif
+
+// Icon data loader from memory (.ico file data)
+// NOTE: PNG images are not decoded on loading, only when required (LoadIconEntryImage()),
+// entries do not reference file data, it can be freed after loading
+static IconEntry *LoadIconPackFromICOMemory(const unsigned char *fileData, int fileSize, int *count)
+{
+    IconEntry *entries = NULL;
+    int imageCounter = 0;
+
+    if ((fileData != NULL) && (fileSize >= (int)sizeof(IcoHeader)))
+    {
+        // Load .ico information
+        IcoHeader icoHeader = { 0 };
+        memcpy(&icoHeader, fileData, sizeof(IcoHeader));
+
+        int dirSize = icoHeader.imageCount*(int)sizeof(IcoDirEntry);
+
+        if ((int)sizeof(IcoHeader) + dirSize <= fileSize)
+        {
+            entries = (IconEntry *)RL_CALLOC(icoHeader.imageCount, sizeof(IconEntry));
+
+            for (int i = 0; i < icoHeader.imageCount; i++)
+            {
+                IcoDirEntry icoDirEntry = { 0 };
+                memcpy(&icoDirEntry, fileData + sizeof(IcoHeader) + i*sizeof(IcoDirEntry), sizeof(IcoDirEntry));
+
+                // Verify image data is inside the file
+                if ((icoDirEntry.size == 0) || (icoDirEntry.offset > (unsigned int)fileSize) ||
+                    (icoDirEntry.size > ((unsigned int)fileSize - icoDirEntry.offset)))
+                {
+                    LOG("WARNING: ICO image data out of file bounds\n");
+                    continue;
+                }
+
+                // WARNING: Image data on th IcoDirEntry may be in either:
+                //  - Windows BMP format, excluding the BITMAPFILEHEADER structure
+                //  - PNG format, stored in its entirety
+                if ((icoDirEntry.size >= 8) && (memcmp(fileData + icoDirEntry.offset, "\x89PNG\r\n\x1a\n", 8) == 0))
+                {
+                    unsigned char *icoImageData = (unsigned char *)RPNG_MALLOC(icoDirEntry.size);
+                    memcpy(icoImageData, fileData + icoDirEntry.offset, icoDirEntry.size);
+
+                    // Keep original PNG data, image is decoded when required and data
+                    // is written as is on saving if image is not modified
+                    // NOTE: Entry is not valid until it is checked against the current package (sizes)
+                    if (SetIconEntrySourceData(&entries[imageCounter], icoImageData, icoDirEntry.size)) imageCounter++;
+                    else RPNG_FREE(icoImageData);
+                }
+                else
+                {
+                    // BMP data (DIB) is decoded on loading, no encoded data cache kept
+                    // NOTE: Entry is not valid until it is checked against the current package (sizes)
+                    Image image = LoadImageFromDIB(fileData + icoDirEntry.offset, icoDirEntry.size);
+
+                    if ((image.data != NULL) && (image.width == image.height))
+                    {
+                        entries[imageCounter].image = image;
+                        entries[imageCounter].size = image.width;
+                        imageCounter++;
+                    }
+                    else
+                    {
+                        UnloadImage(image);
+                        LOG("WARNING: ICO image data format not supported\n");
+                    }
+                }
+            }
+        }
+    }
+
+    *count = imageCounter;
+    return entries;
+}
+
+#if !defined(RICONPACKER_LIBRARY)
+// Save icon (.ico)
+// NOTE: Make sure entries array sizes are valid!
+// Returns false if there are no valid entries or file could not be written
+static bool SaveIconPackToICO(IconEntry *entries, int entryCount, const char *fileName, IconExportOptions options)
+{
+    bool success = false;
+    int icoDataSize = 0;
+    char *icoData = ExportIconPackToICOMemory(entries, entryCount, options, &icoDataSize);
+
+    if (icoData != NULL)
+    {
+        FILE *icoFile = fopen(fileName, "wb");
+
+        if (icoFile != NULL)
+        {
+            success = (fwrite(icoData, 1, icoDataSize, icoFile) == (size_t)icoDataSize);
+            if (fclose(icoFile) != 0) success = false;
+        }
+
+        RL_FREE(icoData);
+    }
+
+    return success;
+}
+#endif
+
+// Export icon (.ico) file data to memory
+// NOTE: Entries up to options.dibMaxSize are saved as DIB (32bpp + AND mask), bigger ones as PNG,
+// returns NULL if there are no valid entries, returned data must be freed by user (RL_FREE())
+static char *ExportIconPackToICOMemory(IconEntry *entries, int entryCount, IconExportOptions options, int *dataSize)
+{
+    *dataSize = 0;
+
+    // Verify icon pack valid entries (not placeholder ones)
+    int packValidCount = 0;
+    for (int i = 0; i < entryCount; i++) if (entries[i].valid) packValidCount++;
+
+    if (packValidCount == 0) return NULL;
+
+    // Define ico file header and entry
+    IcoHeader icoHeader = { .reserved = 0, .imageType = 1, .imageCount = packValidCount };
+    IcoDirEntry *icoDirEntry = (IcoDirEntry *)RL_CALLOC(icoHeader.imageCount, sizeof(IcoDirEntry));
+
+    char **pngDataPtrs = (char **)RL_CALLOC(icoHeader.imageCount, sizeof(char *));     // Pointers array to PNG image data
+    int *pngDataSizes = (int *)RL_CALLOC(icoHeader.imageCount, sizeof(int));          // PNG data size
+    char **dibDataPtrs = (char **)RL_CALLOC(icoHeader.imageCount, sizeof(char *));     // Pointers array to DIB image data (NULL for PNG entries)
+    char **imageDataPtrs = (char **)RL_CALLOC(icoHeader.imageCount, sizeof(char *));   // Pointers array to image data, in directory order
+    bool *dibEntries = (bool *)RL_CALLOC(entryCount, sizeof(bool));
+    int offset = 6 + 16*icoHeader.imageCount;
+
+    // Entries saved as DIB are not encoded as PNG, they are temporarily set as not valid
+    for (int i = 0; i < entryCount; i++)
+    {
+        if (entries[i].valid && (entries[i].size <= options.dibMaxSize))
+        {
+            dibEntries[i] = true;
+            entries[i].valid = false;
+        }
+    }
+
+    // Compress valid entries into PNG data (in parallel), in the same order than entries
+    ExportIconEntriesToMemory(entries, entryCount, options, pngDataPtrs, pngDataSizes, NULL);
+
+    // Compute image directory entries from generated PNG/DIB data sizes
+    for (int i = 0, j = 0, k = 0; i < entryCount; i++)
+    {
+        int fileSize = 0;
+
+        if (dibEntries[i])
+        {
+            entries[i].valid = true;
+            dibDataPtrs[k] = ExportIconEntryToDIB(entries[i], &fileSize);
+            imageDataPtrs[k] = dibDataPtrs[k];
+            icoDirEntry[k].planes = 1;
+        }
+        else if (entries[i].valid)
+        {
+            fileSize = pngDataSizes[j];
+            imageDataPtrs[k] = pngDataPtrs[j];
+            j++;
+        }
+        else continue;
+
+        icoDirEntry[k].width = (entries[i].image.width >= 256)? 0 : entries[i].image.width;     // NOTE: 0 means 256 or bigger (size read from PNG)
+        icoDirEntry[k].height = (entries[i].image.width >= 256)? 0 : entries[i].image.width;
+        icoDirEntry[k].bpp = 32;
+        icoDirEntry[k].size = fileSize;
+        icoDirEntry[k].offset = offset;
+
+        offset += fileSize;
+        k++;
+    }
+
+    // NOTE: Final offset is the complete file size
+    char *icoData = (char *)RL_MALLOC(offset);
+
+    if (icoData != NULL)
+    {
+        // Write ico header
+        memcpy(icoData, &icoHeader, sizeof(IcoHeader));
+
+        // Write icon entries entries data
+        for (int i = 0; i < icoHeader.imageCount; i++) memcpy(icoData + sizeof(IcoHeader) + i*sizeof(IcoDirEntry), &icoDirEntry[i], sizeof(IcoDirEntry));
+
+        // Write icon png/dib data
+        for (int i = 0; i < icoHeader.imageCount; i++) if (icoDirEntry[i].size > 0) memcpy(icoData + icoDirEntry[i].offset, imageDataPtrs[i], icoDirEntry[i].size);
+
+        *dataSize = offset;
+    }
+
+    // NOTE: PNG data is owned by entries (encoded data cache), DIB data is not cached
+    for (int i = 0; i < icoHeader.imageCount; i++) RL_FREE(dibDataPtrs[i]);
+
+    RL_FREE(icoDirEntry);
+    RL_FREE(pngDataPtrs);
+    RL_FREE(pngDataSizes);
+    RL_FREE(dibDataPtrs);
+    RL_FREE(imageDataPtrs);
+    RL_FREE(dibEntries);
+
+    return icoData;
+}
+
+#if !defined(RICONPACKER_LIBRARY)
+// Save images as .png
+static void ExportIconPackImages(IconEntry *entries, int entryCount, const char *fileName, IconExportOptions options)
+{
+    // Verify icon pack valid entries (not placeholder ones)
+    int packValidCount = 0;
+    for (int i = 0; i < entryCount; i++) if (entries[i].valid) packValidCount++;
+
+    if (packValidCount == 0) return;
+
+    char **pngDataPtrs = (char **)RL_CALLOC(packValidCount, sizeof(char *));     // Pointers array to PNG image data
+    int *pngDataSizes = (int *)RL_CALLOC(packValidCount, sizeof(int));          // PNG data size
+
+    // Compress valid entries into PNG data (in parallel), in the same order than entries
+    ExportIconEntriesToMemory(entries, entryCount, options, pngDataPtrs, pngDataSizes, NULL);
+
+#if defined(EXPORT_IMAGE_PACK_AS_ZIP)
+    // Export a single .zip file containing all images (fileName.zip)
+    // NOTE: One zip writer session is used for all images, so central directory is only written once,
+    // PNG data is already compressed, it's stored without recompression
+    mz_zip_archive zip = { 0 };
+    bool zipReady = mz_zip_writer_init_file(&zip, TextFormat("%s.zip", fileName), 0);
+    if (!zipReady) LOG("WARNING: Zip file could not be created\n");
+#endif
+
+    // Save generated PNG data, one by one
+    // NOTE: In case of PNG export as ZIP, files are directly packed in the loop, one by one
+    for (int i = 0, k = 0; i < entryCount; i++)
+    {
+        if (entries[i].valid)
+        {
+#if defined(EXPORT_IMAGE_PACK_AS_ZIP)
+            // Package every image into output ZIP file
+            mz_bool status = zipReady && mz_zip_writer_add_mem(&zip, TextFormat("%s_%ix%i.png", GetFileNameWithoutExt(fileName), entries[i].image.width, entries[i].image.height), pngDataPtrs[k], pngDataSizes[k], MZ_NO_COMPRESSION);
+            if (!status) LOG("WARNING: Zip accumulation process failed\n");
+#else
+            // Save every PNG file individually
+            SaveFileData(TextFormat("%s/%s_%ix%i.png", GetDirectoryPath(fileName), GetFileNameWithoutExt(fileName), entries[i].image.width, entries[i].image.height), pngDataPtrs[k], pngDataSizes[k]);
+#endif
+            k++;
+        }
+    }
+
+#if defined(EXPORT_IMAGE_PACK_AS_ZIP)
+    if (zipReady)
+    {
+        if (!mz_zip_writer_finalize_archive(&zip)) LOG("WARNING: Zip file could not be finalized\n");
+        mz_zip_writer_end(&zip);
+    }
+#endif
+
+    // NOTE: PNG data is owned by entries (encoded data cache)
+    RL_FREE(pngDataPtrs);
+    RL_FREE(pngDataSizes);
+}
+#endif
+
+#if !defined(RICONPACKER_LIBRARY)
+// Icns data loader
+// NOTE: PNG, ARGB (RLE) and legacy RGB (RLE) + 8bit mask image data formats supported, JPEG2000 not supported
+static IconEntry *LoadIconPackFromICNS(const char *fileName, int *count)
+{
+    // NOTE: File is read once, PNG images are not decoded on loading, only when required (LoadIconEntryImage())
+    int icnsDataSize = 0;
+    unsigned char *icnsData = LoadFileData(fileName, &icnsDataSize);
+
+    IconEntry *entries = LoadIconPackFromICNSMemory(icnsData, icnsDataSize, count);
+
+    UnloadFileData(icnsData);
+
+    return entries;
+}
+#endif
+
+// Load icns file data from memory (Apple)
+// NOTE: PNG images are not decoded on loading, ARGB and legacy RGB images are decoded on loading,
+// entries do not reference file data, it can be freed after loading
+static IconEntry *LoadIconPackFromICNSMemory(const unsigned char *icnsData, int icnsDataSize, int *count)
+{
+    #define MAX_ICNS_IMAGE_SUPPORTED    32
+    #define MAX_ICNS_LEGACY_SUPPORTED    4
+
+    #define SWAP_INT32(x) (((x) >> 24) | (((x) & 0x00ff0000) >> 8) | (((x) & 0x0000ff00) << 8) | ((x) << 24))
+
+    // Legacy RGB image types (RLE compressed) and their mask types (8bit alpha, not compressed)
+    static const char *legacyTypes[MAX_ICNS_LEGACY_SUPPORTED] = { "is32", "il32", "ih32", "it32" };
+    static const char *legacyMaskTypes[MAX_ICNS_LEGACY_SUPPORTED] = { "s8mk", "l8mk", "h8mk", "t8mk" };
+    static const int legacySizes[MAX_ICNS_LEGACY_SUPPORTED] = { 16, 32, 48, 128 };
+
+    IconEntry *entries = NULL;
+    unsigned int imageCounter = 0;
+
+    // NOTE: Legacy images are completed with their masks once all file data is processed
+    Image legacyImages[MAX_ICNS_LEGACY_SUPPORTED] = { 0 };
+    const unsigned char *legacyMasks[MAX_ICNS_LEGACY_SUPPORTED] = { 0 };
+
+    if ((icnsData != NULL) && (icnsDataSize >= 8))
+    {
+        const unsigned char *icnsSig = icnsData;
+
+        if ((icnsSig[0] == 'i') && (icnsSig[1] == 'c') && (icnsSig[2] == 'n') && (icnsSig[3] == 's'))
+        {
+            unsigned char icnType[4] = { 0 };
+            unsigned int fileSize = 0;
+            unsigned int sizeBE = 0;
+            memcpy(&sizeBE, icnsData + 4, sizeof(unsigned int));
+            fileSize = SWAP_INT32(sizeBE);
+
+            // NOTE: File size in header could be wrong, never read out of loaded data
+            if (fileSize > (unsigned int)icnsDataSize) fileSize = (unsigned int)icnsDataSize;
+
+            // Allocate space for the maximum number of entries supported
+            // NOTE: Only the valid loaded images will be filled, some entries will be empty,
+            // but the returned entries count will refer to the loaded images
+            // There shouldn't be any problem when freeing the pointer...
+            entries = (IconEntry *)RL_CALLOC(MAX_ICNS_IMAGE_SUPPORTED, sizeof(IconEntry));
+
+            unsigned int processedSize = 8;
+
+            for (int i = 0; (i < MAX_ICNS_IMAGE_SUPPORTED) && ((processedSize + 8) <= fileSize); i++)
+            {
+                memcpy(icnType, icnsData + processedSize, 4);
+
+                unsigned int icnSize = 0;
+                memcpy(&sizeBE, icnsData + processedSize + 4, sizeof(unsigned int));
+                icnSize = SWAP_INT32(sizeBE);
+
+                processedSize += 8;     // IcnType an IcnSize parameters
+
+                // Verify entry data is inside the file
+                if ((icnSize < 8) || ((icnSize - 8) > (fileSize - processedSize))) break;
+
+                icnSize -= 8;           // IcnSize also considers type and size parameters, we must subtract them to get actual data size
+
+                // We have next icn type and size, now we must check if it's a supported format to load it
+                LOG("INFO: ICNS OSType: %c%c%c%c [%i bytes]\n", icnType[0], icnType[1], icnType[2], icnType[3], icnSize);
+
+                // NOTE: Only supported formats including PNG data
+                if (((icnType[0] == 'i') && (icnType[1] == 'c') && (icnType[2] == 'p') && (icnType[3] == '4')) ||   // 16x16, icp4, not properly displayed on .app
+                    ((icnType[0] == 'i') && (icnType[1] == 'c') && (icnType[2] == 'p') && (icnType[3] == '5')) ||   // 32x32, icp5, not properly displayed on .app
+                    ((icnType[0] == 'i') && (icnType[1] == 'c') && (icnType[2] == 'p') && (icnType[3] == '6')) ||   // 48x48, icp6, not properly displayed on .app
+                    ((icnType[0] == 'i') && (icnType[1] == 'c') && (icnType[2] == '0') && (icnType[3] == '4')) ||   // 16x16, ic04
+                    ((icnType[0] == 'i') && (icnType[1] == 'c') && (icnType[2] == 's') && (icnType[3] == 'b')) ||   // 18x18, icsb
+                    ((icnType[0] == 's') && (icnType[1] == 'b') && (icnType[2] == '2') && (icnType[3] == '4')) ||   // 24x24, sb24
+                    ((icnType[0] == 'i') && (icnType[1] == 'c') && (icnType[2] == 'p') && (icnType[3] == '5')) ||   // 32x32, icp5, not properly displayed on .app
+                    ((icnType[0] == 'i') && (icnType[1] == 'c') && (icnType[2] == '0') && (icnType[3] == '5')) ||   // 32x32, ic05 (16x16@2x "retina")
+                    ((icnType[0] == 'i') && (icnType[1] == 'c') && (icnType[2] == '1') && (icnType[3] == '1')) ||   // 32x32, ic11 (16x16@2x "retina")
+                    ((icnType[0] == 'i') && (icnType[1] == 'c') && (icnType[2] == 's') && (icnType[3] == 'B')) ||   // 36x36, icsB (18x18@2x "retina")
+                    ((icnType[0] == 'i') && (icnType[1] == 'c') && (icnType[2] == 'p') && (icnType[3] == '6')) ||   // 48x48, icp6, not properly displayed on .app
+                    ((icnType[0] == 'S') && (icnType[1] == 'B') && (icnType[2] == '2') && (icnType[3] == '4')) ||   // 48x48, SB24 (24x24@2x "retina")
+                    ((icnType[0] == 'i') && (icnType[1] == 'c') && (icnType[2] == '1') && (icnType[3] == '2')) ||   // 64x64, ic12 (32x32@2x "retina")
+                    ((icnType[0] == 'i') && (icnType[1] == 'c') && (icnType[2] == '0') && (icnType[3] == '7')) ||   // 128x128, ic07
+                    ((icnType[0] == 'i') && (icnType[1] == 'c') && (icnType[2] == '0') && (icnType[3] == '8')) ||   // 256x256, ic08
+                    ((icnType[0] == 'i') && (icnType[1] == 'c') && (icnType[2] == '1') && (icnType[3] == '3')) ||   // 256x256, ic13 (128x128@2x "retina")
+                    ((icnType[0] == 'i') && (icnType[1] == 'c') && (icnType[2] == '0') && (icnType[3] == '9')) ||   // 512x512, ic09
+                    ((icnType[0] == 'i') && (icnType[1] == 'c') && (icnType[2] == '1') && (icnType[3] == '4')) ||   // 512x512, ic14 (256x256@2x "retina")
+                    ((icnType[0] == 'i') && (icnType[1] == 'c') && (icnType[2] == '1') && (icnType[3] == '0')))     // 1024x1024, ic10 (512x512@2x "retina")
+                {
+                    // NOTE: We only support loading PNG data, JPEG2000 and ARGB data not supported
+
+                    // Keep original PNG data, image is decoded when required and data
+                    // is written as is on saving if image is not modified
+                    // NOTE: Entry is not valid until it is checked against the current package (sizes)
+                    unsigned char *icnImageData = (unsigned char *)RPNG_MALLOC(icnSize);
+                    memcpy(icnImageData, icnsData + processedSize, icnSize);
+
+                    if (SetIconEntrySourceData(&entries[imageCounter], icnImageData, icnSize)) imageCounter++;
+                    else
+                    {
+                        RPNG_FREE(icnImageData);
+
+                        // ARGB data: "ARGB" signature followed by RLE compressed planes (A, R, G, B)
+                        // NOTE: Only available for ic04 (16x16), ic05 (32x32) and icsb (18x18) types
+                        int argbSize = 0;
+                        if (memcmp(icnType, "ic04", 4) == 0) argbSize = 16;
+                        else if (memcmp(icnType, "ic05", 4) == 0) argbSize = 32;
+                        else if (memcmp(icnType, "icsb", 4) == 0) argbSize = 18;
+
+                        if ((argbSize > 0) && (icnSize > 4) && (memcmp(icnsData + processedSize, "ARGB", 4) == 0))
+                        {
+                            static const int argbChannels[4] = { 3, 0, 1, 2 };
+                            Image image = { 0 };
+                            image.data = RL_CALLOC(argbSize*argbSize*4, 1);
+                            image.width = argbSize;
+                            image.height = argbSize;
+                            image.mipmaps = 1;
+                            image.format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+
+                            if (DecodeIcnsRLE(icnsData + processedSize + 4, icnSize - 4, image.data, argbSize*argbSize, argbChannels, 4))
+                            {
+                                entries[imageCounter].image = image;
+                                entries[imageCounter].size = argbSize;
+                                imageCounter++;
+                            }
+                            else
+                            {
+                                UnloadImage(image);
+                                LOG("WARNING: ICNS ARGB data could not be decoded\n");
+                            }
+                        }
+                        else LOG("WARNING: ICNS data format not supported\n");
+                    }
+
+                    // JPEG2000 data signatures (not supported)
+                    // Option 1: 0x00 0x00 0x00 0x0c 0x6a 0x50 0x20 0x20 0x0d 0x0a 0x87 0x0a
+                    // Option 2: 0xff 0x4f 0xff 0x51
+                }
+                else
+                {
+                    for (int k = 0; k < MAX_ICNS_LEGACY_SUPPORTED; k++)
+                    {
+                        int pixelCount = legacySizes[k]*legacySizes[k];
+
+                        if ((memcmp(icnType, legacyTypes[k], 4) == 0) && (legacyImages[k].data == NULL))
+                        {
+                            // Legacy RGB data: RLE compressed planes (R, G, B) or uncompressed (xRGB)
+                            // NOTE: it32 data starts with 4 zero bytes, alpha is set from mask if available
+                            static const int rgbChannels[3] = { 0, 1, 2 };
+                            const unsigned char *rgbData = icnsData + processedSize;
+                            int rgbDataSize = icnSize;
+
+                            if ((k == 3) && (rgbDataSize >= 4)) { rgbData += 4; rgbDataSize -= 4; }
+
+                            Image image = { 0 };
+                            image.data = RL_MALLOC(pixelCount*4);
+                            image.width = legacySizes[k];
+                            image.height = legacySizes[k];
+                            image.mipmaps = 1;
+                            image.format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+                            memset(image.data, 255, pixelCount*4);
+
+                            bool decoded = false;
+
+                            if (icnSize == (unsigned int)pixelCount*4)
+                            {
+                                // Uncompressed data: 4 bytes per pixel, first byte not used
+                                unsigned char *pixels = (unsigned char *)image.data;
+                                for (int p = 0; p < pixelCount*4; p += 4) memcpy(pixels + p, icnsData + processedSize + p + 1, 3);
+                                decoded = true;
+                            }
+                            else decoded = DecodeIcnsRLE(rgbData, rgbDataSize, image.data, pixelCount, rgbChannels, 3);
+
+                            if (decoded) legacyImages[k] = image;
+                            else
+                            {
+                                UnloadImage(image);
+                                LOG("WARNING: ICNS RGB data could not be decoded\n");
+                            }
+                        }
+                        else if ((memcmp(icnType, legacyMaskTypes[k], 4) == 0) && (icnSize >= (unsigned int)pixelCount)) legacyMasks[k] = icnsData + processedSize;
+                    }
+                }
+                // NOTE: In case OSType is not supported we just skip the required size
+
+                processedSize += icnSize;
+            }
+
+            // Legacy RGB images are completed with their masks (if available) and added to entries
+            // NOTE: Same size PNG/ARGB entries are preferred, they already include alpha channel
+            for (int k = 0; k < MAX_ICNS_LEGACY_SUPPORTED; k++)
+            {
+                if (legacyImages[k].data == NULL) continue;
+
+                bool duplicated = (imageCounter >= MAX_ICNS_IMAGE_SUPPORTED);
+                for (unsigned int j = 0; j < imageCounter; j++) if (entries[j].size == legacySizes[k]) duplicated = true;
+
+                if (duplicated) UnloadImage(legacyImages[k]);
+                else
+                {
+                    if (legacyMasks[k] != NULL) MergePixelDataAlpha(legacyImages[k].data, legacyMasks[k], legacySizes[k]*legacySizes[k]);
+
+                    entries[imageCounter].image = legacyImages[k];
+                    entries[imageCounter].size = legacySizes[k];
+                    imageCounter++;
+                }
+            }
+
+            LOG("INFO: Total images extracted from ICNS file: %i\n", imageCounter);
+        }
+    }
+
+    *count = imageCounter;
+    return entries;
+}
+
+#if !defined(RICONPACKER_LIBRARY)
+// Save icns file (Apple)
+// LIMITATIONS:
+//  - Supported OS Version: >=10.7
+//  - Supported PNG compressed images only
+//  - Supported OSTypes [8]: ic11, SB24, ic12, ic07, ic13, ic14, ic10
+//  - Supported image sizes [8]: 32, 48, 64, 128, 256, 512, 1024
+//  - No TOC or additional chunks supported
+//  - Main focus on .app package icns generation
+// REF: https://en.wikipedia.org/wiki/Apple_Icon_Image_format
+// NOTE: Returns false if there are no valid entries or file could not be written
+static bool SaveIconPackToICNS(IconEntry *entries, int entryCount, const char *fileName, IconExportOptions options)
+{
+    bool success = false;
+    int icnsDataSize = 0;
+    char *icnsData = ExportIconPackToICNSMemory(entries, entryCount, options, &icnsDataSize);
+
+    if (icnsData != NULL)
+    {
+        FILE *icnsFile = fopen(fileName, "wb");
+
+        if (icnsFile != NULL)
+        {
+            success = (fwrite(icnsData, 1, icnsDataSize, icnsFile) == (size_t)icnsDataSize);
+            if (fclose(icnsFile) != 0) success = false;
+        }
+
+        RL_FREE(icnsData);
+    }
+
+    return success;
+}
+#endif
+
+// Export icns file data to memory (Apple)
+// NOTE: Returns NULL if there are no valid entries, returned data must be freed by user (RL_FREE())
+static char *ExportIconPackToICNSMemory(IconEntry *entries, int entryCount, IconExportOptions options, int *dataSize)
+{
+    *dataSize = 0;
+
+    // Verify icon pack valid entries (not placeholder ones)
+    int packValidCount = 0;
+    for (int i = 0; i < entryCount; i++) if (entries[i].valid) packValidCount++;
+    if (packValidCount == 0) return NULL;
+/*
+    // NOTE: This validation is not required because it is already done when
+    // adding icons from input files into icon package entries
+
+    #define ICNS_MAX_SUPPORTED_IMAGES   8
+
+    // Validate input entries image data to get only supported sizes
+    int validCount = 0;
+    int validIndex[ICNS_MAX_SUPPORTED_IMAGES] = { -1 };
+    for (int i = 0; (i < entryCount) && (validCount < ICNS_MAX_SUPPORTED_IMAGES); i++)
+    {
+        if ((entries[i].image.width == 16) && (entries[i].image.height == 16)) { validIndex[validCount] = i; validCount++; }
+        else if ((entries[i].image.width == 32) && (entries[i].image.height == 32)) { validIndex[validCount] = i; validCount++; }
+        else if ((entries[i].image.width == 48) && (entries[i].image.height == 48)) { validIndex[validCount] = i; validCount++; }
+        else if ((entries[i].image.width == 64) && (entries[i].image.height == 64)) { validIndex[validCount] = i; validCount++; }
+        else if ((entries[i].image.width == 128) && (entries[i].image.height == 128)) { validIndex[validCount] = i; validCount++; }
+        else if ((entries[i].image.width == 256) && (entries[i].image.height == 256)) { validIndex[validCount] = i; validCount++; }
+        else if ((entries[i].image.width == 512) && (entries[i].image.height == 512)) { validIndex[validCount] = i; validCount++; }
+        else if ((entries[i].image.width == 1024) && (entries[i].image.height == 1024)) { validIndex[validCount] = i; validCount++; }
+    }
+*/
+    // Compress provided images into PNG data
+    char **pngDataPtrs = (char **)RL_CALLOC(packValidCount, sizeof(char *));     // Pointers array to PNG image data
+    int *pngDataSizes = (int *)RL_CALLOC(packValidCount, sizeof(int));          // PNG data size
+
+    // Compress valid entries into PNG data (in parallel), in the same order than entries
+    ExportIconEntriesToMemory(entries, entryCount, options, pngDataPtrs, pngDataSizes, NULL);
+
+    // We got the images converted to PNG in memory, now we can create the icns file data
+    // NOTE: ICNS file size, all file including header and entries headers (8 bytes each)
+    unsigned int icnsFileSize = 8 + 8*packValidCount;
+    for (int i = 0; i < packValidCount; i++) icnsFileSize += pngDataSizes[i];
+
+    char *icnsData = (char *)RL_MALLOC(icnsFileSize);
+    unsigned int dataOffset = 0;
+
+    if (icnsData != NULL)
+    {
+        /*
+        // Data structures to know how data is organized inside the .icns file
+
+        // Icns File Header (8 bytes)
+        typedef struct {
+        unsigned char id[4];        // Magic literal: "icns" (0x69, 0x63, 0x6e, 0x73)
+        unsigned int size;          // Length of file, in bytes, MSB first (Big Endian)
+        } IcnsHeader;
+
+        for (int i = 0; i < count; i++)
+        {
+        // Icon Entry info (8 bytes + data)
+        typedef struct {
+        unsigned char type[4];      // Icon type, defined by OSType (Big Endian)
+        unsigned int dataSize;      // Length of data, in bytes (including type and length), MSB first
+        unsigned char *data;        // Icon data
+        } IcnsEntry;
+        }
+        */
+
+        // Write icns header signature
+        // unsigned char icnsId[4] = { 0x69, 0x63, 0x6e, 0x73 };     // "icns"
+        memcpy(icnsData, "icns", 4);
+        unsigned char sizeBE[4] = { 0 };
+
+        // Write icns total data size (Big Endian)
+        sizeBE[0] = (icnsFileSize >> 24) & 0xFF;
+        sizeBE[1] = (icnsFileSize >> 16) & 0xFF;
+        sizeBE[2] = (icnsFileSize >> 8) & 0xFF;
+        sizeBE[3] = icnsFileSize & 0xFF;
+        memcpy(icnsData + 4, sizeBE, 4);
+        dataOffset = 8;
+
+        unsigned char icnType[4] = { 0 };
+
+        // Write icns entries
+        for (int i = 0, k = 0; i < entryCount; i++)
+        {
+            if (entries[i].valid)
+            {
+                switch (entries[i].image.width)
+                {
+                    case 16:   { icnType[0] = 'i'; icnType[1] = 'c'; icnType[2] = 'p'; icnType[3] = '4'; } break;   // icp4, not properly displayed on .app
+                    //case 32: { icnType[0] = 'i'; icnType[1] = 'c'; icnType[2] = 'p'; icnType[3] = '5'; } break;   // icp5, not properly displayed on .app
+                    case 32:   { icnType[0] = 'i'; icnType[1] = 'c'; icnType[2] = '1'; icnType[3] = '1'; } break;   // ic11 (16x16@2x "retina")
+                    //case 48: { icnType[0] = 'i'; icnType[1] = 'c'; icnType[2] = 'p'; icnType[3] = '6'; } break;   // icp6, not properly displayed on .app
+                    case 48:   { icnType[0] = 'S'; icnType[1] = 'B'; icnType[2] = '2'; icnType[3] = '4'; } break;   // SB24 (24x24@2x "retina")
+                    case 64:   { icnType[0] = 'i'; icnType[1] = 'c'; icnType[2] = '1'; icnType[3] = '2'; } break;   // ic12 (32x32@2x "retina")
+                    case 128:  { icnType[0] = 'i'; icnType[1] = 'c'; icnType[2] = '0'; icnType[3] = '7'; } break;   // ic07
+                   //case 256: { icnType[0] = 'i'; icnType[1] = 'c'; icnType[2] = '0'; icnType[3] = '8'; } break;   // ic08
+                    case 256:  { icnType[0] = 'i'; icnType[1] = 'c'; icnType[2] = '1'; icnType[3] = '3'; } break;   // ic13 (128x128@2x "retina")
+                   //case 512: { icnType[0] = 'i'; icnType[1] = 'c'; icnType[2] = '0'; icnType[3] = '9'; } break;   // ic09
+                    case 512:  { icnType[0] = 'i'; icnType[1] = 'c'; icnType[2] = '1'; icnType[3] = '4'; } break;   // ic14 (256x256@2x "retina")
+                    case 1024: { icnType[0] = 'i'; icnType[1] = 'c'; icnType[2] = '1'; icnType[3] = '0'; } break;   // ic10 (512x512@2x "retina")
+                    default: LOG("WARNING: Image size for ICNS generation not supported!\n"); break;
+                }
+
+                // Write entry type
+                memcpy(icnsData + dataOffset, icnType, 4);
+
+                // Write entry size (Big endian)
+                unsigned int size = pngDataSizes[k] + 8;   // Size must include type and length size
+                sizeBE[0] = (size >> 24) & 0xFF;
+                sizeBE[1] = (size >> 16) & 0xFF;
+                sizeBE[2] = (size >> 8) & 0xFF;
+                sizeBE[3] = size & 0xFF;
+                memcpy(icnsData + dataOffset + 4, sizeBE, 4);
+
+                // Write entry PNG icon data
+                memcpy(icnsData + dataOffset + 8, pngDataPtrs[k], pngDataSizes[k]);
+                dataOffset += size;
+
+                k++;
+            }
+        }
+
+        *dataSize = (int)icnsFileSize;
+    }
+
+    // NOTE: PNG data is owned by entries (encoded data cache)
+    RL_FREE(pngDataPtrs);
+    RL_FREE(pngDataSizes);
+
+    return icnsData;
+}
+
+// Icon image filter strategies encoding data (parallel task)
+typedef struct {
+    Image image;                // Image to encode
+    int colorChannels;          // Image color channels
+    const rpng_chunk *chunks;   // Extra chunks to write
+    int chunkCount;             // Extra chunks count
+    char *pngData[OPTIMAL_STRATEGIES_COUNT];    // Generated PNG data, one per filter strategy
+    int pngDataSize[OPTIMAL_STRATEGIES_COUNT];  // Generated PNG data size, one per filter strategy
+} IconStrategyTasks;
+
+// Export icon image with one filter strategy and optimal parsing deflate (parallel task)
+// NOTE: Every task uses its own encoder, work buffers are not shared
+static void ExportIconStrategyTask(void *userData, int index)
+{
+    IconStrategyTasks *tasks = (IconStrategyTasks *)userData;
+    rpng_encoder *encoder = AcquireIconEncoder();
+
+    tasks->pngData[index] = rpng_save_image_to_memory_chunks(encoder, tasks->image.data, tasks->image.width, tasks->image.height, tasks->colorChannels, 8,
+        index, RPNG_COMPRESSION_OPTIMAL, tasks->chunks, tasks->chunkCount, &tasks->pngDataSize[index]);
+
+    ReleaseIconEncoder(encoder);
+}
+
+// Export icon entry image as PNG file data (memory)
+// NOTE: Image text is embedded as a rIPt chunk if required by export options,
+// memory is allocated internally using RPNG_MALLOC(), must be freed with RPNG_FREE()
+static char *ExportIconEntryToMemory(IconEntry entry, IconExportOptions options, int *dataSize)
+{
+    // Image not loaded is decoded from entry encoded data, only for this export
+    // NOTE: Entry is a copy, decoded image is unloaded at the end
+    bool imageDecoded = (entry.image.data == NULL) && LoadIconEntryImage(&entry);
+
+    int colorChannels = 0;
+
+    // Image data format could be RGB (3 bytes) instead of RGBA (4 bytes)
+    if (entry.image.format == PIXELFORMAT_UNCOMPRESSED_R8G8B8) colorChannels = 3;
+    else if (entry.image.format == PIXELFORMAT_UNCOMPRESSED_R8G8B8A8) colorChannels = 4;
+
+    char *pngData = NULL;
+
+    // Image text is embedded as a rIPt chunk (after IHDR) on encoding, if required
+    rpng_chunk textChunk = { 0 };
+    int chunkCount = 0;
+
+    if (options.textChunk && (entry.text[0] != '\0'))
+    {
+        textChunk.data = (unsigned char *)entry.text;
+        textChunk.length = (int)strlen(entry.text);
+        memcpy(textChunk.type, "rIPt", 4);
+        chunkCount = 1;
+    }
+
+    // NOTE: Encoder work buffers are reused between entries, only output data is allocated
+    rpng_encoder *encoder = AcquireIconEncoder();
+
+    switch (options.compression)
+    {
+        case ICON_COMPRESSION_FAST:
+        {
+            // Fixed filter, no filter heuristic, low deflate level
+            pngData = rpng_save_image_to_memory_chunks(encoder, entry.image.data, entry.image.width, entry.image.height, colorChannels, 8, RPNG_FILTER_UP, 2, &textChunk, chunkCount, dataSize);
+        } break;
+        case ICON_COMPRESSION_MAX:
+        {
+            // Try all filter strategies (per-scanline adaptive and fixed ones), keep the smallest result
+            for (int filter = RPNG_FILTER_NONE; filter <= RPNG_FILTER_ADAPTIVE; filter++)
+            {
+                int size = 0;
+                char *data = rpng_save_image_to_memory_chunks(encoder, entry.image.data, entry.image.width, entry.image.height, colorChannels, 8, filter, RPNG_COMPRESSION_MAX, &textChunk, chunkCount, &size);
+
+                if ((data != NULL) && ((pngData == NULL) || (size < *dataSize)))
+                {
+                    RPNG_FREE(pngData);
+                    pngData = data;
+                    *dataSize = size;
+                }
+                else RPNG_FREE(data);
+            }
+        } break;
+        case ICON_COMPRESSION_OPTIMAL:
+        {
+            // Try all filter strategies (fixed, per-scanline adaptive and brute force) with optimal parsing deflate,
+            // strategies are encoded in parallel (up to options.threadCount threads), keep the smallest result
+            IconStrategyTasks tasks = { .image = entry.image, .colorChannels = colorChannels, .chunks = &textChunk, .chunkCount = chunkCount };
+            int threadCount = (options.threadCount > 0)? options.threadCount : GetProcessorCount();
+
+            RunParallelTasks(ExportIconStrategyTask, &tasks, OPTIMAL_STRATEGIES_COUNT, threadCount);
+
+            for (int i = 0; i < OPTIMAL_STRATEGIES_COUNT; i++)
+            {
+                if ((tasks.pngData[i] != NULL) && ((pngData == NULL) || (tasks.pngDataSize[i] < *dataSize)))
+                {
+                    RPNG_FREE(pngData);
+                    pngData = tasks.pngData[i];
+                    *dataSize = tasks.pngDataSize[i];
+                }
+                else RPNG_FREE(tasks.pngData[i]);
+            }
+        } break;
+        default: pngData = rpng_save_image_to_memory_chunks(encoder, entry.image.data, entry.image.width, entry.image.height, colorChannels, 8, RPNG_FILTER_ADAPTIVE, RPNG_COMPRESSION_DEFAULT, &textChunk, chunkCount, dataSize); break;
+    }
+
+    // Small entries are also encoded as indexed PNG (palette) if quantization error is low enough,
+    // smaller result is kept, truecolor data is used as fallback
+    if ((pngData != NULL) && (colorChannels > 0) && (entry.image.width <= options.paletteMaxSize))
+    {
+        int pixelCount = entry.image.width*entry.image.height;
+        unsigned char *indices = (unsigned char *)RL_MALLOC(pixelCount);
+        unsigned char palette[256*3] = { 0 };
+        unsigned char paletteAlpha[256] = { 0 };
+        float error = 0.0f;
+
+        int paletteSize = QuantizeImageData(entry.image.data, pixelCount, colorChannels, indices, palette, paletteAlpha, &error);
+
+        if ((paletteSize > 0) && (error <= PALETTE_MAX_ERROR))
+        {
+            // NOTE: Indexed data usually compresses better without filter, max/optimal compression levels also try adaptive filter
+            int level = (options.compression == ICON_COMPRESSION_FAST)? 2 : (options.compression == ICON_COMPRESSION_OPTIMAL)? RPNG_COMPRESSION_OPTIMAL : RPNG_COMPRESSION_DEFAULT;
+            int filters[2] = { RPNG_FILTER_NONE, RPNG_FILTER_ADAPTIVE };
+            int filterCount = (options.compression >= ICON_COMPRESSION_MAX)? 2 : 1;
+
+            for (int f = 0; f < filterCount; f++)
+            {
+                int size = 0;
+                char *data = rpng_save_image_indexed_to_memory_chunks(encoder, (const char *)indices, entry.image.width, entry.image.height, (const char *)palette,
+                    (colorChannels == 4)? (const char *)paletteAlpha : NULL, paletteSize, filters[f], level, &textChunk, chunkCount, &size);
+
+                if ((data != NULL) && (size < *dataSize))
+                {
+                    RPNG_FREE(pngData);
+                    pngData = data;
+                    *dataSize = size;
+                }
+                else RPNG_FREE(data);
+            }
+        }
+
+        RL_FREE(indices);
+    }
+
+    ReleaseIconEncoder(encoder);
+
+    if (imageDecoded) UnloadImage(entry.image);
+
+    return pngData;
+}
+
+#if !defined(RICONPACKER_LIBRARY)
+// Save icon entry image as .png file (or into zip archive)
+// NOTE: If a zip archive writer is provided, image is added to archive using fileName as entry name,
+// PNG data is already compressed, so it's stored without recompression
+static void SaveIconEntryToPNG(IconEntry entry, const char *fileName, IconExportOptions options, mz_zip_archive *zip)
+{
+    char *pngData = NULL;
+    int dataSize = 0;
+    bool cached = CheckIconEntryCache(entry, options);
+
+    // Use entry encoded data directly if valid for export options (i.e. source data)
+    if (cached)
+    {
+        pngData = entry.pngData;
+        dataSize = entry.pngDataSize;
+    }
+    else pngData = ExportIconEntryToMemory(entry, options, &dataSize);
+
+    if (pngData != NULL)
+    {
+        if (zip != NULL)
+        {
+            if (!mz_zip_writer_add_mem(zip, fileName, pngData, dataSize, MZ_NO_COMPRESSION)) fprintf(stderr, "WARNING: Image could not be added to zip archive: %s\n", fileName);
+        }
+        else SaveFileData(fileName, pngData, dataSize);
+    }
+
+    if (!cached) RPNG_FREE(pngData);
+}
+#endif
+
+// Load image from .ico DIB data (BMP without file header)
+// NOTE: Supported formats: 32bpp (BGRA), 24bpp (BGR) and 8/4/1bpp (palette), rows are stored bottom-up,
+// color data is followed by a 1bpp AND mask (transparency), only used if no alpha channel is available
+static Image LoadImageFromDIB(const unsigned char *data, int dataSize)
+{
+    Image image = { 0 };
+
+    if ((data == NULL) || (dataSize < (int)sizeof(DibHeader))) return image;
+
+    DibHeader header = { 0 };
+    memcpy(&header, data, sizeof(DibHeader));
+
+    int width = header.width;
+    int height = header.height/2;       // NOTE: Height includes AND mask
+    int bpp = header.bpp;
+
+    // Minimal header validation, BI_BITFIELDS is only supported for 32bpp (BGRA masks expected)
+    if ((header.size < sizeof(DibHeader)) || (header.size > (unsigned int)dataSize) ||
+        (width <= 0) || (width > 1024) || (height <= 0) || (height > 1024)) return image;
+    if ((bpp != 1) && (bpp != 4) && (bpp != 8) && (bpp != 24) && (bpp != 32)) return image;
+    if ((header.compression != 0) && !((header.compression == 3) && (bpp == 32))) return image;
+
+    int paletteOffset = header.size;
+    if ((header.compression == 3) && (header.size == sizeof(DibHeader))) paletteOffset += 12;       // Color masks after header
+
+    int paletteCount = 0;
+    if (bpp <= 8) paletteCount = (header.colorsUsed > 0)? header.colorsUsed : (1 << bpp);
+    if (paletteCount > 256) return image;
+
+    int colorOffset = paletteOffset + paletteCount*4;
+    int colorRowSize = ((width*bpp + 31)/32)*4;     // NOTE: Rows are 4-byte aligned
+    int maskRowSize = ((width + 31)/32)*4;
+
+    if (colorOffset + colorRowSize*height > dataSize) return image;
+
+    bool maskAvailable = ((colorOffset + colorRowSize*height + maskRowSize*height) <= dataSize);
+    bool alphaAvailable = false;
+
+    const unsigned char *palette = data + paletteOffset;
+    const unsigned char *colorData = data + colorOffset;
+    const unsigned char *maskData = colorData + colorRowSize*height;
+    unsigned char *pixels = (unsigned char *)RL_MALLOC(width*height*4);
+
+    for (int y = 0; y < height; y++)
+    {
+        const unsigned char *srcRow = colorData + (height - 1 - y)*colorRowSize;
+        unsigned char *dstRow = pixels + y*width*4;
+
+        if (bpp == 32)
+        {
+            SwapPixelDataRB(srcRow, dstRow, width);
+            for (int x = 0; !alphaAvailable && (x < width); x++) alphaAvailable = (dstRow[x*4 + 3] != 0);
+        }
+        else if (bpp == 24)
+        {
+            for (int x = 0; x < width; x++)
+            {
+                dstRow[x*4] = srcRow[x*3 + 2];
+                dstRow[x*4 + 1] = srcRow[x*3 + 1];
+                dstRow[x*4 + 2] = srcRow[x*3];
+                dstRow[x*4 + 3] = 255;
+            }
+        }
+        else
+        {
+            // Palette indices, packed MSB first, palette colors stored as BGRX
+            for (int x = 0; x < width; x++)
+            {
+                int bit = x*bpp;
+                int index = (srcRow[bit/8] >> (8 - bpp - bit%8)) & ((1 << bpp) - 1);
+
+                if (index < paletteCount)
+                {
+                    dstRow[x*4] = palette[index*4 + 2];
+                    dstRow[x*4 + 1] = palette[index*4 + 1];
+                    dstRow[x*4 + 2] = palette[index*4];
+                }
+                else memset(dstRow + x*4, 0, 3);
+
+                dstRow[x*4 + 3] = 255;
+            }
+        }
+    }
+
+    // Transparency from AND mask (bit set means transparent pixel)
+    // NOTE: 32bpp data with all alpha values set to 0 is considered as no alpha data (legacy icons)
+    if (!alphaAvailable)
+    {
+        if (bpp == 32) for (int i = 0; i < width*height; i++) pixels[i*4 + 3] = 255;
+
+        if (maskAvailable)
+        {
+            for (int y = 0; y < height; y++)
+            {
+                const unsigned char *maskRow = maskData + (height - 1 - y)*maskRowSize;
+
+                for (int x = 0; x < width; x++) if ((maskRow[x/8] >> (7 - x%8)) & 1) pixels[(y*width + x)*4 + 3] = 0;
+            }
+        }
+    }
+
+    image.data = pixels;
+    image.width = width;
+    image.height = height;
+    image.mipmaps = 1;
+    image.format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+
+    return image;
+}
+
+// Export icon entry image as .ico DIB data (32bpp + AND mask)
+// NOTE: Image text is not supported in DIB data, rows are stored bottom-up,
+// memory is allocated internally using RL_CALLOC(), must be freed with RL_FREE()
+static char *ExportIconEntryToDIB(IconEntry entry, int *dataSize)
+{
+    // Image not loaded is decoded from entry encoded data, only for this export
+    // NOTE: Entry is a copy, decoded image is unloaded at the end
+    bool imageDecoded = (entry.image.data == NULL) && LoadIconEntryImage(&entry);
+
+    int width = entry.image.width;
+    int height = entry.image.height;
+    int colorChannels = 0;
+
+    // Image data format could be RGB (3 bytes) instead of RGBA (4 bytes)
+    if (entry.image.format == PIXELFORMAT_UNCOMPRESSED_R8G8B8) colorChannels = 3;
+    else if (entry.image.format == PIXELFORMAT_UNCOMPRESSED_R8G8B8A8) colorChannels = 4;
+
+    char *dibData = NULL;
+    *dataSize = 0;
+
+    if ((entry.image.data != NULL) && (colorChannels > 0))
+    {
+        int maskRowSize = ((width + 31)/32)*4;      // NOTE: Mask rows are 4-byte aligned, color rows are always aligned (32bpp)
+
+        *dataSize = (int)sizeof(DibHeader) + width*height*4 + maskRowSize*height;
+        dibData = (char *)RL_CALLOC(*dataSize, 1);
+
+        DibHeader header = { .size = sizeof(DibHeader), .width = width, .height = height*2, .planes = 1, .bpp = 32,
+                             .compression = 0, .imageSize = *dataSize - (int)sizeof(DibHeader) };
+        memcpy(dibData, &header, sizeof(DibHeader));
+
+        unsigned char *colorData = (unsigned char *)dibData + sizeof(DibHeader);
+        unsigned char *maskData = colorData + width*height*4;
+
+        for (int y = 0; y < height; y++)
+        {
+            const unsigned char *srcRow = (const unsigned char *)entry.image.data + y*width*colorChannels;
+            unsigned char *dstRow = colorData + (height - 1 - y)*width*4;
+
+            if (colorChannels == 4)
+            {
+                SwapPixelDataRB(srcRow, dstRow, width);
+                GenPixelDataMask(srcRow, width, maskData + (height - 1 - y)*maskRowSize);
+            }
+            else
+            {
+                // NOTE: RGB image is opaque, AND mask is left empty
+                for (int x = 0; x < width; x++)
+                {
+                    dstRow[x*4] = srcRow[x*3 + 2];
+                    dstRow[x*4 + 1] = srcRow[x*3 + 1];
+                    dstRow[x*4 + 2] = srcRow[x*3];
+                    dstRow[x*4 + 3] = 255;
+                }
+            }
+        }
+    }
+
+    if (imageDecoded) UnloadImage(entry.image);
+
+    return dibData;
+}
+
+#if !defined(RICONPACKER_LIBRARY)
+// Get .ico DIB data size for an icon size (32bpp + AND mask)
+static int GetIconEntryDIBSize(int size)
+{
+    return (int)sizeof(DibHeader) + size*size*4 + ((size + 31)/32)*4*size;
+}
+#endif
+
+// Decode ICNS RLE data into RGBA image data, image channels are stored as consecutive planes
+// NOTE: Run header byte: [0x00..0x7f] next n + 1 bytes are literal, [0x80..0xff] next byte is repeated n - 125 times,
+// planes are mapped to RGBA channels (i.e. ARGB: 3, 0, 1, 2), decoded values are written directly into image data
+static bool DecodeIcnsRLE(const unsigned char *data, int dataSize, unsigned char *pixels, int pixelCount, const int *channels, int channelCount)
+{
+    int total = pixelCount*channelCount;
+    int index = 0;          // Decoded values
+    int pixel = 0;          // Current pixel in current plane
+    int plane = 0;          // Current plane
+    int i = 0;
+
+    while ((index < total) && (i < dataSize))
+    {
+        int header = data[i];
+        int count = (header < 0x80)? (header + 1) : (header - 125);
+        bool literal = (header < 0x80);
+        i++;
+
+        if ((literal && ((i + count) > dataSize)) || (!literal && (i >= dataSize))) return false;
+        if (count > (total - index)) count = total - index;
+
+        for (int k = 0; k < count; k++)
+        {
+            pixels[pixel*4 + channels[plane]] = literal? data[i + k] : data[i];
+
+            pixel++;
+            if (pixel == pixelCount) { pixel = 0; plane++; }
+        }
+
+        i += literal? count : 1;
+        index += count;
+    }
+
+    return (index == total);
+}
+
+// Swap red and blue channels (RGBA <-> BGRA), dstData can be srcData
+// NOTE: Pixels are processed 4 at once (SSE2) or 16 at once (NEON), if available
+static void SwapPixelDataRB(const unsigned char *srcData, unsigned char *dstData, int pixelCount)
+{
+    int i = 0;
+
+#if defined(RESAMPLE_SIMD_SSE2)
+    const __m128i maskGA = _mm_set1_epi32((int)0xff00ff00);
+    const __m128i maskLow = _mm_set1_epi32(0x000000ff);
+
+    for (; i <= (pixelCount - 4); i += 4)
+    {
+        __m128i pixels = _mm_loadu_si128((const __m128i *)(srcData + i*4));
+        __m128i rb = _mm_or_si128(_mm_and_si128(_mm_srli_epi32(pixels, 16), maskLow), _mm_slli_epi32(_mm_and_si128(pixels, maskLow), 16));
+        _mm_storeu_si128((__m128i *)(dstData + i*4), _mm_or_si128(_mm_and_si128(pixels, maskGA), rb));
+    }
+#elif defined(RESAMPLE_SIMD_NEON)
+    for (; i <= (pixelCount - 16); i += 16)
+    {
+        uint8x16x4_t pixels = vld4q_u8(srcData + i*4);
+        uint8x16_t red = pixels.val[0];
+        pixels.val[0] = pixels.val[2];
+        pixels.val[2] = red;
+        vst4q_u8(dstData + i*4, pixels);
+    }
+#endif
+    for (; i < pixelCount; i++)
+    {
+        unsigned char red = srcData[i*4];
+        dstData[i*4] = srcData[i*4 + 2];
+        dstData[i*4 + 1] = srcData[i*4 + 1];
+        dstData[i*4 + 2] = red;
+        dstData[i*4 + 3] = srcData[i*4 + 3];
+    }
+}
+
+// Generate 1bpp transparency mask from RGBA data (AND mask, MSB first)
+// NOTE: Mask bit is set for fully transparent pixels, mask must be able to store (pixelCount + 7)/8 bytes
+static void GenPixelDataMask(const unsigned char *data, int pixelCount, unsigned char *mask)
+{
+    int i = 0;
+
+#if defined(RESAMPLE_SIMD_SSE2)
+    // Alpha values checked 8 pixels at once, sign bits packed and reversed (MSB first)
+    static const unsigned char reversedBits[16] = { 0x0, 0x8, 0x4, 0xc, 0x2, 0xa, 0x6, 0xe, 0x1, 0x9, 0x5, 0xd, 0x3, 0xb, 0x7, 0xf };
+    const __m128i maskAlpha = _mm_set1_epi32((int)0xff000000);
+    const __m128i zero = _mm_setzero_si128();
+
+    for (; i <= (pixelCount - 8); i += 8)
+    {
+        __m128i low = _mm_cmpeq_epi32(_mm_and_si128(_mm_loadu_si128((const __m128i *)(data + i*4)), maskAlpha), zero);
+        __m128i high = _mm_cmpeq_epi32(_mm_and_si128(_mm_loadu_si128((const __m128i *)(data + i*4 + 16)), maskAlpha), zero);
+
+        mask[i/8] = (unsigned char)((reversedBits[_mm_movemask_ps(_mm_castsi128_ps(low))] << 4) | reversedBits[_mm_movemask_ps(_mm_castsi128_ps(high))]);
+    }
+#endif
+    for (; i < pixelCount; i++)
+    {
+        if ((i%8) == 0) mask[i/8] = 0;
+        if (data[i*4 + 3] == 0) mask[i/8] |= (0x80 >> (i%8));
+    }
+}
+
+// Merge alpha plane (8 bit per pixel) into RGBA data alpha channel
+// NOTE: Alpha values are expanded 16 at once (SSE2/NEON), if available
+static void MergePixelDataAlpha(unsigned char *data, const unsigned char *alpha, int pixelCount)
+{
+    int i = 0;
+
+#if defined(RESAMPLE_SIMD_SSE2)
+    const __m128i maskRGB = _mm_set1_epi32(0x00ffffff);
+    const __m128i zero = _mm_setzero_si128();
+
+    for (; i <= (pixelCount - 16); i += 16)
+    {
+        __m128i values = _mm_loadu_si128((const __m128i *)(alpha + i));
+        __m128i low = _mm_unpacklo_epi8(zero, values);     // Alpha values on 16bit lanes high byte
+        __m128i high = _mm_unpackhi_epi8(zero, values);
+        __m128i lanes[4] = { _mm_unpacklo_epi16(zero, low), _mm_unpackhi_epi16(zero, low), _mm_unpacklo_epi16(zero, high), _mm_unpackhi_epi16(zero, high) };
+
+        for (int k = 0; k < 4; k++)
+        {
+            __m128i *pixels = (__m128i *)(data + (i + k*4)*4);
+            _mm_storeu_si128(pixels, _mm_or_si128(_mm_and_si128(_mm_loadu_si128(pixels), maskRGB), lanes[k]));
+        }
+    }
+#elif defined(RESAMPLE_SIMD_NEON)
+    for (; i <= (pixelCount - 16); i += 16)
+    {
+        uint8x16x4_t pixels = vld4q_u8(data + i*4);
+        pixels.val[3] = vld1q_u8(alpha + i);
+        vst4q_u8(data + i*4, pixels);
+    }
+#endif
+    for (; i < pixelCount; i++) data[i*4 + 3] = alpha[i];
+}
+
+// Quantize image data to a palette (alpha-aware median cut), up to 256 colors
+// NOTE: Fully transparent pixels are considered the same color, they get their own palette entry,
+// color channels ranges are weighted by alpha when choosing the box to split, palette is sorted
+// by alpha (transparent entries first) and quantization error is returned (RMS, premultiplied alpha)
+static int QuantizeImageData(const unsigned char *data, int pixelCount, int channels, unsigned char *indices, unsigned char *palette, unsigned char *paletteAlpha, float *error)
+{
+    #define MAX_PALETTE_COLORS      256
+
+    // Get image unique colors (RGBA packed, sorted) and pixels count per color
+    unsigned int *colors = (unsigned int *)RL_MALLOC(pixelCount*sizeof(unsigned int));
+    int *counts = (int *)RL_MALLOC(pixelCount*sizeof(int));
+    int uniqueCount = 0;
+
+    for (int i = 0; i < pixelCount; i++)
+    {
+        const unsigned char *pixel = data + i*channels;
+        unsigned int alpha = (channels == 4)? pixel[3] : 255;
+
+        colors[i] = (alpha == 0)? 0 : ((unsigned int)pixel[0] | ((unsigned int)pixel[1] << 8) | ((unsigned int)pixel[2] << 16) | (alpha << 24));
+    }
+
+    qsort(colors, pixelCount, sizeof(unsigned int), CompareColors);
+
+    for (int i = 0; i < pixelCount; i++)
+    {
+        if ((uniqueCount > 0) && (colors[i] == colors[uniqueCount - 1])) counts[uniqueCount - 1]++;
+        else
+        {
+            colors[uniqueCount] = colors[i];
+            counts[uniqueCount] = 1;
+            uniqueCount++;
+        }
+    }
+
+    // Fully transparent color (0, sorted first) is not considered for median cut
+    int first = (colors[0] == 0)? 1 : 0;
+    int maxBoxes = MAX_PALETTE_COLORS - first;
+
+    int *order = (int *)RL_MALLOC(uniqueCount*sizeof(int));     // Unique colors indices, sorted by boxes
+    int *sorted = (int *)RL_MALLOC(uniqueCount*sizeof(int));
+    int boxStart[MAX_PALETTE_COLORS] = { 0 };
+    int boxEnd[MAX_PALETTE_COLORS] = { 0 };
+    int boxCount = 0;
+
+    for (int i = 0; i < uniqueCount; i++) order[i] = i;
+
+    if ((uniqueCount - first) <= maxBoxes)
+    {
+        // Enough palette entries available, one box per color (no quantization required)
+        for (int i = first; i < uniqueCount; i++) { boxStart[boxCount] = i; boxEnd[boxCount] = i + 1; boxCount++; }
+    }
+    else
+    {
+        boxStart[0] = first;
+        boxEnd[0] = uniqueCount;
+        boxCount = 1;
+
+        while (boxCount < maxBoxes)
+        {
+            // Choose box to split: biggest channel range weighted by box pixels
+            int bestBox = -1;
+            int bestChannel = 0;
+            double bestScore = 0.0;
+
+            for (int b = 0; b < boxCount; b++)
+            {
+                if ((boxEnd[b] - boxStart[b]) < 2) continue;
+
+                int minValue[4] = { 255, 255, 255, 255 };
+                int maxValue[4] = { 0 };
+                int pixels = 0;
+
+                for (int k = boxStart[b]; k < boxEnd[b]; k++)
+                {
+                    unsigned int color = colors[order[k]];
+                    pixels += counts[order[k]];
+
+                    for (int c = 0; c < 4; c++)
+                    {
+                        int value = (color >> (8*c)) & 0xff;
+                        if (value < minValue[c]) minValue[c] = value;
+                        if (value > maxValue[c]) maxValue[c] = value;
+                    }
+                }
+
+                for (int c = 0; c < 4; c++)
+                {
+                    // NOTE: Color differences are less visible on translucent colors
+                    int range = maxValue[c] - minValue[c];
+                    if (c < 3) range = range*maxValue[3]/255;
+
+                    double score = (double)range*pixels;
+                    if (score > bestScore) { bestScore = score; bestBox = b; bestChannel = c; }
+                }
+            }
+
+            if (bestBox < 0) break;     // No box can be split
+
+            // Sort box colors by chosen channel (counting sort)
+            int start = boxStart[bestBox];
+            int end = boxEnd[bestBox];
+            int offsets[257] = { 0 };
+
+            for (int k = start; k < end; k++) offsets[((colors[order[k]] >> (8*bestChannel)) & 0xff) + 1]++;
+            for (int v = 0; v < 256; v++) offsets[v + 1] += offsets[v];
+            for (int k = start; k < end; k++) sorted[start + offsets[(colors[order[k]] >> (8*bestChannel)) & 0xff]++] = order[k];
+            memcpy(order + start, sorted + start, (end - start)*sizeof(int));
+
+            // Split box at pixels median
+            int pixels = 0;
+            for (int k = start; k < end; k++) pixels += counts[order[k]];
+
+            int split = start + 1;
+            for (int k = start, accum = 0; k < (end - 1); k++)
+            {
+                accum += counts[order[k]];
+                split = k + 1;
+                if (accum*2 >= pixels) break;
+            }
+
+            boxStart[boxCount] = split;
+            boxEnd[boxCount] = end;
+            boxEnd[bestBox] = split;
+            boxCount++;
+        }
+    }
+
+    // Compute palette colors: box colors average, color channels weighted by alpha
+    unsigned int paletteColors[MAX_PALETTE_COLORS] = { 0 };
+    int paletteCount = first;       // NOTE: Transparent entry (if required) is palette color 0
+
+    for (int b = 0; b < boxCount; b++)
+    {
+        double sum[4] = { 0 };
+        double weight = 0.0;
+        int pixels = 0;
+
+        for (int k = boxStart[b]; k < boxEnd[b]; k++)
+        {
+            unsigned int color = colors[order[k]];
+            int count = counts[order[k]];
+            int alpha = color >> 24;
+
+            for (int c = 0; c < 3; c++) sum[c] += (double)((color >> (8*c)) & 0xff)*alpha*count;
+            sum[3] += (double)alpha*count;
+            weight += (double)alpha*count;
+            pixels += count;
+        }
+
+        unsigned int color = 0;
+        for (int c = 0; c < 3; c++) color |= (unsigned int)(sum[c]/weight + 0.5) << (8*c);
+        color |= (unsigned int)(sum[3]/pixels + 0.5) << 24;
+
+        paletteColors[paletteCount] = color;
+        paletteCount++;
+    }
+
+    // Map every unique color to nearest palette color, quantization error accumulated
+    int *mapping = (int *)RL_MALLOC(uniqueCount*sizeof(int));
+    double errorSum = 0.0;
+
+    for (int i = 0; i < uniqueCount; i++)
+    {
+        int best = 0;
+        int bestDistance = GetColorDistance(colors[i], paletteColors[0]);
+
+        for (int p = 1; (p < paletteCount) && (bestDistance > 0); p++)
+        {
+            int distance = GetColorDistance(colors[i], paletteColors[p]);
+            if (distance < bestDistance) { bestDistance = distance; best = p; }
+        }
+
+        mapping[i] = best;
+        errorSum += (double)bestDistance*counts[i];
+    }
+
+    *error = (float)sqrt(errorSum/((double)pixelCount*4));
+
+    // Sort palette by alpha (insertion sort, stable), transparent entries first
+    int paletteOrder[MAX_PALETTE_COLORS] = { 0 };
+    int paletteIndex[MAX_PALETTE_COLORS] = { 0 };
+
+    for (int p = 0; p < paletteCount; p++)
+    {
+        int k = p;
+        while ((k > 0) && ((paletteColors[paletteOrder[k - 1]] >> 24) > (paletteColors[p] >> 24))) { paletteOrder[k] = paletteOrder[k - 1]; k--; }
+        paletteOrder[k] = p;
+    }
+
+    for (int p = 0; p < paletteCount; p++)
+    {
+        unsigned int color = paletteColors[paletteOrder[p]];
+
+        palette[p*3] = color & 0xff;
+        palette[p*3 + 1] = (color >> 8) & 0xff;
+        palette[p*3 + 2] = (color >> 16) & 0xff;
+        paletteAlpha[p] = color >> 24;
+        paletteIndex[paletteOrder[p]] = p;
+    }
+
+    // Map image pixels to palette indices (unique colors binary search)
+    for (int i = 0; i < pixelCount; i++)
+    {
+        const unsigned char *pixel = data + i*channels;
+        unsigned int alpha = (channels == 4)? pixel[3] : 255;
+        unsigned int color = (alpha == 0)? 0 : ((unsigned int)pixel[0] | ((unsigned int)pixel[1] << 8) | ((unsigned int)pixel[2] << 16) | (alpha << 24));
+
+        int low = 0;
+        int high = uniqueCount - 1;
+
+        while (low < high)
+        {
+            int mid = (low + high)/2;
+            if (colors[mid] < color) low = mid + 1;
+            else high = mid;
+        }
+
+        indices[i] = (unsigned char)paletteIndex[mapping[low]];
+    }
+
+    RL_FREE(colors);
+    RL_FREE(counts);
+    RL_FREE(order);
+    RL_FREE(sorted);
+    RL_FREE(mapping);
+
+    return paletteCount;
+}
+
+// Get colors distance (squared), color channels premultiplied by alpha
+// NOTE: Colors are packed as RGBA, 8 bit per channel
+static int GetColorDistance(unsigned int color1, unsigned int color2)
+{
+    int alpha1 = color1 >> 24;
+    int alpha2 = color2 >> 24;
+    int distance = (alpha1 - alpha2)*(alpha1 - alpha2);
+
+    for (int c = 0; c < 3; c++)
+    {
+        int value = (int)((color1 >> (8*c)) & 0xff)*alpha1/255 - (int)((color2 >> (8*c)) & 0xff)*alpha2/255;
+        distance += value*value;
+    }
+
+    return distance;
+}
+
+// Compare packed colors (qsort() callback)
+static int CompareColors(const void *a, const void *b)
+{
+    unsigned int colorA = *(const unsigned int *)a;
+    unsigned int colorB = *(const unsigned int *)b;
+
+    return (colorA > colorB) - (colorA < colorB);
+}
+
+// Icon entries encoding data (parallel task)
+typedef struct {
+    IconEntry **entries;        // Valid entries to encode
+    IconExportOptions options;  // Export options
+    char **pngDataPtrs;         // Generated PNG data, one per entry
+    int *pngDataSizes;          // Generated PNG data size, one per entry
+    double *encodeTimes;        // Encoding time, one per entry (optional, NULL if not required)
+} IconEncodingTasks;
+
+// Export icon entry to memory (parallel task)
+// NOTE: Entry encoded data cache is only updated if not valid for export options
+static void ExportIconEntryTask(void *userData, int index)
+{
+    IconEncodingTasks *tasks = (IconEncodingTasks *)userData;
+    IconEntry *entry = tasks->entries[index];
+    double time = GetPerformanceTime();
+    bool encoded = false;
+
+    if (!CheckIconEntryCache(*entry, tasks->options))
+    {
+        // NOTE: Encoded data cache is unloaded after encoding, it's required if image is not loaded
+        int dataSize = 0;
+        char *pngData = ExportIconEntryToMemory(*entry, tasks->options, &dataSize);
+
+        UnloadIconEntryCache(entry);
+
+        entry->pngData = pngData;
+        entry->pngDataSize = dataSize;
+        entry->pngDataKey = ComputeIconEntryKey(*entry, tasks->options);
+        encoded = true;
+    }
+
+    tasks->pngDataPtrs[index] = entry->pngData;
+    tasks->pngDataSizes[index] = entry->pngDataSize;
+    if (tasks->encodeTimes != NULL) tasks->encodeTimes[index] = encoded? (GetPerformanceTime() - time) : 0.0;
+}
+
+// Export icon valid entries as PNG file data (memory), in parallel
+// NOTE: Entries are independent, they are encoded on multiple threads but generated
+// data is returned in the same order than valid entries, returns valid entries count
+// Encoded data is cached in every entry and only re-encoded if entry contents changed,
+// returned data pointers are owned by entries, they must not be freed (use UnloadIconEntryCache())
+// Encoding time of every valid entry is also returned (if encodeTimes is not NULL), 0 if cached data is valid
+// WARNING: pngDataPtrs, pngDataSizes and encodeTimes must be able to store all valid entries
+static int ExportIconEntriesToMemory(IconEntry *entries, int entryCount, IconExportOptions options, char **pngDataPtrs, int *pngDataSizes, double *encodeTimes)
+{
+    IconEntry **validEntries = (IconEntry **)RL_CALLOC(entryCount, sizeof(IconEntry *));
+    int validCount = 0;
+
+    for (int i = 0; i < entryCount; i++)
+    {
+        if (entries[i].valid)
+        {
+            validEntries[validCount] = &entries[i];
+            validCount++;
+        }
+    }
+
+    IconEncodingTasks tasks = { validEntries, options, pngDataPtrs, pngDataSizes, encodeTimes };
+    int threadCount = (options.threadCount > 0)? options.threadCount : GetProcessorCount();
+
+    // Optimal compression encodes filter strategies of every entry in parallel,
+    // available threads are split between entries and strategies
+    if (options.compression == ICON_COMPRESSION_OPTIMAL)
+    {
+        tasks.options.threadCount = (threadCount < OPTIMAL_STRATEGIES_COUNT)? threadCount : OPTIMAL_STRATEGIES_COUNT;
+        threadCount /= tasks.options.threadCount;
+    }
+
+    RunParallelTasks(ExportIconEntryTask, &tasks, validCount, threadCount);
+
+    RL_FREE(validEntries);
+
+    return validCount;
+}
+
+#if !defined(RICONPACKER_LIBRARY)
+// Get text lines available on icon pack
+// NOTE: Only valid icons considered
+static unsigned int CountIconPackTextLines(IconPack pack)
+{
+    unsigned int counter = 0;
+
+    for (int i = 0; i < pack.count; i++)
+    {
+        if (pack.entries[i].valid && (strlen(pack.entries[i].text) > 0))
+        {
+            //textLines[counter] = pack.entries[i].text;
+            counter++;
+        }
+    }
+
+    return counter;
+}
+
+// Add icon to bucket
+// NOTE: Function is thread-safe, it can be called from multiple threads with different buckets
+static void AddIconToBucket(IconBucket *bucket, const char *fileName)
+{
+    // NOTE: File is read once, same data is used for image decoding and text chunk reading
+    int fileSize = 0;
+    unsigned char *fileData = LoadFileData(fileName, &fileSize);
+
+    AddIconDataToBucket(bucket, fileData, fileSize, GetFileExtension(fileName));
+
+    UnloadFileData(fileData);
+}
+
+// Add icon to bucket from file data
+// NOTE: Entries do not reference file data, it can be unloaded once added
+static void AddIconDataToBucket(IconBucket *bucket, const unsigned char *fileData, int fileSize, const char *fileType)
+{
+    int imageCount = 0;
+
+    // Load all available entries
+    IconEntry *entries = LoadIconEntriesFromMemory(fileData, fileSize, fileType, &imageCount);
+
+    AddIconEntriesToBucket(bucket, entries, imageCount);
+
+    RL_FREE(entries);
+}
+
+// Get icon/image file type from file data signature
+// NOTE: Required for file data with no file name available (standard input)
+static const char *GetIconFileDataType(const unsigned char *fileData, int fileSize)
+{
+    const char *fileType = NULL;
+
+    if ((fileData == NULL) || (fileSize < 8)) return NULL;
+
+    if ((fileData[0] == 0) && (fileData[1] == 0) && (fileData[2] == 1) && (fileData[3] == 0)) fileType = ".ico";
+    else if (memcmp(fileData, "icns", 4) == 0) fileType = ".icns";
+    else if (memcmp(fileData, "\x89PNG\r\n\x1a\n", 8) == 0) fileType = ".png";
+    else if (memcmp(fileData, "qoif", 4) == 0) fileType = ".qoi";
+    else if ((fileData[0] == 'B') && (fileData[1] == 'M')) fileType = ".bmp";
+
+    return fileType;
+}
+#endif
+
+// Load icon entries from file data: icon files (.ico, .icns) or image files (.png, .bmp, .qoi)
+// NOTE: File type is the file extension (including the dot), entries do not reference file data
+static IconEntry *LoadIconEntriesFromMemory(const unsigned char *fileData, int fileSize, const char *fileType, int *count)
+{
+    IconEntry *entries = NULL;
+    int imageCount = 0;
+
+    if ((fileData == NULL) || (fileType == NULL)) { *count = 0; return NULL; }
+
+    if (CheckFileExtension(fileType, ".ico")) entries = LoadIconPackFromICOMemory(fileData, fileSize, &imageCount);
+    else if (CheckFileExtension(fileType, ".icns")) entries = LoadIconPackFromICNSMemory(fileData, fileSize, &imageCount);
+    else if (CheckFileExtension(fileType, ".png;.bmp;.qoi"))
+    {
+        Image image = LoadImageFromMemory(fileType, fileData, fileSize);
+
+        // Minimal image validation
+        if ((image.data != NULL) && (image.width <= 1024) && (image.width == image.height))
+        {
+            imageCount = 1;
+            entries = (IconEntry *)RL_CALLOC(imageCount, sizeof(IconEntry));
+            entries[0].image = image;
+            entries[0].size = image.width;
+
+            // Read custom rIconPacker text chunk from PNG (if available)
+            // NOTE: Chunk data points to file data, no copy required
+            rpng_chunk chunk = rpng_chunk_find_from_memory((const char *)fileData, fileSize, "rIPt");
+            if (chunk.length > 0) memcpy(entries[0].text, chunk.data, (chunk.length < MAX_IMAGE_TEXT_SIZE)? chunk.length : MAX_IMAGE_TEXT_SIZE - 1);
+        }
+        else UnloadImage(image);
+    }
+
+    *count = imageCount;
+    return entries;
+}
+
+// Add icon entries to bucket, replacing same size entries
+// NOTE: Bucket takes ownership of entries data, bucket grows as required and it's kept sorted by size
+static void AddIconEntriesToBucket(IconBucket *bucket, IconEntry *entries, int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        int insertIndex = 0;
+        int dupIndex = FindIconBucketEntry(*bucket, entries[i].size, &insertIndex);
+
+        if (dupIndex > -1)
+        {
+            // Found bucket entry with same size -> replace bucket entry!
+            UnloadImage(bucket->entries[dupIndex].image);
+            UnloadIconEntryCache(&bucket->entries[dupIndex]);
+
+            bucket->entries[dupIndex] = entries[i];
+            continue;
+        }
+
+        // Grow bucket if required
+        if (bucket->count >= bucket->capacity)
+        {
+            int capacity = (bucket->capacity > 0)? bucket->capacity*2 : ICON_BUCKET_INITIAL_CAPACITY;
+            IconEntry *newEntries = (IconEntry *)RL_REALLOC(bucket->entries, capacity*sizeof(IconEntry));
+
+            if (newEntries == NULL)
+            {
+                // No space available in bucket, entry discarded
+                UnloadImage(entries[i].image);
+                UnloadIconEntryCache(&entries[i]);
+                continue;
+            }
+
+            bucket->entries = newEntries;
+            bucket->capacity = capacity;
+        }
+
+        // Insert new entry keeping bucket sorted
+        memmove(bucket->entries + insertIndex + 1, bucket->entries + insertIndex, (bucket->count - insertIndex)*sizeof(IconEntry));
+        bucket->entries[insertIndex] = entries[i];
+        bucket->count++;
+    }
+}
+
+// Find bucket entry index by size (binary search over sorted entries), -1 if not found
+// NOTE: If not found, insertIndex (if provided) returns the index for a new entry with that size
+static int FindIconBucketEntry(IconBucket bucket, int size, int *insertIndex)
+{
+    int low = 0;
+    int high = (int)bucket.count - 1;
+
+    while (low <= high)
+    {
+        int mid = low + (high - low)/2;
+
+        if (bucket.entries[mid].size == size) return mid;
+        else if (bucket.entries[mid].size > size) low = mid + 1;    // Descending order
+        else high = mid - 1;
+    }
+
+    if (insertIndex != NULL) *insertIndex = low;
+
+    return -1;
+}
+
+#if !defined(RICONPACKER_LIBRARY)
+// Remove icon from bucket
+// NOTE: Bucket entry image and encoded data cache are unloaded, bucket is kept sorted
+static void RemoveIconFromBucket(IconBucket *bucket, unsigned int size)
+{
+    int index = FindIconBucketEntry(*bucket, size, NULL);
+
+    if (index > -1)
+    {
+        UnloadImage(bucket->entries[index].image);
+        UnloadIconEntryCache(&bucket->entries[index]);
+
+        memmove(bucket->entries + index, bucket->entries + index + 1, (bucket->count - index - 1)*sizeof(IconEntry));
+        bucket->count--;
+    }
+}
+#endif
+
+// Clear icon bucket
+static void ClearIconBucket(IconBucket *bucket)
+{
+    for (int i = 0; i < bucket->count; i++)
+    {
+        UnloadImage(bucket->entries[i].image);
+        UnloadIconEntryCache(&bucket->entries[i]);
+        bucket->entries[i] = (IconEntry){ 0 };
+    }
+
+    bucket->count = 0;
+}
+
+#if !defined(RICONPACKER_LIBRARY)
+// NOTE: Platform determines the requested sizes
+static void UpdateIconPackFromBucket(IconPack *pack, IconBucket bucket)
+{
+    for (int k = 0; k < pack->count; k++)
+    {
+        int i = FindIconBucketEntry(bucket, pack->entries[k].size, NULL);
+
+        if (i >= 0)
+        {
+            // NOTE: Bucket image is decoded for preview, if not loaded yet
+            LoadIconEntryImage(&bucket.entries[i]);
+
+            if (pack->entries[k].generated) UnloadImage(pack->entries[k].image);
+            UnloadIconEntryCache(&pack->entries[k]);
+
+            // NOTE: Bucket entries images are shared with pack, encoded data cache is copied
+            pack->entries[k] = bucket.entries[i];
+            CopyIconEntryCache(&pack->entries[k], bucket.entries[i]);
+
+            pack->entries[k].valid = true;
+            pack->entries[k].generated = false;
+
+            UpdateIconPackAtlas(pack, k);
+        }
+    }
+}
+
+// Reset icon pack data
+// NOTE: Pack arrays grow if platform requires more sizes than current capacity
+static void ResetIconPack(IconPack *pack, int platform)
+{
+    // Clear full pack
+    for (int i = 0; i < pack->capacity; i++)
+    {
+        if (pack->entries[i].generated) UnloadImage(pack->entries[i].image);
+        else pack->entries[i].image = (Image){ 0 };      // Remove bucket image (not unload)
+        UnloadIconEntryCache(&pack->entries[i]);
+
+        pack->pending[i] = false;           // Pending generation results are discarded
+
+        memset(pack->entries[i].text, 0, MAX_IMAGE_TEXT_SIZE);
+        pack->entries[i].generated = false;
+        pack->entries[i].valid = false;
+        pack->entries[i].size = 0;
+    }
+
+    // Reset to required platform
+    int count = 0;
+    unsigned int *platformSizes = GetPlatformSizes(platform, &count);
+
+    if (count > pack->capacity)
+    {
+        RL_FREE(pack->entries);
+        RL_FREE(pack->recs);
+        RL_FREE(pack->pending);
+
+        pack->entries = (IconEntry *)RL_CALLOC(count, sizeof(IconEntry));
+        pack->recs = (Rectangle *)RL_CALLOC(count, sizeof(Rectangle));
+        pack->pending = (bool *)RL_CALLOC(count, sizeof(bool));
+        pack->capacity = count;
+    }
+
+    pack->count = count;
+    for (int i = 0; i < pack->count; i++) pack->entries[i].size = platformSizes[i];
+
+    // Layout atlas rectangles: rows filled in sizes order (descending), row height defined by first size,
+    // atlas width starts on biggest size and it's doubled while it gets a more squared atlas
+    // NOTE: Below 256x256 sizes are not expected to be bigger than first size on platform schemes
+    int atlasWidth = 0;
+    int atlasHeight = 0;
+
+    for (int width = (pack->count > 0)? pack->entries[0].size : 0; width > 0; width *= 2)
+    {
+        int x = 0, y = 0, rowHeight = 0;
+
+        for (int i = 0; i < pack->count; i++)
+        {
+            int size = pack->entries[i].size;
+            if ((x + size) > width) { x = 0; y += rowHeight; rowHeight = 0; }
+            if (rowHeight == 0) rowHeight = size;
+
+            x += size;
+        }
+
+        int height = y + rowHeight;
+        if ((atlasWidth > 0) && (((width > height)? width : height) >= ((atlasWidth > atlasHeight)? atlasWidth : atlasHeight))) break;
+
+        atlasWidth = width;
+        atlasHeight = height;
+    }
+
+    int x = 0, y = 0, rowHeight = 0;
+
+    for (int i = 0; i < pack->count; i++)
+    {
+        int size = pack->entries[i].size;
+        if ((x + size) > atlasWidth) { x = 0; y += rowHeight; rowHeight = 0; }
+        if (rowHeight == 0) rowHeight = size;
+
+        pack->recs[i] = (Rectangle){ (float)x, (float)y, (float)size, (float)size };
+        x += size;
+    }
+
+    // Atlas texture is reloaded on next entry update only if layout size changed
+    // NOTE: Texture can not be loaded here, pack is reset before window (and GPU context) initialization
+    if ((pack->atlas.id > 0) && ((pack->atlas.width != atlasWidth) || (pack->atlas.height != atlasHeight)))
+    {
+        UnloadTexture(pack->atlas);
+        pack->atlas = (Texture2D){ 0 };
+    }
+}
+
+// Update icon pack atlas texture rectangle with entry image
+// NOTE: Only entry rectangle is uploaded to GPU, atlas texture is loaded on first update
+static void UpdateIconPackAtlas(IconPack *pack, int index)
+{
+    Image image = pack->entries[index].image;
+    Rectangle rec = pack->recs[index];
+
+    if ((image.data == NULL) || (image.width != (int)rec.width) || (image.height != (int)rec.height)) return;
+
+    if (pack->atlas.id == 0)
+    {
+        int atlasWidth = 0;
+        int atlasHeight = 0;
+
+        for (int i = 0; i < pack->count; i++)
+        {
+            if ((pack->recs[i].x + pack->recs[i].width) > atlasWidth) atlasWidth = (int)(pack->recs[i].x + pack->recs[i].width);
+            if ((pack->recs[i].y + pack->recs[i].height) > atlasHeight) atlasHeight = (int)(pack->recs[i].y + pack->recs[i].height);
+        }
+
+        Image atlas = GenImageColor(atlasWidth, atlasHeight, BLANK);
+        pack->atlas = LoadTextureFromImage(atlas);
+        UnloadImage(atlas);
+    }
+
+    // Atlas texture format is RGBA 32bit, image is converted if required
+    if (image.format == PIXELFORMAT_UNCOMPRESSED_R8G8B8A8) UpdateTextureRec(pack->atlas, rec, image.data);
+    else
+    {
+        Image imageRGBA = ImageCopy(image);
+        ImageFormat(&imageRGBA, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+        UpdateTextureRec(pack->atlas, rec, imageRGBA.data);
+        UnloadImage(imageRGBA);
+    }
+}
+
+// Unload icon pack, all entries and arrays
+static void UnloadIconPack(IconPack *pack)
+{
+    ResetIconPack(pack, -1);        // NOTE: No platform, all entries are unloaded
+
+    RL_FREE(pack->entries);
+    RL_FREE(pack->recs);
+    RL_FREE(pack->pending);
+
+    *pack = (IconPack){ 0 };
+}
+#endif
+
+// Get platform sizes scheme (descending order)
+static unsigned int *GetPlatformSizes(int platform, int *count)
+{
+    unsigned int *sizes = NULL;
+    *count = 0;
+
+    switch (platform)
+    {
+        case ICON_PLATFORM_WINDOWS: sizes = icoSizesWindows; *count = 8; break;
+        case ICON_PLATFORM_MACOS: sizes = icoSizesMacOS; *count = 8; break;
+        case ICON_PLATFORM_FAVICON: sizes = icoSizesFavicon; *count = 10; break;
+        case ICON_PLATFORM_ANDROID: sizes = icoSizesAndroid; *count = 10; break;
+        case ICON_PLATFORM_IOS7: sizes = icoSizesiOS; *count = 9; break;
+        case ICON_PLATFORM_ALL: sizes = icoSizesAll; *count = 32; break;
+        default: break;
+    }
+
+    return sizes;
+}
+
+// Check file extension, multiple extensions can be provided separated by ';'
+// NOTE: Thread-safe alternative to IsFileExtension(), no internal static buffers used
+static bool CheckFileExtension(const char *fileName, const char *ext)
+{
+    const char *fileExt = strrchr(fileName, '.');
+    if (fileExt == NULL) return false;
+
+    int fileExtLength = (int)strlen(fileExt);
+    const char *extPtr = ext;
+
+    while (*extPtr != '\0')
+    {
+        // Get current extension length in the list
+        int extLength = 0;
+        while ((extPtr[extLength] != '\0') && (extPtr[extLength] != ';')) extLength++;
+
+        if (extLength == fileExtLength)
+        {
+            bool match = true;
+
+            // Case-insensitive comparison
+            for (int i = 0; i < extLength; i++)
+            {
+                char c1 = fileExt[i];
+                char c2 = extPtr[i];
+                if ((c1 >= 'A') && (c1 <= 'Z')) c1 += 32;
+                if ((c2 >= 'A') && (c2 <= 'Z')) c2 += 32;
+
+                if (c1 != c2) { match = false; break; }
+            }
+
+            if (match) return true;
+        }
+
+        extPtr += extLength;
+        if (*extPtr == ';') extPtr++;
+    }
+
+    return false;
+}
+
+// Generate multiple icon sizes from image, filtering image only once
+// NOTE: Bicubic: image is progressively halved (2x2 box filter) into one reused work buffer,
+// every size is resampled from the smallest level still bigger than the size, in descending order
+// Nearest-neighbor: every size is sampled directly from image, no intermediate copies
+// Box/Lanczos3: every size is resampled directly from image (separable filter), rows split across threadCount threads
+// Generated images are returned in provided sizes order, they must be unloaded by user
+static void GenerateIconSizes(Image image, const int *sizes, int count, int scaleAlgorythm, int threadCount, Image *outImages)
+{
+    int bpp = 0;    // Bytes per pixel, only formats with 8 bit per channel are directly processed
+
+    switch (image.format)
+    {
+        case PIXELFORMAT_UNCOMPRESSED_GRAYSCALE: bpp = 1; break;
+        case PIXELFORMAT_UNCOMPRESSED_GRAY_ALPHA: bpp = 2; break;
+        case PIXELFORMAT_UNCOMPRESSED_R8G8B8: bpp = 3; break;
+        case PIXELFORMAT_UNCOMPRESSED_R8G8B8A8: bpp = 4; break;
+        default: break;
+    }
+
+    // Other pixel formats: resize every size from a full image copy
+    if ((bpp == 0) || (image.mipmaps > 1))
+    {
+        for (int i = 0; i < count; i++)
+        {
+            outImages[i] = ImageCopy(image);
+
+            if (scaleAlgorythm == 1) ImageResizeNN(&outImages[i], sizes[i], sizes[i]);
+            else ImageResize(&outImages[i], sizes[i], sizes[i]);
+        }
+
+        return;
+    }
+
+    if (scaleAlgorythm == 1)
+    {
+        // Nearest-neighbor scaling: sample every size directly from image
+        for (int i = 0; i < count; i++)
+        {
+            int size = sizes[i];
+            unsigned char *data = (unsigned char *)RL_MALLOC(size*size*bpp);
+
+            for (int y = 0; y < size; y++)
+            {
+                const unsigned char *srcRow = (const unsigned char *)image.data + (y*image.height/size)*image.width*bpp;
+
+                for (int x = 0; x < size; x++) memcpy(data + (y*size + x)*bpp, srcRow + (x*image.width/size)*bpp, bpp);
+            }
+
+            outImages[i] = (Image){ data, size, size, 1, image.format };
+        }
+
+        return;
+    }
+
+    if ((scaleAlgorythm == 3) || (scaleAlgorythm == 4))
+    {
+        // Box/Lanczos3 filtering: resample every size directly from image
+        // NOTE: Image is converted to premultiplied alpha data only once, shared by all sizes
+        int filter = (scaleAlgorythm == 3)? RESAMPLE_FILTER_BOX : RESAMPLE_FILTER_LANCZOS3;
+        float *srcData = LoadPremultipliedData((const unsigned char *)image.data, image.width, image.height, bpp);
+
+        for (int i = 0; i < count; i++)
+        {
+            int size = sizes[i];
+            unsigned char *data = (unsigned char *)RL_MALLOC(size*size*bpp);
+
+            ResampleImageData(srcData, image.width, image.height, bpp, data, size, size, filter, threadCount);
+
+            outImages[i] = (Image){ data, size, size, 1, image.format };
+        }
+
+        RL_FREE(srcData);
+
+        return;
+    }
+
+    // Sort sizes indices in descending order, to move down the ladder only once
+    int *order = (int *)RL_MALLOC(count*sizeof(int));
+    for (int i = 0; i < count; i++) order[i] = i;
+
+    for (int i = 1; i < count; i++)
+    {
+        int index = order[i];
+        int j = i - 1;
+
+        while ((j >= 0) && (sizes[order[j]] < sizes[index])) { order[j + 1] = order[j]; j--; }
+        order[j + 1] = index;
+    }
+
+    Image level = image;                // Current ladder level, provided image is never modified
+    unsigned char *levelData = NULL;    // Work buffer, allocated on first halving and reused by next levels
+
+    for (int i = 0; i < count; i++)
+    {
+        int size = sizes[order[i]];
+
+        // Halve current level while it is still bigger than twice the requested size
+        while (((level.width/2) >= size) && ((level.height/2) >= size))
+        {
+            if (levelData == NULL) levelData = (unsigned char *)RL_MALLOC((level.width/2)*(level.height/2)*bpp);
+
+            HalveImageData((const unsigned char *)level.data, level.width, level.height, bpp, levelData);
+
+            level.data = levelData;
+            level.width /= 2;
+            level.height /= 2;
+        }
+
+        // Final precise resample from current level (only if required)
+        outImages[order[i]] = ImageCopy(level);
+        if ((level.width != size) || (level.height != size)) ImageResize(&outImages[order[i]], size, size);
+    }
+
+    RL_FREE(levelData);
+    RL_FREE(order);
+}
+
+// Halve image data size using a 2x2 box filter, dstData can be srcData (in-place)
+// NOTE: Color channels are weighted by alpha (formats with alpha), to avoid dark borders on transparent areas
+static void HalveImageData(const unsigned char *srcData, int width, int height, int bpp, unsigned char *dstData)
+{
+    int halfWidth = width/2;
+    int halfHeight = height/2;
+    int alphaChannel = ((bpp == 2) || (bpp == 4))? (bpp - 1) : -1;
+
+    for (int y = 0; y < halfHeight; y++)
+    {
+        const unsigned char *row0 = srcData + (2*y)*width*bpp;
+        const unsigned char *row1 = row0 + width*bpp;
+
+        for (int x = 0; x < halfWidth; x++)
+        {
+            const unsigned char *p0 = row0 + (2*x)*bpp;
+            const unsigned char *p1 = p0 + bpp;
+            const unsigned char *p2 = row1 + (2*x)*bpp;
+            const unsigned char *p3 = p2 + bpp;
+            unsigned char pixel[4] = { 0 };
+
+            unsigned int alphaSum = (alphaChannel >= 0)? (p0[alphaChannel] + p1[alphaChannel] + p2[alphaChannel] + p3[alphaChannel]) : 0;
+
+            for (int c = 0; c < bpp; c++)
+            {
+                if ((c == alphaChannel) || (alphaSum == 0)) pixel[c] = (unsigned char)((p0[c] + p1[c] + p2[c] + p3[c] + 2)/4);
+                else pixel[c] = (unsigned char)((p0[c]*p0[alphaChannel] + p1[c]*p1[alphaChannel] + p2[c]*p2[alphaChannel] + p3[c]*p3[alphaChannel] + alphaSum/2)/alphaSum);
+            }
+
+            // NOTE: Pixel is written after reading all source pixels, required for in-place processing
+            memcpy(dstData + (y*halfWidth + x)*bpp, pixel, bpp);
+        }
+    }
+}
+
+// Load image data as float, color channels premultiplied by alpha (formats with alpha)
+// NOTE: Filtering premultiplied colors avoids dark borders on transparent areas
+static float *LoadPremultipliedData(const unsigned char *data, int width, int height, int bpp)
+{
+    int alphaChannel = ((bpp == 2) || (bpp == 4))? (bpp - 1) : -1;
+    float *premultData = (float *)RL_MALLOC(width*height*bpp*sizeof(float));
+
+    for (int i = 0; i < width*height; i++)
+    {
+        const unsigned char *pixel = data + i*bpp;
+        float alpha = (alphaChannel >= 0)? pixel[alphaChannel]/255.0f : 1.0f;
+
+        for (int c = 0; c < bpp; c++) premultData[i*bpp + c] = pixel[c]*alpha;
+        if (alphaChannel >= 0) premultData[i*bpp + alphaChannel] = pixel[alphaChannel];
+    }
+
+    return premultData;
+}
+
+// Resample premultiplied image data using a separable filter (horizontal pass, then vertical pass)
+// NOTE: Resampled color channels are unpremultiplied on conversion back to 8 bit per channel,
+// large images rows are split in bands processed by up to threadCount threads
+static void ResampleImageData(const float *srcData, int srcWidth, int srcHeight, int bpp, unsigned char *dstData, int dstWidth, int dstHeight, int filter, int threadCount)
+{
+    ResampleTasks tasks = { 0 };
+    tasks.srcData = srcData;
+    tasks.srcWidth = srcWidth;
+    tasks.srcHeight = srcHeight;
+    tasks.dstData = dstData;
+    tasks.dstWidth = dstWidth;
+    tasks.dstHeight = dstHeight;
+    tasks.bpp = bpp;
+    tasks.alphaChannel = ((bpp == 2) || (bpp == 4))? (bpp - 1) : -1;
+    tasks.horizontal = LoadResampleWeights(srcWidth, dstWidth, filter);
+    tasks.vertical = LoadResampleWeights(srcHeight, dstHeight, filter);
+    tasks.tmpData = (float *)RL_MALLOC(dstWidth*srcHeight*bpp*sizeof(float));
+
+    // Small images are resampled directly by calling thread, not worth to split them
+    if ((threadCount < 1) || ((srcWidth*srcHeight) < RESAMPLE_PARALLEL_MIN_PIXELS)) threadCount = 1;
+    tasks.bandCount = (threadCount > 1)? threadCount*4 : 1;     // More bands than threads, to balance load
+
+    // NOTE: Vertical pass requires all horizontally resampled rows, passes are run one after the other
+    RunParallelTasks(ResampleHorizontalTask, &tasks, tasks.bandCount, threadCount);
+    RunParallelTasks(ResampleVerticalTask, &tasks, tasks.bandCount, threadCount);
+
+    RL_FREE(tasks.tmpData);
+    UnloadResampleWeights(tasks.horizontal);
+    UnloadResampleWeights(tasks.vertical);
+}
+
+// Load resampling weights for one axis
+// NOTE: On downscaling, filter support is widened by scale factor (every source pixel contributes),
+// box weights are computed as the exact overlap of source pixels with destination pixel area
+static ResampleWeights LoadResampleWeights(int srcSize, int dstSize, int filter)
+{
+    ResampleWeights weights = { 0 };
+
+    float ratio = (float)srcSize/dstSize;
+    float scale = (ratio > 1.0f)? ratio : 1.0f;
+    float support = (filter == RESAMPLE_FILTER_BOX)? 0.5f*scale : 3.0f*scale;
+
+    weights.maxTaps = (int)ceilf(2.0f*support) + 2;
+    weights.start = (int *)RL_CALLOC(dstSize, sizeof(int));
+    weights.count = (int *)RL_CALLOC(dstSize, sizeof(int));
+    weights.weights = (float *)RL_CALLOC(dstSize*weights.maxTaps, sizeof(float));
+
+    for (int i = 0; i < dstSize; i++)
+    {
+        float center = (i + 0.5f)*ratio;    // Destination pixel center, in source coordinates
+        int left = (int)floorf(center - support);
+        int right = (int)ceilf(center + support);
+
+        if (left < 0) left = 0;
+        if (right > srcSize) right = srcSize;
+        if ((right - left) > weights.maxTaps) right = left + weights.maxTaps;
+
+        float *w = weights.weights + i*weights.maxTaps;
+        float sum = 0.0f;
+
+        for (int j = left; j < right; j++)
+        {
+            float value = 0.0f;
+
+            if (filter == RESAMPLE_FILTER_BOX)
+            {
+                // Overlap of source pixel [j, j + 1] with destination pixel area
+                float start = ((float)j > (center - support))? (float)j : (center - support);
+                float end = ((float)(j + 1) < (center + support))? (float)(j + 1) : (center + support);
+                if (end > start) value = end - start;
+            }
+            else
+            {
+                // Lanczos3: sinc(x)*sinc(x/3), |x| < 3
+                float x = (j + 0.5f - center)/scale;
+                if (x < 0.0f) x = -x;
+
+                if (x < 1e-6f) value = 1.0f;
+                else if (x < 3.0f)
+                {
+                    float px = PI*x;
+                    value = 3.0f*sinf(px)*sinf(px/3.0f)/(px*px);
+                }
+            }
+
+            w[j - left] = value;
+            sum += value;
+        }
+
+        // Normalize weights, source borders are clamped (missing pixels not considered)
+        if (sum != 0.0f) for (int j = 0; j < (right - left); j++) w[j] /= sum;
+
+        weights.start[i] = left;
+        weights.count[i] = right - left;
+    }
+
+    return weights;
+}
+
+// Unload resampling weights
+static void UnloadResampleWeights(ResampleWeights weights)
+{
+    RL_FREE(weights.start);
+    RL_FREE(weights.count);
+    RL_FREE(weights.weights);
+}
+
+// Resample one band of source rows horizontally, premultiplied alpha float data
+static void ResampleHorizontalTask(void *userData, int index)
+{
+    ResampleTasks *tasks = (ResampleTasks *)userData;
+    int bpp = tasks->bpp;
+    int rowStart = tasks->srcHeight*index/tasks->bandCount;
+    int rowEnd = tasks->srcHeight*(index + 1)/tasks->bandCount;
+
+    for (int y = rowStart; y < rowEnd; y++)
+    {
+        const float *row = tasks->srcData + y*tasks->srcWidth*bpp;
+        float *tmpRow = tasks->tmpData + y*tasks->dstWidth*bpp;
+
+        for (int x = 0; x < tasks->dstWidth; x++)
+        {
+            const float *src = row + tasks->horizontal.start[x]*bpp;
+            const float *w = tasks->horizontal.weights + x*tasks->horizontal.maxTaps;
+            int taps = tasks->horizontal.count[x];
+
+#if defined(RESAMPLE_SIMD_SSE2)
+            if (bpp == 4)
+            {
+                __m128 acc = _mm_setzero_ps();
+                for (int k = 0; k < taps; k++) acc = _mm_add_ps(acc, _mm_mul_ps(_mm_set1_ps(w[k]), _mm_loadu_ps(src + k*4)));
+                _mm_storeu_ps(tmpRow + x*4, acc);
+                continue;
+            }
+#elif defined(RESAMPLE_SIMD_NEON)
+            if (bpp == 4)
+            {
+                float32x4_t acc = vdupq_n_f32(0.0f);
+                for (int k = 0; k < taps; k++) acc = vmlaq_n_f32(acc, vld1q_f32(src + k*4), w[k]);
+                vst1q_f32(tmpRow + x*4, acc);
+                continue;
+            }
+#endif
+            float acc[4] = { 0 };
+            for (int k = 0; k < taps; k++)
+            {
+                for (int c = 0; c < bpp; c++) acc[c] += w[k]*src[k*bpp + c];
+            }
+
+            for (int c = 0; c < bpp; c++) tmpRow[x*bpp + c] = acc[c];
+        }
+    }
+}
+
+// Resample one band of destination rows vertically, from premultiplied alpha float data
+static void ResampleVerticalTask(void *userData, int index)
+{
+    ResampleTasks *tasks = (ResampleTasks *)userData;
+    int bpp = tasks->bpp;
+    int rowSize = tasks->dstWidth*bpp;
+    int rowStart = tasks->dstHeight*index/tasks->bandCount;
+    int rowEnd = tasks->dstHeight*(index + 1)/tasks->bandCount;
+
+    float *acc = (float *)RL_MALLOC(rowSize*sizeof(float));    // Destination row accumulator
+
+    for (int y = rowStart; y < rowEnd; y++)
+    {
+        const float *w = tasks->vertical.weights + y*tasks->vertical.maxTaps;
+        int taps = tasks->vertical.count[y];
+
+        memset(acc, 0, rowSize*sizeof(float));
+
+        // Accumulate full source rows, contiguous data
+        for (int k = 0; k < taps; k++)
+        {
+            const float *tmpRow = tasks->tmpData + (tasks->vertical.start[y] + k)*rowSize;
+            int i = 0;
+#if defined(RESAMPLE_SIMD_SSE2)
+            __m128 weight = _mm_set1_ps(w[k]);
+            for (; i <= (rowSize - 4); i += 4) _mm_storeu_ps(acc + i, _mm_add_ps(_mm_loadu_ps(acc + i), _mm_mul_ps(weight, _mm_loadu_ps(tmpRow + i))));
+#elif defined(RESAMPLE_SIMD_NEON)
+            for (; i <= (rowSize - 4); i += 4) vst1q_f32(acc + i, vmlaq_n_f32(vld1q_f32(acc + i), vld1q_f32(tmpRow + i), w[k]));
+#endif
+            for (; i < rowSize; i++) acc[i] += w[k]*tmpRow[i];
+        }
+
+        // Convert back to 8 bit per channel, color channels unpremultiplied
+        // NOTE: Lanczos filter can generate values out of range (ringing), clamped
+        unsigned char *dstRow = tasks->dstData + y*rowSize;
+
+        for (int x = 0; x < tasks->dstWidth; x++)
+        {
+            const float *pixel = acc + x*bpp;
+            float alpha = (tasks->alphaChannel >= 0)? pixel[tasks->alphaChannel] : 255.0f;
+
+            for (int c = 0; c < bpp; c++)
+            {
+                float value = pixel[c];
+
+                if (c != tasks->alphaChannel) value = (alpha >= 0.5f)? value*255.0f/alpha : 0.0f;
+
+                value += 0.5f;
+                dstRow[x*bpp + c] = (value <= 0.0f)? 0 : ((value >= 255.0f)? 255 : (unsigned char)value);
+            }
+        }
+    }
+
+    RL_FREE(acc);
+}
+
+// Compute icon entry key for encoded data cache
+// NOTE: Key considers all data affecting generated PNG: image data and size, text and export options,
+// source entries image is not considered, it's decoded from source data (not loaded until required)
+// WARNING: Any image modification must unload entry encoded data cache (UnloadIconEntryCache())
+static unsigned long long ComputeIconEntryKey(IconEntry entry, IconExportOptions options)
+{
+    unsigned long long hash = 0xcbf29ce484222325ULL;    // FNV-1a 64bit offset basis
+
+    hash = ComputeDataHash(&options.compression, sizeof(int), hash);
+
+    // NOTE: Indexed encoding is only considered for entries sizes that can use it
+    if (entry.image.width <= options.paletteMaxSize)
+    {
+        int indexed = 1;
+        hash = ComputeDataHash(&indexed, sizeof(int), hash);
+    }
+
+    if (!entry.pngDataSource)
+    {
+        int info[3] = { entry.image.width, entry.image.height, entry.image.format };
+        hash = ComputeDataHash(info, sizeof(info), hash);
+
+        if (entry.image.data != NULL) hash = ComputeDataHash(entry.image.data, GetPixelDataSize(entry.image.width, entry.image.height, entry.image.format), hash);
+    }
+
+    if (options.textChunk) hash = ComputeDataHash(entry.text, (int)strlen(entry.text), hash);
+
+    return hash;
+}
+
+// Compute data hash (64bit, FNV-1a based)
+// NOTE: Data is processed in 8 bytes words for speed, it is not a cryptographic hash
+static unsigned long long ComputeDataHash(const void *data, int size, unsigned long long hash)
+{
+    const unsigned char *bytes = (const unsigned char *)data;
+    int i = 0;
 
-// Icon Entry info (16 bytes)
-typedef struct {
-    unsigned char width;        // Specifies image width in pixels. Can be any number between 0 and 255. Value 0 means image width is 256 pixels.
-    unsigned char height;       // Specifies image height in pixels. Can be any number between 0 and 255. Value 0 means image height is 256 pixels.
-    unsigned char colpalette;   // Specifies number of colors in the color palette. Should be 0 if the image does not use a color palette.
-    unsigned char reserved;     // Reserved. Should be 0.
-    unsigned short planes;      // In ICO format: Specifies color planes. Should be 0 or 1.
-    // In CUR format: Specifies the horizontal coordinates of the hotspot in number of pixels from the left.
-    unsigned short bpp;         // In ICO format: Specifies bits per pixel. [Notes 4]
-    // In CUR format: Specifies the vertical coordinates of the hotspot in number of pixels from the top.
-    unsigned int size;          // Specifies the size of the image's data in bytes
-    unsigned int offset;        // Specifies the offset of BMP or PNG data from the beginning of the ICO/CUR file
-} IcoDirEntry;
+    for (; (i + 8) <= size; i += 8)
+    {
+        unsigned long long word = 0;
+        memcpy(&word, bytes + i, 8);
+        hash = (hash ^ word)*0x100000001b3ULL;  // FNV 64bit prime
+        hash ^= (hash >> 29);
+    }
 
-// Icon data loader
-static IconEntry *LoadIconPackFromICO(const char *fileName, int *count)
+    for (; i < size; i++) hash = (hash ^ bytes[i])*0x100000001b3ULL;
+
+    return hash;
+}
+
+// Unload icon entry encoded data cache
+static void UnloadIconEntryCache(IconEntry *entry)
 {
-    IconEntry *entries = NULL;
-    int imageCounter = 0;
+    RPNG_FREE(entry->pngData);
+
+    entry->pngData = NULL;
+    entry->pngDataSize = 0;
+    entry->pngDataKey = 0;
+    entry->pngDataSource = false;
+}
 
-    FILE *icoFile = fopen(fileName, "rb");
+// Copy icon entry encoded data cache
+// NOTE: Destination cache is not unloaded, it could be shared with source entry (struct copy)
+static void CopyIconEntryCache(IconEntry *dst, IconEntry src)
+{
+    dst->pngData = NULL;
+    dst->pngDataSize = 0;
 
-    if (icoFile != NULL)
+    if (src.pngData != NULL)
     {
-        // Load .ico information
-        IcoHeader icoHeader = { 0 };
-        fread(&icoHeader, sizeof(IcoHeader), 1, icoFile);
+        dst->pngData = (char *)RPNG_MALLOC(src.pngDataSize);
+        memcpy(dst->pngData, src.pngData, src.pngDataSize);
+        dst->pngDataSize = src.pngDataSize;
+    }
 
-        entries = (IconEntry *)RL_CALLOC(icoHeader.imageCount, sizeof(IconEntry));
+    dst->pngDataKey = src.pngDataKey;
+    dst->pngDataSource = src.pngDataSource;
+}
 
-        IcoDirEntry *icoDirEntry = (IcoDirEntry *)RL_CALLOC(icoHeader.imageCount, sizeof(IcoDirEntry));
+// Set icon entry source PNG data as encoded data cache, image not decoded
+// NOTE: Entry takes ownership of data (allocated with RPNG_MALLOC()), image size is read from IHDR chunk
+// and image text from rIPt chunk, image is decoded on demand (LoadIconEntryImage()), returns false if data is not PNG
+static bool SetIconEntrySourceData(IconEntry *entry, unsigned char *data, int dataSize)
+{
+    // Verify PNG signature and IHDR chunk (always first one)
+    if ((data == NULL) || (dataSize < 33) || (memcmp(data, "\x89PNG\r\n\x1a\n", 8) != 0) || (memcmp(data + 12, "IHDR", 4) != 0)) return false;
 
-        for (int i = 0; i < icoHeader.imageCount; i++) fread(&icoDirEntry[i], sizeof(IcoDirEntry), 1, icoFile);
+    int width = (data[16] << 24) | (data[17] << 16) | (data[18] << 8) | data[19];
+    int height = (data[20] << 24) | (data[21] << 16) | (data[22] << 8) | data[23];
 
-        for (int i = 0; i < icoHeader.imageCount; i++)
-        {
-            unsigned char *icoImageData = (unsigned char *)RL_CALLOC(icoDirEntry[i].size, 1);
-            fread(icoImageData, 1, icoDirEntry[i].size, icoFile);    // Read icon image data
+    if ((width <= 0) || (height <= 0)) return false;
 
-            // Verify PNG signature for loaded image data
-            if ((icoImageData[0] == 0x89) &&
-                (icoImageData[1] == 0x50) &&
-                (icoImageData[2] == 0x4e) &&
-                (icoImageData[3] == 0x47) &&
-                (icoImageData[4] == 0x0d) &&
-                (icoImageData[5] == 0x0a) &&
-                (icoImageData[6] == 0x1a) &&
-                (icoImageData[7] == 0x0a))
-            {
-                // Reading image data from memory buffer
-                // WARNING: Image data on th IcoDirEntry may be in either:
-                //  - Windows BMP format, excluding the BITMAPFILEHEADER structure
-                //  - PNG format, stored in its entirety
-                // NOTE: We are only supporting the PNG format, not BMP data
-                entries[i].image = LoadImageFromMemory(".png", icoImageData, icoDirEntry[i].size);
+    // NOTE: Image data pixel format is only known after decoding
+    entry->image = (Image){ .data = NULL, .width = width, .height = height, .mipmaps = 1, .format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 };
+    entry->size = width;        // Icon size (expected squared)
+    entry->valid = false;       // Not valid until it is checked against the current package (sizes)
+    entry->generated = false;
 
-                if ((entries[i].image.data != NULL) && (entries[i].image.width != 0))
-                {
-                    entries[i].size = entries[i].image.width;   // Icon size (expected squared)
-                    entries[i].valid = false;                   // Not valid until it is checked against the current package (sizes)
+    // Read custom rIconPacker text chunk from PNG
+    // NOTE: Chunk data points to provided data, no copy required
+    rpng_chunk chunk = rpng_chunk_find_from_memory((const char *)data, dataSize, "rIPt");
+    memset(entry->text, 0, MAX_IMAGE_TEXT_SIZE);
+    if (chunk.length > 0) memcpy(entry->text, chunk.data, (chunk.length < MAX_IMAGE_TEXT_SIZE)? chunk.length : MAX_IMAGE_TEXT_SIZE - 1);
 
-                    // Read custom rIconPacker text chunk from PNG
-                    rpng_chunk chunk = rpng_chunk_read_from_memory(icoImageData, "rIPt");
-                    memcpy(entries[i].text, chunk.data, (chunk.length < MAX_IMAGE_TEXT_SIZE)? chunk.length : MAX_IMAGE_TEXT_SIZE - 1);
-                    RPNG_FREE(chunk.data);
+    entry->pngData = (char *)data;
+    entry->pngDataSize = dataSize;
+    entry->pngDataSource = true;
+    entry->pngDataKey = ComputeIconEntryKey(*entry, (IconExportOptions){ .textChunk = true, .compression = ICON_COMPRESSION_SOURCE });
 
-                    imageCounter++;
-                }
-            }
+    return true;
+}
+
+// Check icon entry encoded data cache is valid for export options
+static bool CheckIconEntryCache(IconEntry entry, IconExportOptions options)
+{
+    bool valid = false;
 
-            RL_FREE(icoImageData);
+    if (entry.pngData != NULL)
+    {
+        if (entry.pngDataSource)
+        {
+            // Source data (loaded from file) is written as is if text has not been modified
+            // NOTE: Max/optimal compression levels, indexed encoding and text chunk removal require data re-encoding
+            valid = (options.compression < ICON_COMPRESSION_MAX) && (entry.image.width > options.paletteMaxSize) && (options.textChunk || (entry.text[0] == '\0')) &&
+                    (ComputeIconEntryKey(entry, (IconExportOptions){ .textChunk = true, .compression = ICON_COMPRESSION_SOURCE }) == entry.pngDataKey);
         }
+        else valid = (ComputeIconEntryKey(entry, options) == entry.pngDataKey);
+    }
+
+    return valid;
+}
 
-        RL_FREE(icoDirEntry);
+// Load icon entry image from encoded data (if not loaded yet)
+// NOTE: Images loaded from files are only decoded when required: preview, generation or re-encoding
+static bool LoadIconEntryImage(IconEntry *entry)
+{
+    if ((entry->image.data == NULL) && (entry->pngData != NULL))
+    {
+        Image image = LoadImageFromMemory(".png", (unsigned char *)entry->pngData, entry->pngDataSize);
 
-        fclose(icoFile);
+        if (image.data != NULL) entry->image = image;
     }
 
-    *count = imageCounter;
-    return entries;
+    return (entry->image.data != NULL);
 }
 
-// Save icon (.ico)
-// NOTE: Make sure entries array sizes are valid!
-static void SaveIconPackToICO(IconEntry *entries, int entryCount, const char *fileName)
+#if !defined(RICONPACKER_LIBRARY)
+// Initialize PNG encoders pool
+static void InitIconEncoders(void)
 {
-    // Verify icon pack valid entries (not placeholder ones)
-    int packValidCount = 0;
-    for (int i = 0; i < entryCount; i++) if (entries[i].valid) packValidCount++;
+    InitThreadMutex(&iconEncodersMutex);
+}
 
-    if (packValidCount == 0) return;
+// Unload PNG encoders pool, all encoders work buffers
+static void UnloadIconEncoders(void)
+{
+    for (int i = 0; i < iconEncodersCount; i++)
+    {
+        rpng_encoder_unload(iconEncoders[i]);
+        RL_FREE(iconEncoders[i]);
+        iconEncoders[i] = NULL;
+    }
 
-    // Define ico file header and entry
-    IcoHeader icoHeader = { .reserved = 0, .imageType = 1, .imageCount = packValidCount };
-    IcoDirEntry *icoDirEntry = (IcoDirEntry *)RL_CALLOC(icoHeader.imageCount, sizeof(IcoDirEntry));
+    iconEncodersCount = 0;
 
-    char **pngDataPtrs = (char **)RL_CALLOC(icoHeader.imageCount, sizeof(char *));     // Pointers array to PNG image data
-    int offset = 6 + 16*icoHeader.imageCount;
+    UnloadThreadMutex(&iconEncodersMutex);
+}
+#endif
 
-    // Get image png data (and pointers to each image)
-    // NOTE: In case of PNG export as ZIP, files are directly packed in the loop, one by one
-    for (int i = 0, k = 0; i < entryCount; i++)
+// Get PNG encoder from pool (or a new one)
+// NOTE: Encoder must be returned to pool with ReleaseIconEncoder(),
+// library has no global state, encoders are not pooled (always new ones)
+static rpng_encoder *AcquireIconEncoder(void)
+{
+    rpng_encoder *encoder = NULL;
+
+#if !defined(RICONPACKER_LIBRARY)
+    LockThreadMutex(&iconEncodersMutex);
+    if (iconEncodersCount > 0)
     {
-        if (entries[i].valid)
-        {
-            int fileSize = 0;           // Store generated png file size (with rIPt chunk)
-            int tempFileSize = 0;       // Store generated png file size (no text chunk)
-            int colorChannels = 0;
+        iconEncodersCount--;
+        encoder = iconEncoders[iconEncodersCount];
+    }
+    UnlockThreadMutex(&iconEncodersMutex);
+#endif
 
-            // Compress entries data into PNG file data streams
-            // Image data format could be RGB (3 bytes) instead of RGBA (4 bytes)
-            if (entries[i].image.format == PIXELFORMAT_UNCOMPRESSED_R8G8B8) colorChannels = 3;
-            else if (entries[i].image.format == PIXELFORMAT_UNCOMPRESSED_R8G8B8A8) colorChannels = 4;
+    if (encoder == NULL) encoder = (rpng_encoder *)RL_CALLOC(1, sizeof(rpng_encoder));
 
-            // NOTE: Memory is allocated internally using RPNG_MALLOC(), must be freed with RPNG_FREE()
-            char *tempPngData = rpng_save_image_to_memory(entries[i].image.data, entries[i].image.width, entries[i].image.height, colorChannels, 8, &tempFileSize);
+    return encoder;
+}
 
-            // Check if exporting text chunks is required
-            if (exportTextChunkChecked && (entries[i].text[0] != '\0'))
-            {
-                // Add image text chunks to generated PNGs
-                rpng_chunk chunk = { 0 };
-                chunk.data = entries[i].text;
-                chunk.length = strlen(entries[i].text);
-                memcpy(chunk.type, "rIPt", 4);
-                pngDataPtrs[k] = rpng_chunk_write_from_memory(tempPngData, chunk, &fileSize);
-            }
-            else
-            {
-                pngDataPtrs[k] = tempPngData;
-                fileSize = tempFileSize;
-            }
+// Return PNG encoder to pool, buffers are kept for reuse
+// NOTE: If pool is full, encoder is unloaded
+static void ReleaseIconEncoder(rpng_encoder *encoder)
+{
+    bool pooled = false;
 
-            icoDirEntry[k].width = (entries[i].image.width == 256)? 0 : entries[i].image.width;
-            icoDirEntry[k].height = (entries[i].image.width == 256)? 0 : entries[i].image.width;
-            icoDirEntry[k].bpp = 32;
-            icoDirEntry[k].size = fileSize;
-            icoDirEntry[k].offset = offset;
+#if !defined(RICONPACKER_LIBRARY)
+    LockThreadMutex(&iconEncodersMutex);
+    if (iconEncodersCount < MAX_ICON_ENCODERS)
+    {
+        iconEncoders[iconEncodersCount] = encoder;
+        iconEncodersCount++;
+        pooled = true;
+    }
+    UnlockThreadMutex(&iconEncodersMutex);
+#endif
 
-            offset += fileSize;
-            k++;
+    if (!pooled)
+    {
+        rpng_encoder_unload(encoder);
+        RL_FREE(encoder);
+    }
+}
+
+#if !defined(RICONPACKER_LIBRARY)
+// Initialize GUI background tasks queue and worker thread
+// NOTE: If worker thread can not be started (i.e. web without threads support),
+// tasks are processed on submit by calling thread, results are applied the same way
+static void InitIconTasks(void)
+{
+    iconTasks = (IconTaskQueue){ 0 };
+    InitThreadMutex(&iconTasks.mutex);
+    InitThreadCondition(&iconTasks.cond);
+
+    iconTasks.workerActive = StartWorkerThread(&iconTasks.worker, ProcessIconTasks, NULL);
+}
+
+// Stop worker thread and unload pending tasks
+// NOTE: Task currently processed by worker is finished before stopping
+static void UnloadIconTasks(void)
+{
+    if (iconTasks.workerActive)
+    {
+        LockThreadMutex(&iconTasks.mutex);
+        iconTasks.quit = true;
+        BroadcastThreadCondition(&iconTasks.cond);
+        UnlockThreadMutex(&iconTasks.mutex);
+
+        JoinWorkerThread(&iconTasks.worker);
+    }
+
+    for (int i = 0; i < iconTasks.count; i++) UnloadIconTask(iconTasks.tasks[i]);
+    RL_FREE(iconTasks.tasks);
+
+    UnloadThreadCondition(&iconTasks.cond);
+    UnloadThreadMutex(&iconTasks.mutex);
+
+    iconTasks = (IconTaskQueue){ 0 };
+}
+
+// Submit task to background worker, queue takes ownership of task
+static void SubmitIconTask(IconTask *task)
+{
+    task->generation = iconTasks.generation;
+
+    LockThreadMutex(&iconTasks.mutex);
+    if (iconTasks.count >= iconTasks.capacity)
+    {
+        int capacity = (iconTasks.capacity > 0)? iconTasks.capacity*2 : 16;
+        IconTask **tasks = (IconTask **)RL_REALLOC(iconTasks.tasks, capacity*sizeof(IconTask *));
+
+        if (tasks != NULL)
+        {
+            iconTasks.tasks = tasks;
+            iconTasks.capacity = capacity;
         }
     }
 
-    FILE *icoFile = fopen(fileName, "wb");
+    bool submitted = (iconTasks.count < iconTasks.capacity);
+    if (submitted)
+    {
+        iconTasks.tasks[iconTasks.count] = task;
+        iconTasks.count++;
+        SignalThreadCondition(&iconTasks.cond);
+    }
+    UnlockThreadMutex(&iconTasks.mutex);
+
+    if (!submitted) { UnloadIconTask(task); return; }
 
-    if (icoFile != NULL)
+    // No worker available, process task in place
+    if (!iconTasks.workerActive)
     {
-        // Write ico header
-        fwrite(&icoHeader, sizeof(IcoHeader), 1, icoFile);
+        ProcessIconTask(task);
+        task->done = true;
+        iconTasks.next++;
+    }
+}
 
-        // Write icon entries entries data
-        for (int i = 0; i < icoHeader.imageCount; i++) fwrite(&icoDirEntry[i], sizeof(IcoDirEntry), 1, icoFile);
+// Submit icon file loading task
+static void SubmitIconLoadTask(const char *fileName)
+{
+    IconTask *task = (IconTask *)RL_CALLOC(1, sizeof(IconTask));
+
+    task->type = ICON_TASK_LOAD;
+    strncpy(task->fileName, fileName, 511);
+
+    SubmitIconTask(task);
+}
+
+// Submit icon sizes generation task
+// NOTE: Source entry image is copied (or its encoded data if not decoded yet),
+// so task is not affected by bucket or pack changes while processed
+static void SubmitIconGenerateTask(IconEntry entry, const int *sizes, int count, int scaleAlgorythm)
+{
+    IconTask *task = (IconTask *)RL_CALLOC(1, sizeof(IconTask));
 
-        // Write icon png data
-        for (int i = 0; i < icoHeader.imageCount; i++) fwrite(pngDataPtrs[i], icoDirEntry[i].size, 1, icoFile);
+    task->type = ICON_TASK_GENERATE;
+    task->source.size = entry.size;
 
-        fclose(icoFile);
+    if (entry.image.data != NULL) task->source.image = ImageCopy(entry.image);
+    else
+    {
+        task->source.image = entry.image;
+        CopyIconEntryCache(&task->source, entry);
     }
 
-    // Free used data (pngs data)
-    for (int i = 0; i < icoHeader.imageCount; i++) RPNG_FREE(pngDataPtrs[i]);
+    task->sizes = (int *)RL_MALLOC(count*sizeof(int));
+    task->images = (Image *)RL_CALLOC(count, sizeof(Image));
+    memcpy(task->sizes, sizes, count*sizeof(int));
+    task->count = count;
+    task->scaleAlgorythm = scaleAlgorythm;
 
-    RL_FREE(icoDirEntry);
-    RL_FREE(pngDataPtrs);
+    SubmitIconTask(task);
 }
 
-// Save images as .png
-static void ExportIconPackImages(IconEntry *entries, int entryCount, const char *fileName)
+// Submit icon pack export task
+// NOTE: Pack entries images are copied (or their encoded data if not decoded yet), along with
+// their encoded data cache, so task is not affected by bucket or pack changes while processed
+static void SubmitIconExportTask(IconPack pack, const char *fileName, int format, IconExportOptions options)
 {
-    // Verify icon pack valid entries (not placeholder ones)
-    int packValidCount = 0;
-    for (int i = 0; i < entryCount; i++) if (entries[i].valid) packValidCount++;
+    IconTask *task = (IconTask *)RL_CALLOC(1, sizeof(IconTask));
 
-    if (packValidCount == 0) return;
+    task->type = ICON_TASK_EXPORT;
+    strncpy(task->fileName, fileName, 511);
+    task->format = format;
+    task->options = options;
 
-    char **pngDataPtrs = (char **)RL_CALLOC(packValidCount, sizeof(char *));     // Pointers array to PNG image data
+    task->bucket.entries = (IconEntry *)RL_CALLOC((pack.count > 0)? pack.count : 1, sizeof(IconEntry));
+    task->bucket.capacity = (pack.count > 0)? pack.count : 1;
 
-    // Get image png data (and pointers to each image)
-    // NOTE: In case of PNG export as ZIP, files are directly packed in the loop, one by one
-    for (int i = 0, k = 0; i < entryCount; i++)
+    for (int i = 0; i < pack.count; i++)
     {
-        if (entries[i].valid)
+        IconEntry *entry = &task->bucket.entries[i];
+
+        entry->size = pack.entries[i].size;
+        memcpy(entry->text, pack.entries[i].text, MAX_IMAGE_TEXT_SIZE);
+
+        if (pack.entries[i].valid)
         {
-            int fileSize = 0;           // Store generated png file size (with rIPt chunk)
-            int tempFileSize = 0;       // Store generated png file size (no text chunk)
-            int colorChannels = 0;
+            if (pack.entries[i].image.data != NULL) entry->image = ImageCopy(pack.entries[i].image);
+            CopyIconEntryCache(entry, pack.entries[i]);
+            entry->valid = (entry->image.data != NULL) || (entry->pngData != NULL);
+        }
+    }
+
+    task->bucket.count = pack.count;
+
+    SubmitIconTask(task);
+}
+
+// Apply processed tasks results to bucket and pack, in submission order
+// NOTE: Function must be called from main thread (textures upload), returns pending tasks count
+static int UpdateIconTasks(IconBucket *bucket, IconPack *pack, int maxResults)
+{
+    IconTask *results[MAX_ICON_TASKS_PER_FRAME] = { 0 };
+    int resultsCount = 0;
+    int pendingCount = 0;
+
+    if (maxResults > MAX_ICON_TASKS_PER_FRAME) maxResults = MAX_ICON_TASKS_PER_FRAME;
+
+    // Get processed tasks from queue front
+    LockThreadMutex(&iconTasks.mutex);
+    while ((resultsCount < maxResults) && (resultsCount < iconTasks.count) && iconTasks.tasks[resultsCount]->done)
+    {
+        results[resultsCount] = iconTasks.tasks[resultsCount];
+        resultsCount++;
+    }
+
+    if (resultsCount > 0)
+    {
+        memmove(iconTasks.tasks, iconTasks.tasks + resultsCount, (iconTasks.count - resultsCount)*sizeof(IconTask *));
+        iconTasks.count -= resultsCount;
+        iconTasks.next -= resultsCount;
+    }
 
-            // Compress entries data into PNG file data streams
-            // Image data format could be RGB (3 bytes) instead of RGBA (4 bytes)
-            if (entries[i].image.format == PIXELFORMAT_UNCOMPRESSED_R8G8B8) colorChannels = 3;
-            else if (entries[i].image.format == PIXELFORMAT_UNCOMPRESSED_R8G8B8A8) colorChannels = 4;
+    pendingCount = iconTasks.count;
+    UnlockThreadMutex(&iconTasks.mutex);
 
-            // NOTE: Memory is allocated internally using RPNG_MALLOC(), must be freed with RPNG_FREE()
-            char *tempPngData = rpng_save_image_to_memory(entries[i].image.data, entries[i].image.width, entries[i].image.height, colorChannels, 8, &tempFileSize);
+    for (int r = 0; r < resultsCount; r++)
+    {
+        IconTask *task = results[r];
 
-            // Check if exporting text chunks is required
-            if (exportTextChunkChecked && (entries[i].text[0] != '\0'))
+        if (task->type == ICON_TASK_EXPORT)
+        {
+            // NOTE: Export results are never discarded, exported data does not depend on current bucket
+            if ((task->data != NULL) && SaveFileData(task->fileName, task->data, task->dataSize))
             {
-                // Add image text chunks to generated PNGs
-                rpng_chunk chunk = { 0 };
-                chunk.data = entries[i].text;
-                chunk.length = strlen(entries[i].text);
-                memcpy(chunk.type, "rIPt", 4);
-                pngDataPtrs[k] = rpng_chunk_write_from_memory(tempPngData, chunk, &fileSize);
+            #if defined(PLATFORM_WEB)
+                // Download file from MEMFS (emscripten memory filesystem)
+                // NOTE: Second argument must be a simple filename (we can't use directories)
+                // NOTE: Included security check to (partially) avoid malicious code on PLATFORM_WEB
+                if (strchr(task->fileName, '\'') == NULL) emscripten_run_script(TextFormat("saveFileFromMEMFSToDisk('%s','%s')", task->fileName, GetFileName(task->fileName)));
+            #endif
             }
-            else
+
+            // Encoded data is moved back to pack entries, so next export of unchanged entries does not re-encode them
+            // NOTE: Encoded data is only moved if still valid for current pack entry (image and text not changed meanwhile)
+            for (int k = 0; k < pack->count; k++)
+            {
+                if (!pack->entries[k].valid || CheckIconEntryCache(pack->entries[k], task->options)) continue;
+
+                for (int i = 0; i < task->bucket.count; i++)
+                {
+                    IconEntry *entry = &task->bucket.entries[i];
+                    if ((entry->size != pack->entries[k].size) || (entry->pngData == NULL)) continue;
+
+                    IconEntry check = pack->entries[k];
+                    check.pngData = entry->pngData;
+                    check.pngDataSize = entry->pngDataSize;
+                    check.pngDataKey = entry->pngDataKey;
+                    check.pngDataSource = entry->pngDataSource;
+
+                    if (CheckIconEntryCache(check, task->options))
+                    {
+                        UnloadIconEntryCache(&pack->entries[k]);
+                        pack->entries[k] = check;
+
+                        entry->pngData = NULL;      // Pack entry takes ownership of encoded data
+                        UnloadIconEntryCache(entry);
+                    }
+                    break;
+                }
+            }
+        }
+        else if (task->generation == iconTasks.generation)     // Results from a previous generation are discarded (i.e. bucket cleared)
+        {
+            if (task->type == ICON_TASK_LOAD)
             {
-                pngDataPtrs[k] = tempPngData;
-                fileSize = tempFileSize;
+                // Bucket takes ownership of loaded entries
+                AddIconEntriesToBucket(bucket, task->bucket.entries, task->bucket.count);
+                task->bucket.count = 0;
+
+                // Update current pack with bucket data
+                UpdateIconPackFromBucket(pack, *bucket);
             }
+            else if (task->type == ICON_TASK_GENERATE)
+            {
+                for (int i = 0; i < task->count; i++)
+                {
+                    // Generated image is only used if pack entry is still waiting for it
+                    // NOTE: Pack could have been reset or entry could have been loaded meanwhile
+                    for (int k = 0; k < pack->count; k++)
+                    {
+                        if (pack->pending[k] && (pack->entries[k].size == task->sizes[i]))
+                        {
+                            pack->pending[k] = false;
 
-#if defined(EXPORT_IMAGE_PACK_AS_ZIP)
-            // Export a single .zip file containing all images
-            // Package every image into an output ZIP file (fileName.zip)
-            mz_bool status = mz_zip_add_mem_to_archive_file_in_place(TextFormat("%s.zip", fileName), TextFormat("%s_%ix%i.png", GetFileNameWithoutExt(fileName), entries[i].image.width, entries[i].image.height), pngDataPtrs[i], fileSize, NULL, 0, MZ_BEST_SPEED); //MZ_BEST_COMPRESSION, MZ_DEFAULT_COMPRESSION
-            if (!status) LOG("WARNING: Zip accumulation process failed\n");
-#else
-            // Save every PNG file individually
-            SaveFileData(TextFormat("%s/%s_%ix%i.png", GetDirectoryPath(fileName), GetFileNameWithoutExt(fileName), entries[i].image.width, entries[i].image.height), pngDataPtrs[i], fileSize);
-#endif
-            k++;
+                            if (!pack->entries[k].valid && (task->images[i].data != NULL))
+                            {
+                                if (pack->entries[k].generated) UnloadImage(pack->entries[k].image);
+                                else pack->entries[k].image = (Image){ 0 };   // Unlink from bucket image
+                                UnloadIconEntryCache(&pack->entries[k]);
+
+                                pack->entries[k].image = task->images[i];
+                                task->images[i] = (Image){ 0 };
+
+                                pack->entries[k].generated = true;
+                                pack->entries[k].valid = true;
+
+                                UpdateIconPackAtlas(pack, k);
+                            }
+                            break;
+                        }
+                    }
+                }
+            }
         }
+
+        UnloadIconTask(task);
     }
 
-    // Free used data (pngs data)
-    for (int i = 0; i < packValidCount; i++) RPNG_FREE(pngDataPtrs[i]);
-    RL_FREE(pngDataPtrs);
+    return pendingCount;
 }
 
-// Icns data loader
-// NOTE: ARGB and JPEG2000 image data formats not supported, only PNG
-static IconEntry *LoadIconPackFromICNS(const char *fileName, int *count)
+// Process one task, called from worker thread
+// NOTE: Only thread-safe functions can be used (no raylib text functions or GPU access)
+static void ProcessIconTask(IconTask *task)
 {
-    #define MAX_ICNS_IMAGE_SUPPORTED    32
-
-    #define SWAP_INT32(x) (((x) >> 24) | (((x) & 0x00ff0000) >> 8) | (((x) & 0x0000ff00) << 8) | ((x) << 24))
+    switch (task->type)
+    {
+        case ICON_TASK_LOAD:
+        {
+            AddIconToBucket(&task->bucket, task->fileName);
 
-    IconEntry *entries = NULL;
-    unsigned int imageCounter = 0;
+            // Images decoded in advance, they are required for preview
+            for (int i = 0; i < task->bucket.count; i++) LoadIconEntryImage(&task->bucket.entries[i]);
+        } break;
+        case ICON_TASK_GENERATE:
+        {
+            if (LoadIconEntryImage(&task->source) || (task->source.image.data != NULL))
+            {
+                GenerateIconSizes(task->source.image, task->sizes, task->count, task->scaleAlgorythm, GetProcessorCount(), task->images);
+            }
+        } break;
+        case ICON_TASK_EXPORT:
+        {
+            // NOTE: Icon file data is saved by main thread, file system access is not required here
+            if (task->format == 1) task->data = ExportIconPackToICNSMemory(task->bucket.entries, task->bucket.count, task->options, &task->dataSize);
+            else task->data = ExportIconPackToICOMemory(task->bucket.entries, task->bucket.count, task->options, &task->dataSize);
+        } break;
+        default: break;
+    }
+}
 
-    FILE *icnsFile = fopen(fileName, "rb");
+// Worker thread loop, processes tasks in submission order until quit is required
+static void ProcessIconTasks(void *userData)
+{
+    (void)userData;
 
-    if (icnsFile != NULL)
+    while (true)
     {
-        unsigned char icnsSig[4] = { 0 };
-        fread(icnsSig, 1, 4, icnsFile);
+        LockThreadMutex(&iconTasks.mutex);
+        while (!iconTasks.quit && (iconTasks.next >= iconTasks.count)) WaitThreadCondition(&iconTasks.cond, &iconTasks.mutex);
 
-        if ((icnsSig[0] == 'i') && (icnsSig[1] == 'c') && (icnsSig[2] == 'n') && (icnsSig[3] == 's'))
+        if (iconTasks.quit)
         {
-            unsigned char icnType[4] = { 0 };
-            unsigned int fileSize = 0;
-            unsigned int sizeBE = 0;
-            fread(&sizeBE, sizeof(unsigned int), 1, icnsFile);
-            fileSize = SWAP_INT32(sizeBE);
+            UnlockThreadMutex(&iconTasks.mutex);
+            break;
+        }
 
-            // Allocate space for the maximum number of entries supported
-            // NOTE: Only the valid loaded images will be filled, some entries will be empty,
-            // but the returned entries count will refer to the loaded images
-            // There shouldn't be any problem when freeing the pointer...
-            entries = (IconEntry *)RL_CALLOC(MAX_ICNS_IMAGE_SUPPORTED, sizeof(IconEntry));
+        IconTask *task = iconTasks.tasks[iconTasks.next];
+        UnlockThreadMutex(&iconTasks.mutex);
 
-            unsigned int processedSize = 8;
+        ProcessIconTask(task);
 
-            for (int i = 0; (i < MAX_ICNS_IMAGE_SUPPORTED) && (processedSize < fileSize); i++)
-            {
-                fread(icnType, 1, 4, icnsFile);
+        LockThreadMutex(&iconTasks.mutex);
+        task->done = true;
+        iconTasks.next++;
+        UnlockThreadMutex(&iconTasks.mutex);
+    }
+}
 
-                unsigned int icnSize = 0;
-                fread(&sizeBE, sizeof(unsigned int), 1, icnsFile);
-                icnSize = SWAP_INT32(sizeBE);
+// Unload task data, results not applied are unloaded
+static void UnloadIconTask(IconTask *task)
+{
+    ClearIconBucket(&task->bucket);
+    RL_FREE(task->bucket.entries);
 
-                processedSize += 8;     // IcnType an IcnSize parameters
-                icnSize -= 8;           // IcnSize also considers type and size parameters, we must subtract them to get actual data size
+    UnloadImage(task->source.image);
+    UnloadIconEntryCache(&task->source);
 
-                // We have next icn type and size, now we must check if it's a supported format to load it
-                LOG("INFO: [%s] ICNS OSType: %c%c%c%c [%i bytes]\n", GetFileName(fileName), icnType[0], icnType[1], icnType[2], icnType[3], icnSize);
+    for (int i = 0; i < task->count; i++) UnloadImage(task->images[i]);
+    RL_FREE(task->images);
+    RL_FREE(task->sizes);
+    RL_FREE(task->data);
 
-                // NOTE: Only supported formats including PNG data
-                if (((icnType[0] == 'i') && (icnType[1] == 'c') && (icnType[2] == 'p') && (icnType[3] == '4')) ||   // 16x16, icp4, not properly displayed on .app
-                    ((icnType[0] == 'i') && (icnType[1] == 'c') && (icnType[2] == 'p') && (icnType[3] == '5')) ||   // 32x32, icp5, not properly displayed on .app
-                    ((icnType[0] == 'i') && (icnType[1] == 'c') && (icnType[2] == 'p') && (icnType[3] == '6')) ||   // 48x48, icp6, not properly displayed on .app
-                    ((icnType[0] == 'i') && (icnType[1] == 'c') && (icnType[2] == '0') && (icnType[3] == '4')) ||   // 16x16, ic04
-                    ((icnType[0] == 'i') && (icnType[1] == 'c') && (icnType[2] == 's') && (icnType[3] == 'b')) ||   // 18x18, icsb
-                    ((icnType[0] == 's') && (icnType[1] == 'b') && (icnType[2] == '2') && (icnType[3] == '4')) ||   // 24x24, sb24
-                    ((icnType[0] == 'i') && (icnType[1] == 'c') && (icnType[2] == 'p') && (icnType[3] == '5')) ||   // 32x32, icp5, not properly displayed on .app
-                    ((icnType[0] == 'i') && (icnType[1] == 'c') && (icnType[2] == '0') && (icnType[3] == '5')) ||   // 32x32, ic05 (16x16@2x "retina")
-                    ((icnType[0] == 'i') && (icnType[1] == 'c') && (icnType[2] == '1') && (icnType[3] == '1')) ||   // 32x32, ic11 (16x16@2x "retina")
-                    ((icnType[0] == 'i') && (icnType[1] == 'c') && (icnType[2] == 's') && (icnType[3] == 'B')) ||   // 36x36, icsB (18x18@2x "retina")
-                    ((icnType[0] == 'i') && (icnType[1] == 'c') && (icnType[2] == 'p') && (icnType[3] == '6')) ||   // 48x48, icp6, not properly displayed on .app
-                    ((icnType[0] == 'S') && (icnType[1] == 'B') && (icnType[2] == '2') && (icnType[3] == '4')) ||   // 48x48, SB24 (24x24@2x "retina")
-                    ((icnType[0] == 'i') && (icnType[1] == 'c') && (icnType[2] == '1') && (icnType[3] == '2')) ||   // 64x64, ic12 (32x32@2x "retina")
-                    ((icnType[0] == 'i') && (icnType[1] == 'c') && (icnType[2] == '0') && (icnType[3] == '7')) ||   // 128x128, ic07
-                    ((icnType[0] == 'i') && (icnType[1] == 'c') && (icnType[2] == '0') && (icnType[3] == '8')) ||   // 256x256, ic08
-                    ((icnType[0] == 'i') && (icnType[1] == 'c') && (icnType[2] == '1') && (icnType[3] == '3')) ||   // 256x256, ic13 (128x128@2x "retina")
-                    ((icnType[0] == 'i') && (icnType[1] == 'c') && (icnType[2] == '0') && (icnType[3] == '9')) ||   // 512x512, ic09
-                    ((icnType[0] == 'i') && (icnType[1] == 'c') && (icnType[2] == '1') && (icnType[3] == '4')) ||   // 512x512, ic14 (256x256@2x "retina")
-                    ((icnType[0] == 'i') && (icnType[1] == 'c') && (icnType[2] == '1') && (icnType[3] == '0')))     // 1024x1024, ic10 (512x512@2x "retina")
-                {
-                    // NOTE: We only support loading PNG data, JPEG2000 and ARGB data not supported
+    RL_FREE(task);
+}
+
+// Draw placeholder for pending icon image (fading rectangle over panel)
+static void DrawIconPendingPlaceholder(Rectangle bounds)
+{
+    GuiPanel(bounds, NULL);
+    DrawRectangleRec(bounds, Fade(GetColor(GuiGetStyle(DEFAULT, BORDER_COLOR_FOCUSED)), 0.2f + 0.2f*sinf((float)GetTime()*6.0f)));
+}
+#endif      // !RICONPACKER_LIBRARY
+
+//--------------------------------------------------------------------------------------------
+// Library functions definition (librip)
+//--------------------------------------------------------------------------------------------
+#if defined(RICONPACKER_LIBRARY)
+// Allocate memory with provided allocator (malloc() if not provided)
+static void *RipAllocData(RipAllocator allocator, size_t size)
+{
+    return (allocator.alloc != NULL)? allocator.alloc(size, allocator.userData) : malloc(size);
+}
 
-                    unsigned char *icnImageData = (unsigned char *)RL_CALLOC(icnSize, 1);
-                    fread(icnImageData, 1, icnSize, icnsFile);
-
-                    // Verify PNG signature for loaded image data
-                    if ((icnImageData[0] == 0x89) &&
-                        (icnImageData[1] == 0x50) &&
-                        (icnImageData[2] == 0x4e) &&
-                        (icnImageData[3] == 0x47) &&
-                        (icnImageData[4] == 0x0d) &&
-                        (icnImageData[5] == 0x0a) &&
-                        (icnImageData[6] == 0x1a) &&
-                        (icnImageData[7] == 0x0a))
-                    {
-                        // Data contains a valid PNG file, we can load it
-                        /*
-                        int colors, bits;
-                        int width, height;
-                        char *data = rpng_load_image_from_memory(icnImageData, &width, &height, &colors, &bits); // Image loaded successfully
-                        Image image = {
-                            .width = width,
-                            .height = height,
-                            .mipmaps = 1,
-                            .data = data,
-                            .format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8
-                        };
-                        entries[imageCounter].image = image;
-                        //if (image.width == 512) ExportImage(image, "D:\\testing_512x512.png");    // Image saved successfully, no lost pixels
-                        */
+// Free memory with provided allocator (free() if not provided)
+static void RipFreeData(RipAllocator allocator, void *ptr)
+{
+    if (ptr == NULL) return;
 
-                        entries[imageCounter].image = LoadImageFromMemory(".png", icnImageData, icnSize);
+    if (allocator.free != NULL) allocator.free(ptr, allocator.userData);
+    else free(ptr);
+}
 
-                        if ((entries[imageCounter].image.data != NULL) && (entries[imageCounter].image.width != 0))
-                        {
-                            entries[imageCounter].size = entries[imageCounter].image.width;   // Icon size (expected squared)
-                            entries[imageCounter].valid = false;    // Not valid until it is checked against the current package (sizes)
-                            entries[imageCounter].generated = false;
+// Get icon export options from library options
+static IconExportOptions GetRipExportOptions(RipOptions options)
+{
+    IconExportOptions exportOptions = { 0 };
 
-                            // Read custom rIconPacker text chunk from PNG
-                            rpng_chunk chunk = rpng_chunk_read_from_memory(icnImageData, "rIPt");
-                            memcpy(entries[imageCounter].text, chunk.data, (chunk.length < MAX_IMAGE_TEXT_SIZE)? chunk.length : MAX_IMAGE_TEXT_SIZE - 1);
-                            RPNG_FREE(chunk.data);
+    exportOptions.textChunk = options.textChunk;
+    exportOptions.compression = ((options.compression >= ICON_COMPRESSION_FAST) && (options.compression <= ICON_COMPRESSION_OPTIMAL))? options.compression : ICON_COMPRESSION_DEFAULT;
+    exportOptions.threadCount = options.threadCount;
+    exportOptions.dibMaxSize = options.dibMaxSize;
+    exportOptions.paletteMaxSize = options.paletteMaxSize;
 
-                            imageCounter++;
-                        }
-                    }
-                    else LOG("WARNING: ICNS data format not supported\n");
+    return exportOptions;
+}
 
-                    // JPEG2000 data signatures (not supported)
-                    // Option 1: 0x00 0x00 0x00 0x0c 0x6a 0x50 0x20 0x20 0x0d 0x0a 0x87 0x0a
-                    // Option 2: 0xff 0x4f 0xff 0x51
+// Get output sizes from library options: custom sizes + platform scheme sizes (unique)
+// NOTE: Up to MAX_OUTPUT_SIZES sizes, returns sizes count
+static int GetRipOptionsSizes(RipOptions options, int *sizes)
+{
+    int count = 0;
+    int platformSizesCount = 0;
+    unsigned int *platformSizes = GetPlatformSizes(options.platform, &platformSizesCount);
 
-                    // Useful for the future: ARGB to RGBA
-                    /*
-                    // Source is in format: 0xAARRGGBB
-                    ((x & 0xFF000000) >> 24) | //______AA
-                    ((x & 0x00FF0000) >>  8) | //____RR__
-                    ((x & 0x0000FF00) <<  8) | //__GG____
-                    ((x & 0x000000FF) << 24);  //BB______
-                    // Return value is in format:  0xBBGGRRAA   -> ARGB?
-                    */
+    for (int i = 0; i < (options.sizesCount + platformSizesCount); i++)
+    {
+        int size = (i < options.sizesCount)? options.sizes[i] : (int)platformSizes[i - options.sizesCount];
+        if ((size <= 0) || (count >= MAX_OUTPUT_SIZES)) continue;
 
-                    RL_FREE(icnImageData);
-                }
-                else
-                {
-                    // In case OSType is not supported we just skip the required size
-                    fseek(icnsFile, icnSize, SEEK_CUR);
-                }
+        int k = 0;
+        while ((k < count) && (sizes[k] != size)) k++;
+        if (k == count) { sizes[count] = size; count++; }
+    }
 
-                processedSize += icnSize;
-            }
+    return count;
+}
 
-            LOG("INFO: Total images extracted from ICNS file: %i\n", imageCounter);
-        }
+// Get icon entry from library image, image data is not copied
+static IconEntry GetRipImageEntry(RipImage image)
+{
+    IconEntry entry = { 0 };
 
-        fclose(icnsFile);
-    }
+    entry.image = (Image){ .data = image.data, .width = image.size, .height = image.size, .mipmaps = 1, .format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 };
+    entry.size = image.size;
+    entry.valid = (image.data != NULL) && (image.size > 0);
+    memcpy(entry.text, image.text, MAX_IMAGE_TEXT_SIZE - 1);
 
-    *count = imageCounter;
-    return entries;
+    return entry;
 }
 
-// Save icns file (Apple)
-// LIMITATIONS:
-//  - Supported OS Version: >=10.7
-//  - Supported PNG compressed images only
-//  - Supported OSTypes [8]: ic11, SB24, ic12, ic07, ic13, ic14, ic10
-//  - Supported image sizes [8]: 32, 48, 64, 128, 256, 512, 1024
-//  - No TOC or additional chunks supported
-//  - Main focus on .app package icns generation
-// REF: https://en.wikipedia.org/wiki/Apple_Icon_Image_format
-static void SaveIconPackToICNS(IconEntry *entries, int entryCount, const char *fileName)
+// Get library image from icon entry image, image data is copied (RGBA) with provided allocator
+// NOTE: Entry image is decoded and converted to RGBA if required, entry keeps ownership of its image
+static bool GetIconEntryRipImage(IconEntry *entry, RipAllocator allocator, RipImage *image)
 {
-    // Verify icon pack valid entries (not placeholder ones)
-    int packValidCount = 0;
-    for (int i = 0; i < entryCount; i++) if (entries[i].valid) packValidCount++;
-    if (packValidCount == 0) return;
-/*
-    // NOTE: This validation is not required because it is already done when
-    // adding icons from input files into icon package entries
+    LoadIconEntryImage(entry);
+    if (entry->image.data == NULL) return false;
 
-    #define ICNS_MAX_SUPPORTED_IMAGES   8
+    if (entry->image.format != PIXELFORMAT_UNCOMPRESSED_R8G8B8A8) ImageFormat(&entry->image, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
 
-    // Validate input entries image data to get only supported sizes
-    int validCount = 0;
-    int validIndex[ICNS_MAX_SUPPORTED_IMAGES] = { -1 };
-    for (int i = 0; (i < entryCount) && (validCount < ICNS_MAX_SUPPORTED_IMAGES); i++)
-    {
-        if ((entries[i].image.width == 16) && (entries[i].image.height == 16)) { validIndex[validCount] = i; validCount++; }
-        else if ((entries[i].image.width == 32) && (entries[i].image.height == 32)) { validIndex[validCount] = i; validCount++; }
-        else if ((entries[i].image.width == 48) && (entries[i].image.height == 48)) { validIndex[validCount] = i; validCount++; }
-        else if ((entries[i].image.width == 64) && (entries[i].image.height == 64)) { validIndex[validCount] = i; validCount++; }
-        else if ((entries[i].image.width == 128) && (entries[i].image.height == 128)) { validIndex[validCount] = i; validCount++; }
-        else if ((entries[i].image.width == 256) && (entries[i].image.height == 256)) { validIndex[validCount] = i; validCount++; }
-        else if ((entries[i].image.width == 512) && (entries[i].image.height == 512)) { validIndex[validCount] = i; validCount++; }
-        else if ((entries[i].image.width == 1024) && (entries[i].image.height == 1024)) { validIndex[validCount] = i; validCount++; }
-    }
-*/
-    // Compress provided images into PNG data
-    char **pngDataPtrs = (char **)RL_CALLOC(packValidCount, sizeof(char *));     // Pointers array to PNG image data
-    unsigned int *pngDataSizes = (unsigned int *)RL_CALLOC(packValidCount, sizeof(unsigned int));   // PNG data size
+    int dataSize = entry->image.width*entry->image.height*4;
 
-    // Get image png data (and pointers to each image)
-    // NOTE: In case of PNG export as ZIP, files are directly packed in the loop, one by one
-    for (int i = 0, k = 0; i < entryCount; i++)
-    {
-        if (entries[i].valid)
-        {
-            // Compress entries data into PNG file data streams
-            // Image data format could be RGB (3 bytes) instead of RGBA (4 bytes)
-            int colorChannels = 0;
-            if (entries[i].image.format == PIXELFORMAT_UNCOMPRESSED_R8G8B8) colorChannels = 3;
-            else if (entries[i].image.format == PIXELFORMAT_UNCOMPRESSED_R8G8B8A8) colorChannels = 4;
+    image->data = (unsigned char *)RipAllocData(allocator, dataSize);
+    if (image->data == NULL) return false;
 
-            // NOTE: Memory is allocated internally using RPNG_MALLOC(), must be freed with RPNG_FREE()
-            pngDataPtrs[k] = rpng_save_image_to_memory(entries[i].image.data, entries[i].image.width, entries[i].image.height, colorChannels, 8, &pngDataSizes[k]);
+    memcpy(image->data, entry->image.data, dataSize);
+    image->size = entry->image.width;
+    memset(image->text, 0, RIP_IMAGE_TEXT_SIZE);
+    memcpy(image->text, entry->text, MAX_IMAGE_TEXT_SIZE - 1);
 
-            k++;
-        }
-    }
+    return true;
+}
 
-    // We got the images converted to PNG in memory, now we can create the icns file
+// Export icon entries to icon file data (.ico, .icns), returned data allocated with provided allocator
+static unsigned char *ExportRipIconData(IconEntry *entries, int count, const char *fileType, RipOptions options, int *dataSize)
+{
+    char *fileData = NULL;
+    int fileDataSize = 0;
 
-    FILE *icnsFile = fopen(fileName, "wb");
+    if (CheckFileExtension(fileType, ".ico")) fileData = ExportIconPackToICOMemory(entries, count, GetRipExportOptions(options), &fileDataSize);
+    else if (CheckFileExtension(fileType, ".icns")) fileData = ExportIconPackToICNSMemory(entries, count, GetRipExportOptions(options), &fileDataSize);
 
-    if (icnsFile != NULL)
-    {
-        /*
-        // Data structures to know how data is organized inside the .icns file
+    unsigned char *data = NULL;
 
-        // Icns File Header (8 bytes)
-        typedef struct {
-        unsigned char id[4];        // Magic literal: "icns" (0x69, 0x63, 0x6e, 0x73)
-        unsigned int size;          // Length of file, in bytes, MSB first (Big Endian)
-        } IcnsHeader;
+    if (fileData != NULL)
+    {
+        data = (unsigned char *)RipAllocData(options.allocator, fileDataSize);
 
-        for (int i = 0; i < count; i++)
+        if (data != NULL)
         {
-        // Icon Entry info (8 bytes + data)
-        typedef struct {
-        unsigned char type[4];      // Icon type, defined by OSType (Big Endian)
-        unsigned int dataSize;      // Length of data, in bytes (including type and length), MSB first
-        unsigned char *data;        // Icon data
-        } IcnsEntry;
+            memcpy(data, fileData, fileDataSize);
+            *dataSize = fileDataSize;
         }
-        */
-
-        // Write icns header signature
-        // unsigned char icnsId[4] = { 0x69, 0x63, 0x6e, 0x73 };     // "icns"
-        fwrite("icns", 1, 4, icnsFile);
 
-        // ICNS file size, all file including header,
-        // We init it with expected chunck size but
-        // we need to accumulate every generated PNG size
-        unsigned int icnsFileSize = 8 + 8*packValidCount;
-        for (int i = 0; i < packValidCount; i++) icnsFileSize += pngDataSizes[i];
-        unsigned char sizeBE[4] = { 0 };
+        RL_FREE(fileData);
+    }
 
-        // Write icns total data size (Big Endian)
-        sizeBE[0] = (icnsFileSize >> 24) & 0xFF;
-        sizeBE[1] = (icnsFileSize >> 16) & 0xFF;
-        sizeBE[2] = (icnsFileSize >> 8) & 0xFF;
-        sizeBE[3] = icnsFileSize & 0xFF;
-        fwrite(sizeBE, 1, 4, icnsFile);
+    return data;
+}
 
-        unsigned char icnType[4] = { 0 };
+// Get default packing options (same defaults as command line)
+RipOptions RipGetDefaultOptions(void)
+{
+    RipOptions options = { 0 };
 
-        // Write icns entries
-        for (int i = 0, k = 0; i < entryCount; i++)
-        {
-            if (entries[i].valid)
-            {
-                switch (entries[i].image.width)
-                {
-                    case 16:   { icnType[0] = 'i'; icnType[1] = 'c'; icnType[2] = 'p'; icnType[3] = '4'; } break;   // icp4, not properly displayed on .app
-                    //case 32: { icnType[0] = 'i'; icnType[1] = 'c'; icnType[2] = 'p'; icnType[3] = '5'; } break;   // icp5, not properly displayed on .app
-                    case 32:   { icnType[0] = 'i'; icnType[1] = 'c'; icnType[2] = '1'; icnType[3] = '1'; } break;   // ic11 (16x16@2x "retina")
-                    //case 48: { icnType[0] = 'i'; icnType[1] = 'c'; icnType[2] = 'p'; icnType[3] = '6'; } break;   // icp6, not properly displayed on .app
-                    case 48:   { icnType[0] = 'S'; icnType[1] = 'B'; icnType[2] = '2'; icnType[3] = '4'; } break;   // SB24 (24x24@2x "retina")
-                    case 64:   { icnType[0] = 'i'; icnType[1] = 'c'; icnType[2] = '1'; icnType[3] = '2'; } break;   // ic12 (32x32@2x "retina")
-                    case 128:  { icnType[0] = 'i'; icnType[1] = 'c'; icnType[2] = '0'; icnType[3] = '7'; } break;   // ic07
-                   //case 256: { icnType[0] = 'i'; icnType[1] = 'c'; icnType[2] = '0'; icnType[3] = '8'; } break;   // ic08
-                    case 256:  { icnType[0] = 'i'; icnType[1] = 'c'; icnType[2] = '1'; icnType[3] = '3'; } break;   // ic13 (128x128@2x "retina")
-                   //case 512: { icnType[0] = 'i'; icnType[1] = 'c'; icnType[2] = '0'; icnType[3] = '9'; } break;   // ic09
-                    case 512:  { icnType[0] = 'i'; icnType[1] = 'c'; icnType[2] = '1'; icnType[3] = '4'; } break;   // ic14 (256x256@2x "retina")
-                    case 1024: { icnType[0] = 'i'; icnType[1] = 'c'; icnType[2] = '1'; icnType[3] = '0'; } break;   // ic10 (512x512@2x "retina")
-                    default: LOG("WARNING: Image size for ICNS generation not supported!\n"); break;
-                }
+    options.platform = RIP_PLATFORM_WINDOWS;
+    options.scaleAlgorythm = 2;         // Bicubic
+    options.compression = RIP_COMPRESSION_DEFAULT;
+    options.textChunk = true;
 
-                // Write entry type
-                fwrite(icnType, 1, 4, icnsFile);
+    return options;
+}
 
-                // Write entry size (Big endian)
-                unsigned int size = pngDataSizes[k] + 8;   // Size must include type and length size
-                sizeBE[0] = (size >> 24) & 0xFF;
-                sizeBE[1] = (size >> 16) & 0xFF;
-                sizeBE[2] = (size >> 8) & 0xFF;
-                sizeBE[3] = size & 0xFF;
-                fwrite(sizeBE, 1, 4, icnsFile);
+// Load icon/image file data into images (.ico, .icns, .png, .bmp, .qoi)
+// NOTE: Images are returned in file order, images and their data are allocated with provided allocator
+RipImage *RipLoadIconFromMemory(const unsigned char *fileData, int dataSize, const char *fileType, RipAllocator allocator, int *count)
+{
+    int entryCount = 0;
+    IconEntry *entries = LoadIconEntriesFromMemory(fileData, dataSize, fileType, &entryCount);
 
-                // Write entry PNG icon data
-                fwrite(pngDataPtrs[k], pngDataSizes[k], 1, icnsFile);
+    RipImage *images = (entryCount > 0)? (RipImage *)RipAllocData(allocator, entryCount*sizeof(RipImage)) : NULL;
+    int imageCount = 0;
 
-                k++;
-            }
-        }
+    for (int i = 0; i < entryCount; i++)
+    {
+        if ((images != NULL) && GetIconEntryRipImage(&entries[i], allocator, &images[imageCount])) imageCount++;
 
-        fclose(icnsFile);
+        UnloadImage(entries[i].image);
+        UnloadIconEntryCache(&entries[i]);
     }
 
-    // Free used data (pngs data)
-    for (int i = 0; i < packValidCount; i++) RPNG_FREE(pngDataPtrs[i]);
+    RL_FREE(entries);
 
-    RL_FREE(pngDataPtrs);
-    RL_FREE(pngDataSizes);
+    if (imageCount == 0)
+    {
+        RipFreeData(allocator, images);
+        images = NULL;
+    }
+
+    *count = imageCount;
+    return images;
 }
 
-// Get text lines available on icon pack
-// NOTE: Only valid icons considered
-static unsigned int CountIconPackTextLines(IconPack pack)
+// Unload images loaded/generated by library
+void RipUnloadImages(RipImage *images, int count, RipAllocator allocator)
 {
-    //static const char *textLines[MAX_PACK_ELEMENTS] = { 0 }; // Pointers array to possible text lines
-    unsigned int counter = 0;
-
-    for (int i = 0; i < pack.count; i++)
-    {
-        if (pack.entries[i].valid && (strlen(pack.entries[i].text) > 0))
-        {
-            //textLines[counter] = pack.entries[i].text;
-            counter++;
-        }
-    }
+    if (images == NULL) return;
 
-    return counter;
+    for (int i = 0; i < count; i++) RipFreeData(allocator, images[i].data);
+    RipFreeData(allocator, images);
 }
 
-// Add icon to bucket
-static void AddIconToBucket(IconBucket *bucket, const char *fileName)
+// Generate required sizes (options) from images: copied if size is available or generated from bigger image
+// NOTE: Images are returned in options sizes order, images and their data are allocated with options allocator
+RipImage *RipGenerateIconSizes(const RipImage *images, int count, RipOptions options, int *outCount)
 {
-    IconEntry *entries = NULL;
-    int imageCount = 0;
+    *outCount = 0;
 
-    // Load all available entries
-    if (IsFileExtension(fileName, ".ico")) entries = LoadIconPackFromICO(fileName, &imageCount);
-    if (IsFileExtension(fileName, ".icns")) entries = LoadIconPackFromICNS(fileName, &imageCount);
-    else if (IsFileExtension(fileName, ".png;.bmp;.qoi"))
-    {
-        Image image = LoadImage(fileName);
+    int sizes[MAX_OUTPUT_SIZES] = { 0 };
+    int sizesCount = GetRipOptionsSizes(options, sizes);
 
-        // Minimal image validation
-        if ((image.data != NULL) && (image.width <= 1024) && (image.width == image.height))
-        {
-            imageCount = 1;
-            entries = (IconEntry *)RL_CALLOC(imageCount, sizeof(IconEntry));
-            entries[0].image = image;
-            entries[0].size = image.width;
+    int biggerIndex = -1;
+    for (int i = 0; i < count; i++) if ((images[i].data != NULL) && ((biggerIndex < 0) || (images[i].size > images[biggerIndex].size))) biggerIndex = i;
 
-            // Try to find rIPt text lines
-            if (IsFileExtension(fileName, ".png"))
-            {
-                // Read custom rIconPacker text chunk from PNG
-                rpng_chunk chunk = rpng_chunk_read(fileName, "rIPt");
-                if (chunk.length > 0) memcpy(entries[0].text, chunk.data, (chunk.length < MAX_IMAGE_TEXT_SIZE)? chunk.length : MAX_IMAGE_TEXT_SIZE - 1);
-                RPNG_FREE(chunk.data);
-            }
-        }
-        else UnloadImage(image);
-    }
+    if ((sizesCount == 0) || (biggerIndex < 0)) return NULL;
 
-    int dupIndex = -1;
+    RipImage *outImages = (RipImage *)RipAllocData(options.allocator, sizesCount*sizeof(RipImage));
+    if (outImages == NULL) return NULL;
+    memset(outImages, 0, sizesCount*sizeof(RipImage));
 
-    // Add new entries to bucket
-    for (int i = 0; (i < imageCount) && (bucket->count < bucket->capacity); i++)
+    int genSizes[MAX_OUTPUT_SIZES] = { 0 };     // Sizes to generate (not available in images)
+    int genIndices[MAX_OUTPUT_SIZES] = { 0 };   // Output index for every size to generate
+    int genCount = 0;
+
+    for (int i = 0; i < sizesCount; i++)
     {
-        // Check if bucket already contains an image with same size
-        for (int k = 0; k < bucket->count; k++)
-        {
-            if (entries[i].size == bucket->entries[k].size)
-            {
-                // Found bucket entry with same size -> replace bucket entry!
-                dupIndex = k;
-                break;
-            }
-        }
+        int j = 0;
+        while ((j < count) && ((images[j].data == NULL) || (images[j].size != sizes[i]))) j++;
 
-        if (dupIndex > -1)
+        if (j < count)
         {
-            // Unload current entry
-            UnloadImage(bucket->entries[dupIndex].image);
-            memset(bucket->entries[dupIndex].text, 0, MAX_IMAGE_TEXT_SIZE);
-
-            // Update with new entry
-            bucket->entries[dupIndex] = entries[i];
-            if (entries[i].text[0] != '\0') memcpy(bucket->entries[dupIndex].text, entries[i].text, MAX_IMAGE_TEXT_SIZE);
-            dupIndex = -1;
+            IconEntry entry = GetRipImageEntry(images[j]);
+            GetIconEntryRipImage(&entry, options.allocator, &outImages[i]);
         }
         else
         {
-            bucket->entries[bucket->count] = entries[i];
-            if (entries[i].text[0] != '\0') memcpy(bucket->entries[bucket->count].text, entries[i].text, MAX_IMAGE_TEXT_SIZE);
-            bucket->count++;
+            genSizes[genCount] = sizes[i];
+            genIndices[genCount] = i;
+            genCount++;
         }
     }
 
-    RL_FREE(entries);
+    // Generate all missing sizes at once from bigger image
+    if (genCount > 0)
+    {
+        Image genImages[MAX_OUTPUT_SIZES] = { 0 };
+        int threadCount = (options.threadCount > 0)? options.threadCount : GetProcessorCount();
+
+        GenerateIconSizes(GetRipImageEntry(images[biggerIndex]).image, genSizes, genCount, options.scaleAlgorythm, threadCount, genImages);
+
+        for (int i = 0; i < genCount; i++)
+        {
+            IconEntry entry = { .image = genImages[i], .size = genSizes[i] };
+            GetIconEntryRipImage(&entry, options.allocator, &outImages[genIndices[i]]);
+            UnloadImage(entry.image);
+        }
+    }
+
+    // NOTE: Images that could not be copied or generated are not returned
+    int validCount = 0;
+    for (int i = 0; i < sizesCount; i++) if (outImages[i].data != NULL) { outImages[validCount] = outImages[i]; validCount++; }
+
+    *outCount = validCount;
+    return outImages;
 }
 
-// Remove icon from bucket
-static void RemoveIconFromBucket(IconBucket *bucket, unsigned int size)
+// Save images into icon file data (.ico, .icns)
+// NOTE: Images are saved in provided order, returned data is allocated with options allocator
+unsigned char *RipSaveIconToMemory(const RipImage *images, int count, const char *fileType, RipOptions options, int *dataSize)
 {
-    // TODO: Remove bucket icon... really required?
+    *dataSize = 0;
+    if ((images == NULL) || (count <= 0) || (fileType == NULL)) return NULL;
+
+    IconEntry *entries = (IconEntry *)RL_CALLOC(count, sizeof(IconEntry));
+    for (int i = 0; i < count; i++) entries[i] = GetRipImageEntry(images[i]);
+
+    unsigned char *data = ExportRipIconData(entries, count, fileType, options, dataSize);
+
+    // NOTE: Entries images are owned by user, only encoded data is unloaded
+    for (int i = 0; i < count; i++) UnloadIconEntryCache(&entries[i]);
+    RL_FREE(entries);
+
+    return data;
 }
 
-// Clear icon bucket
-static void ClearIconBucket(IconBucket *bucket)
+// Pack icon/image files data into icon file data (.ico, .icns)
+// NOTE: Input files entries are added in order, same size entries are replaced by later ones,
+// required sizes (options) are copied from input entries if available or generated from bigger one,
+// input PNG entries data is written as is if no re-encoding is required, as command line packing
+unsigned char *RipPackIconFromMemory(const RipFileData *files, int filesCount, const char *fileType, RipOptions options, int *dataSize)
 {
-    for (int i = 0; i < bucket->count; i++)
+    *dataSize = 0;
+    if ((files == NULL) || (filesCount <= 0) || (fileType == NULL)) return NULL;
+
+    IconBucket packBucket = { 0 };      // NOTE: Entries allocated on first entries addition
+
+    for (int i = 0; i < filesCount; i++)
     {
-        UnloadImage(bucket->entries[i].image);
-        bucket->entries[i] = (IconEntry){ 0 };
+        int entryCount = 0;
+        IconEntry *entries = LoadIconEntriesFromMemory(files[i].data, files[i].dataSize, files[i].fileType, &entryCount);
+
+        AddIconEntriesToBucket(&packBucket, entries, entryCount);
+        RL_FREE(entries);
     }
 
-    bucket->count = 0;
-}
+    int sizes[MAX_OUTPUT_SIZES] = { 0 };
+    int sizesCount = GetRipOptionsSizes(options, sizes);
+    unsigned char *data = NULL;
 
-// NOTE: Platform determines the requested sizes
-static void UpdateIconPackFromBucket(IconPack *pack, IconBucket bucket)
-{
-    for (int i = 0; i < bucket.count; i++)
+    if ((packBucket.count > 0) && (sizesCount > 0))
     {
-        for (int k = 0; k < pack->count; k++)
+        IconEntry pool[MAX_OUTPUT_SIZES] = { 0 };
+        int genSizes[MAX_OUTPUT_SIZES] = { 0 };
+        int genIndices[MAX_OUTPUT_SIZES] = { 0 };
+        int genCount = 0;
+
+        // Copy from bucket (image, text and source PNG data) or generate if required
+        for (int i = 0; i < sizesCount; i++)
         {
-            if (bucket.entries[i].size == pack->entries[k].size)
+            int j = FindIconBucketEntry(packBucket, sizes[i], NULL);
+            pool[i].size = sizes[i];
+
+            if (j >= 0)
+            {
+                pool[i].image = packBucket.entries[j].image;
+                memcpy(pool[i].text, packBucket.entries[j].text, MAX_IMAGE_TEXT_SIZE);
+                CopyIconEntryCache(&pool[i], packBucket.entries[j]);
+                pool[i].valid = true;
+            }
+            else
             {
-                if (pack->entries[k].generated) UnloadImage(pack->entries[k].image);
+                genSizes[genCount] = sizes[i];
+                genIndices[genCount] = i;
+                genCount++;
+            }
+        }
 
-                pack->entries[k] = bucket.entries[i];
+        // Generate all missing sizes at once from bigger image (bucket is sorted by size, descending)
+        if ((genCount > 0) && LoadIconEntryImage(&packBucket.entries[0]))
+        {
+            Image genImages[MAX_OUTPUT_SIZES] = { 0 };
+            int threadCount = (options.threadCount > 0)? options.threadCount : GetProcessorCount();
 
-                UnloadTexture(pack->textures[k]);
-                pack->textures[k] = (Texture2D){ 0 };
-                pack->textures[k] = LoadTextureFromImage(pack->entries[k].image);
+            GenerateIconSizes(packBucket.entries[0].image, genSizes, genCount, options.scaleAlgorythm, threadCount, genImages);
 
-                pack->entries[k].valid = true;
-                pack->entries[k].generated = false;
+            for (int i = 0; i < genCount; i++)
+            {
+                pool[genIndices[i]].image = genImages[i];
+                pool[genIndices[i]].generated = true;
+                pool[genIndices[i]].valid = (genImages[i].data != NULL);
             }
         }
-    }
-}
-
-// Reset icon pack data
-static void ResetIconPack(IconPack *pack, int platform)
-{
-    // Clear full pack
-    for (int i = 0; i < MAX_PACK_ELEMENTS; i++)
-    {
-        if (pack->entries[i].generated) UnloadImage(pack->entries[i].image);
-        else pack->entries[i].image = (Image){ 0 };      // Remove bucket image (not unload)
 
-        UnloadTexture(pack->textures[i]);
-        pack->textures[i] = (Texture2D){ 0 };
+        data = ExportRipIconData(pool, sizesCount, fileType, options, dataSize);
 
-        memset(pack->entries[i].text, 0, MAX_IMAGE_TEXT_SIZE);
-        pack->entries[i].generated = false;
-        pack->entries[i].valid = false;
-        pack->entries[i].size = 0;
+        for (int i = 0; i < sizesCount; i++)
+        {
+            if (pool[i].generated) UnloadImage(pool[i].image);
+            UnloadIconEntryCache(&pool[i]);
+        }
     }
 
-    // Reset to required platform
-    unsigned int *platformSizes = NULL;
-    switch (platform)
-    {
-        case ICON_PLATFORM_WINDOWS: pack->count = 8; platformSizes = icoSizesWindows; break;
-        case ICON_PLATFORM_MACOS: pack->count = 8; platformSizes = icoSizesMacOS; break;
-        case ICON_PLATFORM_FAVICON: pack->count = 10; platformSizes = icoSizesFavicon; break;
-        case ICON_PLATFORM_ANDROID: pack->count = 10; platformSizes = icoSizesAndroid; break;
-        case ICON_PLATFORM_IOS7: pack->count = 9; platformSizes = icoSizesiOS; break;
-        default: break;
-    }
+    ClearIconBucket(&packBucket);
+    RL_FREE(packBucket.entries);
 
-    for (int i = 0; i < pack->count; i++) pack->entries[i].size = platformSizes[i];
-}
\ No newline at end of file
+    return data;
+}
+
+// Unload file data saved by library
+void RipUnloadData(unsigned char *data, RipAllocator allocator)
+{
+    RipFreeData(allocator, data);
+}
+#endif      // RICONPACKER_LIBRARY
@@ -0,0 +1,152 @@
+/*******************************************************************************************
+*
+*   librip - rIconPacker library: stateless icons packing and unpacking functions
+*
+*   NOTES:
+*       Library is built from riconpacker.c with RICONPACKER_LIBRARY defined (make librip),
+*       GUI and command line code are excluded and no tool global state is used: every function
+*       receives all its required data and options, so functions are re-entrant and multiple
+*       conversions can be processed at the same time from multiple threads
+*
+*       Only librip functions are exported, embedded modules (rpng, threads) have internal linkage,
+*       so library can be linked along other rpng/raygui/miniz copies without symbols collisions
+*
+*       Returned memory (images and file data) is allocated with the allocator provided on call,
+*       if no allocator functions are provided, standard library malloc()/free() are used
+*       Internal working memory is allocated with raylib RL_MALLOC()/RL_FREE() (configurable at compile time)
+*
+*       Library still requires raylib for image files decoding, window initialization is not required
+*
+*   USAGE:
+*       RipOptions options = RipGetDefaultOptions();
+*       options.platform = RIP_PLATFORM_WINDOWS;
+*
+*       RipFileData input = { pngData, pngDataSize, ".png" };
+*
+*       int icoDataSize = 0;
+*       unsigned char *icoData = RipPackIconFromMemory(&input, 1, ".ico", options, &icoDataSize);
+*       ...
+*       RipUnloadData(icoData, options.allocator);
+*
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2024 raylib technologies (@raylibtech) / Ramon Santamaria (@raysan5)
+*
+*   This software is provided "as-is", without any express or implied warranty. In no event
+*   will the authors be held liable for any damages arising from the use of this software.
+*
+*   Permission is granted to anyone to use this software for any purpose, including commercial
+*   applications, and to alter it and redistribute it freely, subject to the following restrictions:
+*
+*     1. The origin of this software must not be misrepresented; you must not claim that you
+*     wrote the original software. If you use this software in a product, an acknowledgment
+*     in the product documentation would be appreciated but is not required.
+*
+*     2. Altered source versions must be plainly marked as such, and must not be misrepresented
+*     as being the original software.
+*
+*     3. This notice may not be removed or altered from any source distribution.
+*
+**********************************************************************************************/
+
+#ifndef RIP_H
+#define RIP_H
+
+#include <stddef.h>         // Required for: size_t
+#include <stdbool.h>        // Required for: bool
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#ifndef RIPAPI
+    #define RIPAPI          // Functions defined as 'extern' by default (implicit specifiers)
+#endif
+
+#define RIP_IMAGE_TEXT_SIZE     48          // Image text size (including string terminator)
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+// Platform sizes scheme
+typedef enum {
+    RIP_PLATFORM_NONE = -1,                 // No platform sizes, only custom sizes
+    RIP_PLATFORM_WINDOWS = 0,               // Sizes: 256, 128, 96, 64, 48, 32, 24, 16
+    RIP_PLATFORM_MACOS,                     // Sizes: 1024, 512, 256, 128, 64, 48, 32, 16
+    RIP_PLATFORM_FAVICON,                   // Sizes: 228, 152, 144, 120, 96, 72, 64, 32, 24, 16
+    RIP_PLATFORM_ANDROID,                   // Sizes: 192, 144, 96, 72, 64, 48, 36, 32, 24, 16
+    RIP_PLATFORM_IOS,                       // Sizes: 180, 152, 120, 87, 80, 76, 58, 40, 29
+    RIP_PLATFORM_ALL,                       // All platforms sizes combined (32 sizes)
+} RipPlatform;
+
+// PNG compression effort level
+typedef enum {
+    RIP_COMPRESSION_FAST = 0,               // Fixed filter, low compression level
+    RIP_COMPRESSION_DEFAULT,                // Adaptive filter, high compression level
+    RIP_COMPRESSION_MAX,                    // Best of multiple filter strategies
+    RIP_COMPRESSION_OPTIMAL,                // All filter strategies, optimal parsing deflate (slowest)
+} RipCompression;
+
+// Memory allocator, used for all returned memory
+// NOTE: If alloc/free functions are not provided, malloc()/free() are used
+typedef struct {
+    void *(*alloc)(size_t size, void *userData);    // Allocate memory (not required to be zero-initialized)
+    void (*free)(void *ptr, void *userData);        // Free memory allocated with alloc()
+    void *userData;                                 // User data provided to allocator functions
+} RipAllocator;
+
+// Icon image, squared and 32bit RGBA
+typedef struct {
+    unsigned char *data;                    // Image data, size*size*4 bytes (RGBA, 8bit per channel)
+    int size;                               // Image size (width and height)
+    char text[RIP_IMAGE_TEXT_SIZE];         // Image text, embedded as PNG chunk (rIPt) if required
+} RipImage;
+
+// Input file data
+typedef struct {
+    const unsigned char *data;              // File data
+    int dataSize;                           // File data size
+    const char *fileType;                   // File type extension: .ico, .icns, .png, .bmp, .qoi
+} RipFileData;
+
+// Icons packing options
+// NOTE: Output sizes are custom sizes followed by platform scheme sizes (duplicates removed)
+typedef struct {
+    int platform;                           // Platform sizes scheme (RipPlatform)
+    const int *sizes;                       // Custom output sizes (can be NULL)
+    int sizesCount;                         // Custom output sizes count
+    int scaleAlgorythm;                     // Scaling algorythm on generation: 1-Nearest, 2-Bicubic, 3-Box, 4-Lanczos3
+    int compression;                        // PNG compression effort level (RipCompression)
+    int dibMaxSize;                         // Max size saved as DIB (uncompressed BMP) into .ico, bigger ones as PNG (0 - Always PNG)
+    int paletteMaxSize;                     // Max size saved as indexed PNG if quantization error is low (0 - Always truecolor)
+    bool textChunk;                         // Embed images text as PNG chunk (rIPt)
+    int threadCount;                        // Threads used for sizes generation and encoding (0 - Available processors count)
+    RipAllocator allocator;                 // Allocator for returned memory
+} RipOptions;
+
+#ifdef __cplusplus
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+RIPAPI RipOptions RipGetDefaultOptions(void);       // Get default packing options (same defaults as command line)
+
+// Icons unpacking: load icon/image file data into images
+RIPAPI RipImage *RipLoadIconFromMemory(const unsigned char *fileData, int dataSize, const char *fileType, RipAllocator allocator, int *count);
+RIPAPI void RipUnloadImages(RipImage *images, int count, RipAllocator allocator);  // Unload images loaded/generated by library
+
+// Icons sizes generation: required sizes are copied from images (if available) or generated from bigger image
+RIPAPI RipImage *RipGenerateIconSizes(const RipImage *images, int count, RipOptions options, int *outCount);
+
+// Icons packing: save images into icon file data (.ico, .icns), or pack icon/image files data directly
+RIPAPI unsigned char *RipSaveIconToMemory(const RipImage *images, int count, const char *fileType, RipOptions options, int *dataSize);
+RIPAPI unsigned char *RipPackIconFromMemory(const RipFileData *files, int filesCount, const char *fileType, RipOptions options, int *dataSize);
+RIPAPI void RipUnloadData(unsigned char *data, RipAllocator allocator);     // Unload file data saved by library
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // RIP_H
@@ -0,0 +1,672 @@
+/*******************************************************************************************
+*
+*   rIconPacker threads - Minimal portable threading helpers
+*
+*   NOTES:
+*       Small threads abstraction (threads, mutex, condition variables) over pthreads
+*       (Linux, macOS, Web) and Win32 API, no external dependencies required.
+*
+*       Win32 functions are declared manually to avoid including windows.h,
+*       it conflicts with raylib types/functions (Rectangle, CloseWindow, ShowCursor...)
+*
+*       Threading can be disabled with RIP_THREADS_DISABLED, provided functions fallback
+*       to serial execution, it is automatically disabled on PLATFORM_WEB if the
+*       module is not compiled with pthreads support (-pthread), with pthreads support
+*       threads are Web Workers, taken from Emscripten threads pool (PTHREAD_POOL_SIZE)
+*
+*       A high resolution monotonic timer is also provided, it does not require raylib
+*       initialization (GetTime() requires InitWindow()), so it can be used in command line mode,
+*       along with process peak memory usage query, both used for processing instrumentation
+*
+*       A minimal files change watcher is also provided (command line watch mode), changes are notified
+*       by inotify (Linux) and directory change notifications (Windows), other platforms fallback to
+*       files modification time polling. Changed files are always detected by modification time and size,
+*       system notifications are only used to wake up as soon as any watched directory is modified
+*
+*   MODULE USAGE:
+*       #define RIP_THREADS_IMPLEMENTATION
+*       #include "rip_threads.h"
+*
+*   Process a list of independent tasks on multiple threads:
+*
+*       RunParallelTasks(ProcessTask, tasksData, tasksCount, GetProcessorCount());
+*
+*   Tasks are picked by the worker threads from a shared index queue as soon as
+*   they get idle, so a slow task does not stall the other workers
+*
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2024 raylib technologies (@raylibtech) / Ramon Santamaria (@raysan5)
+*
+*   This software is provided "as-is", without any express or implied warranty. In no event
+*   will the authors be held liable for any damages arising from the use of this software.
+*
+*   Permission is granted to anyone to use this software for any purpose, including commercial
+*   applications, and to alter it and redistribute it freely, subject to the following restrictions:
+*
+*     1. The origin of this software must not be misrepresented; you must not claim that you
+*     wrote the original software. If you use this software in a product, an acknowledgment
+*     in the product documentation would be appreciated but is not required.
+*
+*     2. Altered source versions must be plainly marked as such, and must not be misrepresented
+*     as being the original software.
+*
+*     3. This notice may not be removed or altered from any source distribution.
+*
+**********************************************************************************************/
+
+#ifndef RIP_THREADS_H
+#define RIP_THREADS_H
+
+#include <stdbool.h>
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#if defined(PLATFORM_WEB) && !defined(__EMSCRIPTEN_PTHREADS__)
+    #define RIP_THREADS_DISABLED            // Web build without pthreads support
+#endif
+
+// Function specifiers definition
+// NOTE: Module can be embedded with internal linkage (i.e. #define RIPTAPI static)
+#ifndef RIPTAPI
+    #define RIPTAPI       // Functions defined as 'extern' by default (implicit specifiers)
+#endif
+
+#define MAX_WORKER_THREADS      64          // Maximum number of threads used by RunParallelTasks()
+
+#define WATCH_POLLING_TIME      20          // Files watcher polling time in milliseconds (no system notifications available)
+#define WATCH_SETTLE_TIME       10          // Files watcher wait time in milliseconds after notification, to group consecutive writes
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+#if defined(RIP_THREADS_DISABLED)
+    typedef struct { int unused; } WorkerThread;
+    typedef struct { int unused; } ThreadMutex;
+    typedef struct { int unused; } ThreadCondition;
+#elif defined(_WIN32)
+    typedef struct { void *handle; } WorkerThread;      // HANDLE
+    typedef struct { void *ptr; } ThreadMutex;          // SRWLOCK
+    typedef struct { void *ptr; } ThreadCondition;      // CONDITION_VARIABLE
+#else
+    #include <pthread.h>
+
+    typedef struct { pthread_t handle; } WorkerThread;
+    typedef struct { pthread_mutex_t handle; } ThreadMutex;
+    typedef struct { pthread_cond_t handle; } ThreadCondition;
+#endif
+
+// Files change watcher
+// NOTE: Watched file names are not copied, they must be kept available while watching
+typedef struct {
+    const char **fileNames;     // Watched file names
+    int count;                  // Watched files count
+    long long *modTimes;        // Watched files last modification time (nanoseconds, if available)
+    long long *fileSizes;       // Watched files last size (bytes)
+    int notifyHandle;           // Linux: inotify instance (-1 if not available)
+    void **notifyHandles;       // Windows: change notification handles, one per watched file directory
+} FilesWatcher;
+
+// Thread entry point function
+typedef void (*ThreadFunc)(void *userData);
+
+// Parallel task function, called once per task index
+typedef void (*ParallelTaskFunc)(void *userData, int index);
+
+#ifdef __cplusplus
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+RIPTAPI int GetProcessorCount(void);                                        // Get number of logical processors available
+
+RIPTAPI bool StartWorkerThread(WorkerThread *thread, ThreadFunc func, void *userData);  // Start a new thread, returns false on failure
+RIPTAPI void JoinWorkerThread(WorkerThread *thread);                        // Wait for thread to finish and release it
+
+RIPTAPI void InitThreadMutex(ThreadMutex *mutex);                           // Init mutex
+RIPTAPI void UnloadThreadMutex(ThreadMutex *mutex);                         // Unload mutex
+RIPTAPI void LockThreadMutex(ThreadMutex *mutex);                           // Lock mutex
+RIPTAPI void UnlockThreadMutex(ThreadMutex *mutex);                         // Unlock mutex
+
+RIPTAPI void InitThreadCondition(ThreadCondition *cond);                    // Init condition variable
+RIPTAPI void UnloadThreadCondition(ThreadCondition *cond);                  // Unload condition variable
+RIPTAPI void WaitThreadCondition(ThreadCondition *cond, ThreadMutex *mutex);    // Wait for condition (mutex must be locked)
+RIPTAPI void SignalThreadCondition(ThreadCondition *cond);                  // Wake one thread waiting on condition
+RIPTAPI void BroadcastThreadCondition(ThreadCondition *cond);               // Wake all threads waiting on condition
+
+// Run tasks [0..count-1] on up to threadCount threads (calling thread included), blocks until all done
+RIPTAPI void RunParallelTasks(ParallelTaskFunc func, void *userData, int count, int threadCount);
+
+RIPTAPI double GetPerformanceTime(void);                                    // Get high resolution monotonic time in seconds
+RIPTAPI long long GetPeakMemoryUsage(void);                                 // Get process peak memory usage in bytes (resident memory), 0 if not available
+
+RIPTAPI bool InitFilesWatcher(FilesWatcher *watcher, const char **fileNames, int count);    // Init files watcher, current files state is the initial state
+RIPTAPI void UnloadFilesWatcher(FilesWatcher *watcher);                     // Unload files watcher
+RIPTAPI int WaitFilesWatcherChanges(FilesWatcher *watcher, bool *changed, int timeoutMs);  // Wait for watched files changes (up to timeoutMs), returns changed files count
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // RIP_THREADS_H
+
+/***********************************************************************************
+*
+*   RIP_THREADS IMPLEMENTATION
+*
+************************************************************************************/
+
+#if defined(RIP_THREADS_IMPLEMENTATION)
+
+#include <stdlib.h>         // Required for: malloc(), free()
+
+#if !defined(RIP_THREADS_DISABLED)
+#if defined(_WIN32)
+    // Win32 API required functions
+    // NOTE: Declared manually to avoid including windows.h
+    #define RIP_INFINITE                0xffffffff
+    #define RIP_ALL_PROCESSOR_GROUPS    0xffff
+
+    void *__stdcall CreateThread(void *threadAttributes, size_t stackSize, unsigned long (__stdcall *startAddress)(void *), void *parameter, unsigned long creationFlags, unsigned long *threadId);
+    unsigned long __stdcall WaitForSingleObject(void *handle, unsigned long milliseconds);
+    int __stdcall CloseHandle(void *handle);
+    unsigned long __stdcall GetActiveProcessorCount(unsigned short groupNumber);
+
+    void __stdcall InitializeSRWLock(void *lock);
+    void __stdcall AcquireSRWLockExclusive(void *lock);
+    void __stdcall ReleaseSRWLockExclusive(void *lock);
+
+    void __stdcall InitializeConditionVariable(void *cond);
+    int __stdcall SleepConditionVariableSRW(void *cond, void *lock, unsigned long milliseconds, unsigned long flags);
+    void __stdcall WakeConditionVariable(void *cond);
+    void __stdcall WakeAllConditionVariable(void *cond);
+#else
+    #include <unistd.h>     // Required for: sysconf()
+#endif
+#if defined(__EMSCRIPTEN_PTHREADS__)
+    #include <emscripten/threading.h>   // Required for: emscripten_num_logical_cores()
+#endif
+#endif
+
+#if defined(_WIN32)
+    // Win32 API required timer and memory info functions, LARGE_INTEGER is a 64bit integer
+    typedef struct {
+        unsigned long cb;
+        unsigned long PageFaultCount;
+        size_t PeakWorkingSetSize;
+        size_t WorkingSetSize;
+        size_t QuotaPeakPagedPoolUsage;
+        size_t QuotaPagedPoolUsage;
+        size_t QuotaPeakNonPagedPoolUsage;
+        size_t QuotaNonPagedPoolUsage;
+        size_t PagefileUsage;
+        size_t PeakPagefileUsage;
+    } RipProcessMemoryCounters;     // PROCESS_MEMORY_COUNTERS
+
+    int __stdcall QueryPerformanceCounter(long long *count);
+    int __stdcall QueryPerformanceFrequency(long long *frequency);
+    void *__stdcall GetCurrentProcess(void);
+    int __stdcall K32GetProcessMemoryInfo(void *process, RipProcessMemoryCounters *counters, unsigned long size);
+
+    // Win32 API required files change notification functions
+    #define RIP_INVALID_HANDLE_VALUE    ((void *)(long long)-1)
+    #define RIP_FILE_NOTIFY_CHANGE      0x00000011      // FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_LAST_WRITE
+    #define RIP_MAX_WAIT_OBJECTS        64              // MAXIMUM_WAIT_OBJECTS
+
+    void *__stdcall FindFirstChangeNotificationA(const char *pathName, int watchSubtree, unsigned long notifyFilter);
+    int __stdcall FindNextChangeNotification(void *handle);
+    int __stdcall FindCloseChangeNotification(void *handle);
+    unsigned long __stdcall WaitForMultipleObjects(unsigned long count, void *const *handles, int waitAll, unsigned long milliseconds);
+    void __stdcall Sleep(unsigned long milliseconds);
+#else
+    #include <time.h>       // Required for: clock_gettime(), nanosleep()
+    #include <sys/resource.h>   // Required for: getrusage()
+#endif
+
+#if defined(__linux__)
+    #include <sys/inotify.h>    // Required for: inotify_init1(), inotify_add_watch()
+    #include <poll.h>           // Required for: poll()
+    #include <unistd.h>         // Required for: read(), close()
+#endif
+
+#include <sys/stat.h>       // Required for: stat()
+#include <string.h>         // Required for: strncpy(), strrchr()
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+// Thread start data, required to adapt ThreadFunc to platform entry point signature
+typedef struct {
+    ThreadFunc func;
+    void *userData;
+} ThreadStartData;
+
+// Parallel tasks shared state
+typedef struct {
+    ParallelTaskFunc func;
+    void *userData;
+    int count;
+    int nextIndex;              // Next task index to be picked by any worker
+    ThreadMutex mutex;
+} ParallelTasksQueue;
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Declaration
+//----------------------------------------------------------------------------------
+static void ProcessParallelTasks(void *userData);   // Worker loop, picks tasks until queue is empty
+static void GetFileState(const char *fileName, long long *modTime, long long *fileSize);   // Get file modification time and size, 0 if not available
+static void WaitFilesNotification(FilesWatcher *watcher, int timeoutMs);    // Wait for any watched directory notification (or polling time)
+static void SleepTime(int milliseconds);            // Sleep calling thread
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+#if defined(RIP_THREADS_DISABLED)
+
+int GetProcessorCount(void) { return 1; }
+bool StartWorkerThread(WorkerThread *thread, ThreadFunc func, void *userData) { (void)thread; (void)func; (void)userData; return false; }
+void JoinWorkerThread(WorkerThread *thread) { (void)thread; }
+void InitThreadMutex(ThreadMutex *mutex) { (void)mutex; }
+void UnloadThreadMutex(ThreadMutex *mutex) { (void)mutex; }
+void LockThreadMutex(ThreadMutex *mutex) { (void)mutex; }
+void UnlockThreadMutex(ThreadMutex *mutex) { (void)mutex; }
+void InitThreadCondition(ThreadCondition *cond) { (void)cond; }
+void UnloadThreadCondition(ThreadCondition *cond) { (void)cond; }
+void WaitThreadCondition(ThreadCondition *cond, ThreadMutex *mutex) { (void)cond; (void)mutex; }
+void SignalThreadCondition(ThreadCondition *cond) { (void)cond; }
+void BroadcastThreadCondition(ThreadCondition *cond) { (void)cond; }
+
+#elif defined(_WIN32)
+
+static unsigned long __stdcall ThreadEntryPoint(void *param)
+{
+    ThreadStartData data = *(ThreadStartData *)param;
+    free(param);
+
+    data.func(data.userData);
+
+    return 0;
+}
+
+int GetProcessorCount(void)
+{
+    int count = (int)GetActiveProcessorCount(RIP_ALL_PROCESSOR_GROUPS);
+    return (count > 0)? count : 1;
+}
+
+bool StartWorkerThread(WorkerThread *thread, ThreadFunc func, void *userData)
+{
+    ThreadStartData *data = (ThreadStartData *)malloc(sizeof(ThreadStartData));
+    if (data == NULL) return false;
+
+    data->func = func;
+    data->userData = userData;
+
+    thread->handle = CreateThread(NULL, 0, ThreadEntryPoint, data, 0, NULL);
+    if (thread->handle == NULL) { free(data); return false; }
+
+    return true;
+}
+
+void JoinWorkerThread(WorkerThread *thread)
+{
+    WaitForSingleObject(thread->handle, RIP_INFINITE);
+    CloseHandle(thread->handle);
+    thread->handle = NULL;
+}
+
+// NOTE: SRWLOCK and CONDITION_VARIABLE are pointer-sized structures, no unload required
+void InitThreadMutex(ThreadMutex *mutex) { InitializeSRWLock(&mutex->ptr); }
+void UnloadThreadMutex(ThreadMutex *mutex) { (void)mutex; }
+void LockThreadMutex(ThreadMutex *mutex) { AcquireSRWLockExclusive(&mutex->ptr); }
+void UnlockThreadMutex(ThreadMutex *mutex) { ReleaseSRWLockExclusive(&mutex->ptr); }
+
+void InitThreadCondition(ThreadCondition *cond) { InitializeConditionVariable(&cond->ptr); }
+void UnloadThreadCondition(ThreadCondition *cond) { (void)cond; }
+void WaitThreadCondition(ThreadCondition *cond, ThreadMutex *mutex) { SleepConditionVariableSRW(&cond->ptr, &mutex->ptr, RIP_INFINITE, 0); }
+void SignalThreadCondition(ThreadCondition *cond) { WakeConditionVariable(&cond->ptr); }
+void BroadcastThreadCondition(ThreadCondition *cond) { WakeAllConditionVariable(&cond->ptr); }
+
+#else   // pthreads
+
+static void *ThreadEntryPoint(void *param)
+{
+    ThreadStartData data = *(ThreadStartData *)param;
+    free(param);
+
+    data.func(data.userData);
+
+    return NULL;
+}
+
+int GetProcessorCount(void)
+{
+#if defined(__EMSCRIPTEN_PTHREADS__)
+    int count = emscripten_num_logical_cores();     // NOTE: Browser navigator.hardwareConcurrency
+#else
+    int count = (int)sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+    return (count > 0)? count : 1;
+}
+
+bool StartWorkerThread(WorkerThread *thread, ThreadFunc func, void *userData)
+{
+    ThreadStartData *data = (ThreadStartData *)malloc(sizeof(ThreadStartData));
+    if (data == NULL) return false;
+
+    data->func = func;
+    data->userData = userData;
+
+    if (pthread_create(&thread->handle, NULL, ThreadEntryPoint, data) != 0) { free(data); return false; }
+
+    return true;
+}
+
+void JoinWorkerThread(WorkerThread *thread) { pthread_join(thread->handle, NULL); }
+
+void InitThreadMutex(ThreadMutex *mutex) { pthread_mutex_init(&mutex->handle, NULL); }
+void UnloadThreadMutex(ThreadMutex *mutex) { pthread_mutex_destroy(&mutex->handle); }
+void LockThreadMutex(ThreadMutex *mutex) { pthread_mutex_lock(&mutex->handle); }
+void UnlockThreadMutex(ThreadMutex *mutex) { pthread_mutex_unlock(&mutex->handle); }
+
+void InitThreadCondition(ThreadCondition *cond) { pthread_cond_init(&cond->handle, NULL); }
+void UnloadThreadCondition(ThreadCondition *cond) { pthread_cond_destroy(&cond->handle); }
+void WaitThreadCondition(ThreadCondition *cond, ThreadMutex *mutex) { pthread_cond_wait(&cond->handle, &mutex->handle); }
+void SignalThreadCondition(ThreadCondition *cond) { pthread_cond_signal(&cond->handle); }
+void BroadcastThreadCondition(ThreadCondition *cond) { pthread_cond_broadcast(&cond->handle); }
+
+#endif
+
+// Run tasks [0..count-1] on up to threadCount threads (calling thread included), blocks until all done
+// NOTE: If threads can not be created, remaining tasks are just processed by the calling thread
+void RunParallelTasks(ParallelTaskFunc func, void *userData, int count, int threadCount)
+{
+    if (count <= 0) return;
+
+    if (threadCount > count) threadCount = count;
+    if (threadCount > MAX_WORKER_THREADS) threadCount = MAX_WORKER_THREADS;
+
+    if (threadCount <= 1)
+    {
+        for (int i = 0; i < count; i++) func(userData, i);
+        return;
+    }
+
+    ParallelTasksQueue queue = { 0 };
+    queue.func = func;
+    queue.userData = userData;
+    queue.count = count;
+    InitThreadMutex(&queue.mutex);
+
+    WorkerThread threads[MAX_WORKER_THREADS] = { 0 };
+    int threadsStarted = 0;
+
+    for (int i = 0; i < (threadCount - 1); i++)
+    {
+        if (StartWorkerThread(&threads[threadsStarted], ProcessParallelTasks, &queue)) threadsStarted++;
+        else break;
+    }
+
+    ProcessParallelTasks(&queue);
+
+    for (int i = 0; i < threadsStarted; i++) JoinWorkerThread(&threads[i]);
+
+    UnloadThreadMutex(&queue.mutex);
+}
+
+// Get high resolution monotonic time in seconds
+// NOTE: Only useful to measure elapsed time, time origin is platform dependant
+double GetPerformanceTime(void)
+{
+#if defined(_WIN32)
+    long long counter = 0;
+    long long frequency = 1;
+
+    QueryPerformanceCounter(&counter);
+    QueryPerformanceFrequency(&frequency);
+
+    return (double)counter/(double)frequency;
+#else
+    struct timespec now = { 0 };
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (double)now.tv_sec + (double)now.tv_nsec*1e-9;
+#endif
+}
+
+// Get process peak memory usage in bytes (resident memory), 0 if not available
+long long GetPeakMemoryUsage(void)
+{
+#if defined(_WIN32)
+    RipProcessMemoryCounters counters = { 0 };
+    counters.cb = sizeof(RipProcessMemoryCounters);
+
+    if (K32GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(RipProcessMemoryCounters))) return (long long)counters.PeakWorkingSetSize;
+    return 0;
+#else
+    struct rusage usage = { 0 };
+
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#if defined(__APPLE__)
+    return (long long)usage.ru_maxrss;          // NOTE: Bytes on macOS
+#else
+    return (long long)usage.ru_maxrss*1024;     // NOTE: Kilobytes on Linux/BSD
+#endif
+#endif
+}
+
+// Init files watcher, current files state is the initial state
+// NOTE: Files directories are watched (not files), editors usually save files by replacing them,
+// if system notifications are not available, files watcher fallbacks to polling
+bool InitFilesWatcher(FilesWatcher *watcher, const char **fileNames, int count)
+{
+    if ((fileNames == NULL) || (count <= 0)) return false;
+
+    watcher->fileNames = fileNames;
+    watcher->count = count;
+    watcher->modTimes = (long long *)calloc(count, sizeof(long long));
+    watcher->fileSizes = (long long *)calloc(count, sizeof(long long));
+    watcher->notifyHandle = -1;
+    watcher->notifyHandles = NULL;
+
+    for (int i = 0; i < count; i++) GetFileState(fileNames[i], &watcher->modTimes[i], &watcher->fileSizes[i]);
+
+    for (int i = 0; i < count; i++)
+    {
+        // Get file directory path
+        char dirPath[512] = { 0 };
+        strncpy(dirPath, fileNames[i], 511);
+
+        char *separator = strrchr(dirPath, '/');
+        char *backSeparator = strrchr(dirPath, '\\');
+        if ((backSeparator != NULL) && ((separator == NULL) || (backSeparator > separator))) separator = backSeparator;
+
+        if (separator != NULL) separator[(separator == dirPath)? 1 : 0] = '\0';
+        else strcpy(dirPath, ".");
+
+#if defined(__linux__)
+        // NOTE: Same directory is only watched once by the inotify instance
+        if (i == 0) watcher->notifyHandle = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (watcher->notifyHandle >= 0) inotify_add_watch(watcher->notifyHandle, dirPath, IN_CLOSE_WRITE | IN_MOVED_TO);
+#elif defined(_WIN32)
+        // NOTE: Too many files to wait for their notifications, fallback to polling
+        if (count <= RIP_MAX_WAIT_OBJECTS)
+        {
+            if (i == 0) watcher->notifyHandles = (void **)calloc(count, sizeof(void *));
+
+            watcher->notifyHandles[i] = FindFirstChangeNotificationA(dirPath, 0, RIP_FILE_NOTIFY_CHANGE);
+            if (watcher->notifyHandles[i] == RIP_INVALID_HANDLE_VALUE) watcher->notifyHandles[i] = NULL;
+        }
+#endif
+    }
+
+    return true;
+}
+
+// Unload files watcher
+void UnloadFilesWatcher(FilesWatcher *watcher)
+{
+#if defined(__linux__)
+    if (watcher->notifyHandle >= 0) close(watcher->notifyHandle);
+#elif defined(_WIN32)
+    if (watcher->notifyHandles != NULL)
+    {
+        for (int i = 0; i < watcher->count; i++) if (watcher->notifyHandles[i] != NULL) FindCloseChangeNotification(watcher->notifyHandles[i]);
+    }
+#endif
+    free(watcher->notifyHandles);
+    free(watcher->modTimes);
+    free(watcher->fileSizes);
+
+    watcher->notifyHandle = -1;
+    watcher->notifyHandles = NULL;
+    watcher->modTimes = NULL;
+    watcher->fileSizes = NULL;
+    watcher->count = 0;
+}
+
+// Wait for watched files changes (up to timeoutMs), returns changed files count
+// NOTE: Changed files are flagged on changed array (watched files count), a file is considered changed
+// if its modification time or size differ from last check, files not available (i.e. being replaced) are skipped
+int WaitFilesWatcherChanges(FilesWatcher *watcher, bool *changed, int timeoutMs)
+{
+    int changedCount = 0;
+    double startTime = GetPerformanceTime();
+
+    for (int i = 0; i < watcher->count; i++) changed[i] = false;
+
+    while (changedCount == 0)
+    {
+        int waitTime = timeoutMs - (int)((GetPerformanceTime() - startTime)*1000.0);
+        if (waitTime <= 0) break;
+
+        WaitFilesNotification(watcher, waitTime);
+
+        for (int i = 0; i < watcher->count; i++)
+        {
+            long long modTime = 0;
+            long long fileSize = 0;
+            GetFileState(watcher->fileNames[i], &modTime, &fileSize);
+
+            if ((modTime != 0) && ((modTime != watcher->modTimes[i]) || (fileSize != watcher->fileSizes[i])))
+            {
+                watcher->modTimes[i] = modTime;
+                watcher->fileSizes[i] = fileSize;
+                changed[i] = true;
+                changedCount++;
+            }
+        }
+    }
+
+    return changedCount;
+}
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Definition
+//----------------------------------------------------------------------------------
+// Worker loop, picks tasks until queue is empty
+static void ProcessParallelTasks(void *userData)
+{
+    ParallelTasksQueue *queue = (ParallelTasksQueue *)userData;
+
+    while (true)
+    {
+        LockThreadMutex(&queue->mutex);
+        int index = queue->nextIndex;
+        if (index < queue->count) queue->nextIndex++;
+        UnlockThreadMutex(&queue->mutex);
+
+        if (index >= queue->count) break;
+
+        queue->func(queue->userData, index);
+    }
+}
+
+// Get file modification time and size, 0 if not available
+// NOTE: Modification time resolution is platform dependant, nanoseconds on Linux and macOS
+static void GetFileState(const char *fileName, long long *modTime, long long *fileSize)
+{
+    struct stat info = { 0 };
+
+    *modTime = 0;
+    *fileSize = 0;
+
+    if (stat(fileName, &info) == 0)
+    {
+#if defined(__linux__)
+        *modTime = (long long)info.st_mtim.tv_sec*1000000000LL + info.st_mtim.tv_nsec;
+#elif defined(__APPLE__)
+        *modTime = (long long)info.st_mtimespec.tv_sec*1000000000LL + info.st_mtimespec.tv_nsec;
+#else
+        *modTime = (long long)info.st_mtime*1000000000LL;
+#endif
+        *fileSize = (long long)info.st_size;
+    }
+}
+
+// Wait for any watched directory notification (or polling time)
+// NOTE: After one notification, notifications received in a short time are grouped
+static void WaitFilesNotification(FilesWatcher *watcher, int timeoutMs)
+{
+#if defined(__linux__)
+    if (watcher->notifyHandle >= 0)
+    {
+        struct pollfd pollHandle = { .fd = watcher->notifyHandle, .events = POLLIN };
+
+        if (poll(&pollHandle, 1, timeoutMs) > 0)
+        {
+            SleepTime(WATCH_SETTLE_TIME);
+
+            // Drain all pending events, events content is not required
+            char events[4096];
+            while (read(watcher->notifyHandle, events, sizeof(events)) > 0) { }
+        }
+
+        return;
+    }
+#elif defined(_WIN32)
+    if (watcher->notifyHandles != NULL)
+    {
+        // NOTE: Directories that could not be watched are not waited
+        void *handles[RIP_MAX_WAIT_OBJECTS] = { 0 };
+        int handlesCount = 0;
+
+        for (int i = 0; i < watcher->count; i++) if (watcher->notifyHandles[i] != NULL) { handles[handlesCount] = watcher->notifyHandles[i]; handlesCount++; }
+
+        if (handlesCount > 0)
+        {
+            unsigned long result = WaitForMultipleObjects(handlesCount, handles, 0, timeoutMs);
+
+            if (result < (unsigned long)handlesCount)
+            {
+                SleepTime(WATCH_SETTLE_TIME);
+
+                // Re-arm all notifications, signaled ones could be more than one
+                for (int i = 0; i < handlesCount; i++) FindNextChangeNotification(handles[i]);
+            }
+
+            return;
+        }
+    }
+#endif
+
+    // No system notifications available, files are polled
+    SleepTime((timeoutMs < WATCH_POLLING_TIME)? timeoutMs : WATCH_POLLING_TIME);
+}
+
+// Sleep calling thread
+static void SleepTime(int milliseconds)
+{
+#if defined(_WIN32)
+    Sleep(milliseconds);
+#else
+    struct timespec req = { .tv_sec = milliseconds/1000, .tv_nsec = (milliseconds%1000)*1000000L };
+    nanosleep(&req, NULL);
+#endif
+}
+
+#endif // RIP_THREADS_IMPLEMENTATION